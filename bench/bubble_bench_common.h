@@ -0,0 +1,64 @@
+#ifndef BUBBLE_BENCH_COMMON_H
+#define BUBBLE_BENCH_COMMON_H
+
+// Synthetic corrected sheets shared by the bubble benchmarks
+
+#include "BubbleSampler.h"
+#include "SheetStructureAnalyzer.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+struct SyntheticSheet {
+    cv::Mat image;
+    std::vector<QuestionRegion> regions;
+    std::vector<int> expected;      // -1 = boş
+};
+
+// Dense layout: 4 columns x 50 rows of 5-option questions = 1000 bubbles
+inline std::vector<QuestionRegion> createDenseRegions() {
+    std::vector<QuestionRegion> regions;
+    int question = 1;
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 50; row++) {
+            cv::Rect rect(25 + column * 205, 40 + row * 20, 200, 20);
+            regions.emplace_back(question++, rect, QuestionRegion::MULTIPLE_CHOICE, 5);
+        }
+    }
+    return regions;
+}
+
+inline SyntheticSheet createSheet(const std::vector<QuestionRegion>& regions, uint64_t seed) {
+    SyntheticSheet sheet;
+    sheet.image = cv::Mat(1100, 850, CV_8UC3, cv::Scalar(245, 245, 245));
+    sheet.regions = regions;
+
+    cv::RNG rng(seed);
+    std::vector<cv::Point> centers;
+
+    for (const auto& region : sheet.regions) {
+        int radius = 0;
+        BubbleSampler::computeBubbleGeometry(region.region, region.numOptions, centers, radius);
+
+        // ~1 in 6 questions left blank
+        int answer = rng.uniform(0, 6) == 0 ? -1 : rng.uniform(0, region.numOptions);
+        sheet.expected.push_back(answer);
+
+        for (int i = 0; i < static_cast<int>(centers.size()); i++) {
+            cv::circle(sheet.image, centers[i], radius, cv::Scalar(30, 30, 30), radius > 8 ? 2 : 1);
+            if (i == answer) {
+                cv::circle(sheet.image, centers[i], std::max(1, radius - 2), cv::Scalar(50, 50, 50), -1);
+            }
+        }
+    }
+
+    // Scanner noise
+    cv::Mat noise(sheet.image.size(), CV_16SC3);
+    rng.fill(noise, cv::RNG::NORMAL, 0, 8);
+    cv::add(sheet.image, noise, sheet.image, cv::noArray(), CV_8UC3);
+
+    return sheet;
+}
+
+#endif
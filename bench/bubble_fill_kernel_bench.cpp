@@ -0,0 +1,153 @@
+/**
+ * Balon Doluluk Çekirdeği Benchmark'ı
+ * Yoğun sentetik kağıtta (200 soru x 5 seçenek = 1000 balon) aynı bit maskelerini sayan
+ * iki çekirdeği karşılaştırır ve sonuçların birebir aynı olduğunu doğrular:
+ *   - SKALER: BubbleFillKernel::scoreBatchScalar (piksel piksel)
+ *   - SIMD:   BubbleFillKernel::scoreBatch (cv::v_uint8 universal intrinsics)
+ * Ayrıca kağıt başına uçtan uca BubbleSampler::sample süresini INTEGRAL_LOOKUP ve
+ * SIMD_MASK yolları için ölçer (gri dönüşüm + Otsu dahil).
+ *
+ * Kullanım: ./bubble_fill_kernel_bench [iterasyon] [seed]
+ */
+
+#include "BubbleFillKernel.h"
+#include "BubbleSampler.h"
+#include "bubble_bench_common.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+double timeSampler(BubbleSampler& sampler, const cv::Mat& image, int iterations, int& sink) {
+    sampler.sample(image);
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        sampler.sample(image);
+        sink += sampler.getMarkedAnswer(0);
+    }
+    return elapsedMs(start) / iterations;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? std::max(1, std::stoi(argv[1])) : 500;
+    uint64_t seed = (argc > 2) ? std::stoull(argv[2]) : 42;
+
+    cv::setNumThreads(1);
+
+    SyntheticSheet sheet = createSheet(createDenseRegions(), seed);
+
+    // Same masks and ratios BubbleScoringContext registers (0.8 / 1.2 / 1.5)
+    BubbleFillKernel kernel;
+    std::vector<cv::Point> centers;
+    std::vector<int> maskIds;
+    std::vector<cv::Point> regionCenters;
+    std::vector<int> radii;
+
+    for (const auto& region : sheet.regions) {
+        int radius = 0;
+        BubbleSampler::computeBubbleGeometry(region.region, region.numOptions, regionCenters, radius);
+
+        auto found = std::find(radii.begin(), radii.end(), radius);
+        int maskId = static_cast<int>(found - radii.begin());
+        if (found == radii.end()) {
+            radii.push_back(radius);
+            kernel.registerMask(std::max(1, static_cast<int>(std::lround(radius * 0.8))),
+                                std::max(1, static_cast<int>(std::lround(radius * 1.2))),
+                                std::max(1, static_cast<int>(std::lround(radius * 1.5))));
+        }
+
+        for (const auto& center : regionCenters) {
+            centers.push_back(center);
+            maskIds.push_back(maskId);
+        }
+    }
+
+    cv::Mat gray;
+    cv::Mat ink;
+    cv::cvtColor(sheet.image, gray, cv::COLOR_BGR2GRAY);
+    int threshold = static_cast<int>(cv::threshold(gray, ink, 0, 1, cv::THRESH_BINARY_INV | cv::THRESH_OTSU));
+
+    size_t count = centers.size();
+    std::vector<double> scalarFill(count), scalarBackground(count);
+    std::vector<double> simdFill(count), simdBackground(count);
+
+    // Warmup + equivalence
+    kernel.scoreBatchScalar(gray, threshold, centers.data(), maskIds.data(), count,
+                            scalarFill.data(), scalarBackground.data());
+    kernel.scoreBatch(gray, threshold, centers.data(), maskIds.data(), count,
+                      simdFill.data(), simdBackground.data());
+
+    int mismatches = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (scalarFill[i] != simdFill[i] || scalarBackground[i] != simdBackground[i]) {
+            mismatches++;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        kernel.scoreBatchScalar(gray, threshold, centers.data(), maskIds.data(), count,
+                                scalarFill.data(), scalarBackground.data());
+    }
+    double scalarMs = elapsedMs(start) / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        kernel.scoreBatch(gray, threshold, centers.data(), maskIds.data(), count,
+                          simdFill.data(), simdBackground.data());
+    }
+    double simdMs = elapsedMs(start) / iterations;
+
+    // End to end per sheet, preparation included
+    int sink = 0;
+    BubbleSampler integralSampler(0.6);
+    integralSampler.setScoringMethod(BubbleScoringContext::INTEGRAL_LOOKUP);
+    integralSampler.setLayout(sheet.regions);
+    double integralSheetMs = timeSampler(integralSampler, sheet.image, iterations, sink);
+
+    BubbleSampler simdSampler(0.6);
+    simdSampler.setScoringMethod(BubbleScoringContext::SIMD_MASK);
+    simdSampler.setLayout(sheet.regions);
+    double simdSheetMs = timeSampler(simdSampler, sheet.image, iterations, sink);
+
+    int agree = 0;
+    for (size_t q = 0; q < sheet.regions.size(); q++) {
+        agree += (integralSampler.getMarkedAnswer(q) == simdSampler.getMarkedAnswer(q)) ? 1 : 0;
+    }
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "BALON DOLULUK ÇEKİRDEĞİ (" << iterations << " iterasyon, " << count << " balon)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "SIMD: " << (BubbleFillKernel::isVectorized() ? "açık" : "kapalı (skaler yedek)")
+              << ", vektör genişliği " << BubbleFillKernel::getVectorWidth() << " bayt" << std::endl;
+    std::cout << "Otsu eşiği: " << threshold << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Skaler çekirdek:  " << std::setw(9) << (scalarMs * 1000.0) << " µs/kağıt | "
+              << std::setw(8) << (scalarMs * 1e6 / count) << " ns/balon" << std::endl;
+    std::cout << "SIMD çekirdek:    " << std::setw(9) << (simdMs * 1000.0) << " µs/kağıt | "
+              << std::setw(8) << (simdMs * 1e6 / count) << " ns/balon" << std::endl;
+    if (simdMs > 0.0) {
+        std::cout << "Çekirdek hızlanma: " << std::setprecision(1) << (scalarMs / simdMs) << "x" << std::endl;
+    }
+    std::cout << std::setprecision(3);
+    std::cout << "Uyuşmazlık (skaler/SIMD): " << mismatches << "/" << count << std::endl;
+
+    std::cout << "\nUçtan uca sample() (gri + Otsu dahil):" << std::endl;
+    std::cout << "INTEGRAL_LOOKUP:  " << std::setw(9) << (integralSheetMs * 1000.0) << " µs/kağıt" << std::endl;
+    std::cout << "SIMD_MASK:        " << std::setw(9) << (simdSheetMs * 1000.0) << " µs/kağıt" << std::endl;
+    std::cout << "Cevap uyumu:      " << agree << "/" << sheet.regions.size() << std::endl;
+    std::cout << "(kontrol: " << sink << ")" << std::endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
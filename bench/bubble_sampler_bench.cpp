@@ -0,0 +1,116 @@
+/**
+ * Balon Okuma Benchmark'ı
+ * Düzeltilmiş 850x1100 sentetik kağıtta iki yolu karşılaştırır:
+ *   - HOUGH:   BubbleDetector::detectMarkedAnswer (seçenek başına HoughCircles)
+ *   - SAMPLER: BubbleSampler (yerleşimden bilinen merkezler, toplu SIMD maske skoru)
+ *
+ * Kullanım: ./bubble_sampler_bench [iterasyon] [seed]
+ */
+
+#include "BubbleDetector.h"
+#include "BubbleSampler.h"
+#include "SheetTemplate.h"
+#include "bubble_bench_common.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void runScenario(const std::string& name, const SyntheticSheet& sheet, int iterations) {
+    BubbleDetector detector(0.6);
+    BubbleSampler sampler(0.6);
+
+    // Warmup + accuracy
+    int houghCorrect = 0;
+    int samplerCorrect = 0;
+
+    sampler.setLayout(sheet.regions);
+    sampler.sample(sheet.image);
+
+    for (size_t q = 0; q < sheet.regions.size(); q++) {
+        const QuestionRegion& region = sheet.regions[q];
+        int hough = detector.detectMarkedAnswer(sheet.image, region.region, region.numOptions);
+        houghCorrect += (hough == sheet.expected[q]) ? 1 : 0;
+        samplerCorrect += (sampler.getMarkedAnswer(q) == sheet.expected[q]) ? 1 : 0;
+    }
+
+    // Hough path
+    auto start = std::chrono::steady_clock::now();
+    int sink = 0;
+    for (int it = 0; it < iterations; it++) {
+        for (const auto& region : sheet.regions) {
+            sink += detector.detectMarkedAnswer(sheet.image, region.region, region.numOptions);
+        }
+    }
+    double houghMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    // Sampler path (layout built once per template, outside the loop)
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        sampler.sample(sheet.image);
+        for (size_t q = 0; q < sheet.regions.size(); q++) {
+            sink += sampler.getMarkedAnswer(q);
+        }
+    }
+    double samplerMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        sampler.setLayout(sheet.regions);
+    }
+    double layoutMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count() / iterations;
+
+    size_t total = sheet.regions.size();
+    size_t bubbles = sampler.getBubbleCount();
+
+    std::cout << "\n========================================" << std::endl;
+    std::cout << name << " (" << iterations << " iterasyon, " << total << " soru, "
+              << bubbles << " balon)" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Hough:    " << std::setw(9) << houghMs << " ms/kağıt | doğru: "
+              << houghCorrect << "/" << total << std::endl;
+    std::cout << "Sampler:  " << std::setw(9) << samplerMs << " ms/kağıt | doğru: "
+              << samplerCorrect << "/" << total
+              << " (Otsu eşiği: " << sampler.getScoringContext().getInkThreshold() << ")" << std::endl;
+    if (bubbles > 0) {
+        std::cout << "          " << std::setw(9) << (samplerMs * 1e6 / bubbles) << " ns/balon" << std::endl;
+    }
+    std::cout << "Yerleşim: " << std::setw(9) << layoutMs << " ms (şablon başına bir kez)" << std::endl;
+    if (samplerMs > 0.0) {
+        std::cout << "Hızlanma: " << std::setprecision(1) << (houghMs / samplerMs) << "x" << std::endl;
+    }
+    std::cout << "(kontrol: " << sink << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? std::max(1, std::stoi(argv[1])) : 50;
+    uint64_t seed = (argc > 2) ? std::stoull(argv[2]) : 42;
+
+    // Same parallelism as the batch workers
+    cv::setNumThreads(1);
+
+    // Multiple choice block of the default template (the TF block shares its rows)
+    SheetTemplate sheetTemplate = SheetTemplate::createDefault();
+    std::vector<QuestionRegion> choiceRegions;
+    for (const auto& region : sheetTemplate.buildRegions(cv::Size(sheetTemplate.getSheetWidth(),
+                                                                  sheetTemplate.getSheetHeight()))) {
+        if (region.type == QuestionRegion::MULTIPLE_CHOICE) {
+            choiceRegions.push_back(region);
+        }
+    }
+    SyntheticSheet standard = createSheet(choiceRegions, seed);
+    SyntheticSheet dense = createSheet(createDenseRegions(), seed);
+
+    runScenario("STANDART KAĞIT", standard, iterations);
+    // Hough on 1000 bubbles is slow; fewer iterations keep the run short
+    runScenario("YOĞUN KAĞIT", dense, std::max(1, iterations / 10));
+
+    return 0;
+}
@@ -0,0 +1,517 @@
+/**
+ * OMR Aşama Benchmark'ı
+ * İşlem hattının her aşamasını ayrı ayrı, ısınma turlarından sonra tek tek zamanlanan
+ * iterasyonlarla ölçer ve min / ortalama / p50 / p90 / p99 / maks. süreleri raporlar:
+ *   perspective   PerspectiveCorrector::correctPerspective (1920x1440 fotoğraf)
+ *   analyze       SheetStructureAnalyzer::analyzeSheet (düzeltilmiş kağıt)
+ *   bubble        BubbleDetector::detectMarkedAnswer (tek soru)
+ *   handwriting   HandwritingDetector::hasHandwriting (tek yazı kutusu)
+ *   ocr           OCRProcessor::recognizeText (tek satır; Tesseract yoksa atlanır)
+ *   similarity    AnswerComparator::calculateTextSimilarity
+ *   score         ScoreCalculator::calculateScore (varsayılan yerleşimin tüm soruları:
+ *                 10 çoktan seçmeli, 5 boşluk doldurma, 5 doğru/yanlış)
+ *   score_batch   ScoreCalculator::calculateScores (100.000 öğrenci × aynı sorular)
+ * score / score_batch seçildiğinde önce iki puanlama yolu rastgele 2.000 kağıtta karşılaştırılır;
+ * README'deki farklar (boş işaret boş sayılır, kısmi puan yok) dışında bir uyuşmazlık çıkış
+ * kodunu 1 yapar.
+ * Girdiler sabit seed ile sentetik üretilir; --json ile sonuçlar karşılaştırılabilir bir
+ * JSON dosyasına da yazılır. Ölçülen fonksiyonların konsol çıktısı ölçüm sırasında susturulur.
+ *
+ * Kullanım: ./omr_bench [--iterations N] [--warmup N] [--filter ad[,ad...]] [--json sonuc.json] [--seed S]
+ */
+
+#include "PerspectiveCorrector.h"
+#include "SheetStructureAnalyzer.h"
+#include "BubbleDetector.h"
+#include "BubbleSampler.h"
+#include "HandwritingDetector.h"
+#include "OCRProcessor.h"
+#include "AnswerKey.h"
+#include "AnswerComparator.h"
+#include "ScoreCalculator.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int SHEET_WIDTH = 850;
+const int SHEET_HEIGHT = 1100;
+
+const char* const STAGE_NAMES[] = {
+    "perspective", "analyze", "bubble", "handwriting", "ocr", "similarity", "score", "score_batch"
+};
+
+struct BenchConfig {
+    int iterations;
+    int warmup;
+    std::vector<std::string> filter;    // exact stage names; empty = all
+    std::string jsonPath;
+    uint64_t seed;
+
+    BenchConfig() : iterations(200), warmup(20), seed(42) {}
+};
+
+struct BenchResult {
+    std::string name;
+    std::string function;
+    int iterations;
+    double minMs;
+    double meanMs;
+    double p50Ms;
+    double p90Ms;
+    double p99Ms;
+    double maxMs;
+
+    BenchResult() : iterations(0), minMs(0.0), meanMs(0.0), p50Ms(0.0), p90Ms(0.0), p99Ms(0.0), maxMs(0.0) {}
+};
+
+// Stage functions print progress; keep the terminal out of the measurement
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+class ScopedSilence {
+public:
+    ScopedSilence() : previous(std::cout.rdbuf(&nullBuffer)) {}
+    ~ScopedSilence() { std::cout.rdbuf(previous); }
+
+private:
+    NullBuffer nullBuffer;
+    std::streambuf* previous;
+};
+
+// Nearest-rank percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double p) {
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+BenchResult runBench(const std::string& name, const std::string& function, const BenchConfig& config,
+                     const std::function<void(int)>& body) {
+    std::vector<double> samples;
+    samples.reserve(config.iterations);
+
+    {
+        ScopedSilence silence;
+        for (int i = 0; i < config.warmup; i++) {
+            body(i);
+        }
+        for (int i = 0; i < config.iterations; i++) {
+            auto start = std::chrono::steady_clock::now();
+            body(i);
+            samples.push_back(std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    std::vector<double> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+
+    BenchResult result;
+    result.name = name;
+    result.function = function;
+    result.iterations = config.iterations;
+    result.minMs = sorted.front();
+    result.maxMs = sorted.back();
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    result.meanMs = total / samples.size();
+    result.p50Ms = percentile(sorted, 50.0);
+    result.p90Ms = percentile(sorted, 90.0);
+    result.p99Ms = percentile(sorted, 99.0);
+    return result;
+}
+
+void printResult(const BenchResult& r) {
+    std::cout << std::left << std::setw(13) << r.name << std::right << std::fixed << std::setprecision(4)
+              << std::setw(11) << r.minMs << std::setw(11) << r.meanMs << std::setw(11) << r.p50Ms
+              << std::setw(11) << r.p90Ms << std::setw(11) << r.p99Ms << std::setw(11) << r.maxMs << std::endl;
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool writeJson(const std::string& path, const BenchConfig& config, const std::vector<BenchResult>& results) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "JSON dosyası açılamadı: " << path << std::endl;
+        return false;
+    }
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << std::fixed << std::setprecision(6);
+    out << "{\n";
+    out << "  \"timestamp\": \"" << timestamp << "\",\n";
+    out << "  \"opencv\": \"" << CV_VERSION << "\",\n";
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"iterations\": " << config.iterations << ",\n";
+    out << "  \"warmup\": " << config.warmup << ",\n";
+    out << "  \"seed\": " << config.seed << ",\n";
+    out << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"function\": \"" << jsonEscape(r.function)
+            << "\", \"iterations\": " << r.iterations
+            << ", \"min_ms\": " << r.minMs << ", \"mean_ms\": " << r.meanMs
+            << ", \"p50_ms\": " << r.p50Ms << ", \"p90_ms\": " << r.p90Ms
+            << ", \"p99_ms\": " << r.p99Ms << ", \"max_ms\": " << r.maxMs << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return true;
+}
+
+// Default layout, answers filled in: bubbles for MC/TF, a written word in each blank
+cv::Mat createSheet(const std::vector<QuestionRegion>& regions, cv::RNG& rng) {
+    cv::Mat sheet(SHEET_HEIGHT, SHEET_WIDTH, CV_8UC3, cv::Scalar(245, 245, 245));
+    const char* words[] = {"Istanbul", "1923", "Ankara", "Mustafa Kemal", "Cumhuriyet"};
+
+    std::vector<cv::Point> centers;
+    for (const auto& region : regions) {
+        if (region.type == QuestionRegion::FILL_IN_BLANK) {
+            cv::Point origin(region.region.x + 20, region.region.y + region.region.height * 2 / 3);
+            cv::putText(sheet, words[region.questionNumber % 5], origin, cv::FONT_HERSHEY_SCRIPT_SIMPLEX,
+                        1.0, cv::Scalar(40, 30, 20), 2);
+            continue;
+        }
+
+        int radius = 0;
+        BubbleSampler::computeBubbleGeometry(region.region, region.numOptions, centers, radius);
+        int answer = rng.uniform(0, region.numOptions);
+        for (int i = 0; i < static_cast<int>(centers.size()); i++) {
+            cv::circle(sheet, centers[i], radius, cv::Scalar(30, 30, 30), 2);
+            if (i == answer) {
+                cv::circle(sheet, centers[i], std::max(1, radius - 2), cv::Scalar(50, 50, 50), cv::FILLED);
+            }
+        }
+    }
+    return sheet;
+}
+
+// The sheet photographed on a desk with a small random perspective
+cv::Mat createPhoto(const cv::Mat& sheet, cv::RNG& rng) {
+    std::vector<cv::Point2f> src = {
+        cv::Point2f(0, 0), cv::Point2f(SHEET_WIDTH - 1.0f, 0),
+        cv::Point2f(SHEET_WIDTH - 1.0f, SHEET_HEIGHT - 1.0f), cv::Point2f(0, SHEET_HEIGHT - 1.0f)
+    };
+    std::vector<cv::Point2f> dst = {
+        cv::Point2f(420, 150), cv::Point2f(1500, 190), cv::Point2f(1560, 1330), cv::Point2f(360, 1290)
+    };
+    for (auto& point : dst) {
+        point += cv::Point2f(rng.uniform(-20.0f, 20.0f), rng.uniform(-20.0f, 20.0f));
+    }
+
+    cv::Mat photo(1440, 1920, CV_8UC3, cv::Scalar(90, 90, 90));
+    cv::warpPerspective(sheet, photo, cv::getPerspectiveTransform(src, dst), photo.size(),
+                        cv::INTER_LINEAR, cv::BORDER_TRANSPARENT);
+
+    cv::Mat noise(photo.size(), CV_16SC3);
+    rng.fill(noise, cv::RNG::NORMAL, 0, 4);
+    cv::Mat noisy;
+    cv::add(photo, noise, noisy, cv::noArray(), CV_8UC3);
+    return noisy;
+}
+
+// calculateScores against calculateScore (partial credit off) on random sheets. Allowed
+// difference: a blank mark or empty text is unanswered in the batch, incorrect per sheet.
+int countBatchMismatches(const AnswerKey& answerKey, const std::vector<Answer>& questions,
+                         const AnswerComparator& comparator, cv::RNG& rng, size_t sheetCount) {
+    const char* const texts[] = {"Cumhuriyet", " cumhuriyet ", "Cumhurriyet", "Ankara", ""};
+
+    ScoreCalculator calculator(answerKey, comparator);
+    calculator.setPartialCreditEnabled(false);
+
+    std::vector<std::vector<Answer>> sheets(sheetCount);
+    std::vector<int> blanks(sheetCount, 0);
+    AnswerMatrix matrix(sheetCount, static_cast<size_t>(answerKey.getTotalQuestions()));
+    for (size_t s = 0; s < sheetCount; s++) {
+        for (const Answer& question : questions) {
+            int roll = rng.uniform(0, 10);
+            if (roll == 0) {
+                continue;   // nothing read for this question
+            }
+            Answer answer = question;
+            if (roll == 1) {
+                // Read as the other kind of block
+                answer.type = question.type == Answer::FILL_IN_BLANK ? Answer::MULTIPLE_CHOICE : Answer::FILL_IN_BLANK;
+                answer.selectedOption = rng.uniform(0, 2);
+                answer.textAnswer = texts[0];
+            } else if (question.type == Answer::FILL_IN_BLANK) {
+                answer.textAnswer = texts[rng.uniform(0, 5)];
+                blanks[s] += answer.textAnswer.empty();
+            } else {
+                answer.selectedOption = rng.uniform(-1, question.type == Answer::TRUE_FALSE ? 2 : 5);
+                blanks[s] += answer.selectedOption < 0;
+            }
+            sheets[s].push_back(answer);
+        }
+        calculator.encodeAnswers(sheets[s], matrix, s);
+    }
+
+    BatchScores batch = calculator.calculateScores(matrix);
+    if (batch.size() != sheetCount) {
+        return static_cast<int>(sheetCount);
+    }
+
+    int mismatches = 0;
+    for (size_t s = 0; s < sheetCount; s++) {
+        ExamScore single = calculator.calculateScore(sheets[s]);
+        bool same = batch.correctAnswers[s] == single.correctAnswers &&
+                    batch.incorrectAnswers[s] + blanks[s] == single.incorrectAnswers &&
+                    batch.unanswered[s] == single.unanswered + blanks[s] &&
+                    std::abs(batch.rawScore[s] - single.rawScore) < 1e-3;
+        mismatches += !same;
+    }
+    return mismatches;
+}
+
+bool parseArgs(int argc, char* argv[], BenchConfig& config) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--iterations" && i + 1 < argc) {
+            config.iterations = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            config.warmup = std::max(0, std::stoi(argv[++i]));
+        } else if (arg == "--filter" && i + 1 < argc) {
+            // Comma-separated stage names, matched exactly ("score" does not select "score_batch")
+            std::stringstream names(argv[++i]);
+            std::string name;
+            while (std::getline(names, name, ',')) {
+                if (name.empty()) {
+                    continue;
+                }
+                if (std::find(std::begin(STAGE_NAMES), std::end(STAGE_NAMES), name) == std::end(STAGE_NAMES)) {
+                    std::cerr << "HATA: Bilinmeyen aşama: " << name << std::endl;
+                    return false;
+                }
+                config.filter.push_back(name);
+            }
+        } else if (arg == "--json" && i + 1 < argc) {
+            config.jsonPath = argv[++i];
+        } else if (arg == "--seed" && i + 1 < argc) {
+            config.seed = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Kullanım: " << argv[0]
+                      << " [--iterations N] [--warmup N] [--filter ad[,ad...]] [--json sonuc.json] [--seed S]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (!parseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    cv::setNumThreads(1);
+    cv::RNG rng(config.seed);
+
+    // Inputs: the default layout rendered, photographed, and its corrected version
+    SheetStructureAnalyzer analyzer;
+    std::vector<QuestionRegion> regions;
+    {
+        ScopedSilence silence;
+        regions = analyzer.analyzeSheet(cv::Mat(SHEET_HEIGHT, SHEET_WIDTH, CV_8UC3, cv::Scalar(245, 245, 245)));
+    }
+    cv::Mat sheet = createSheet(regions, rng);
+    cv::Mat photo = createPhoto(sheet, rng);
+
+    std::vector<QuestionRegion> choiceRegions;
+    std::vector<QuestionRegion> fillRegions;
+    for (const auto& region : regions) {
+        (region.type == QuestionRegion::FILL_IN_BLANK ? fillRegions : choiceRegions).push_back(region);
+    }
+    if (choiceRegions.empty() || fillRegions.empty()) {
+        std::cerr << "HATA: Varsayılan yerleşimde soru bölgesi bulunamadı" << std::endl;
+        return 1;
+    }
+
+    // One question per region, numbered through the sheet so blocks never share a number
+    AnswerKey answerKey;
+    std::vector<Answer> studentAnswers;
+    int questionNumber = 0;
+    for (const auto& region : regions) {
+        questionNumber++;
+        Answer answer;
+        answer.questionNumber = questionNumber;
+        if (region.type == QuestionRegion::FILL_IN_BLANK) {
+            answerKey.addFillInBlankAnswer(questionNumber, "Cumhuriyet");
+            answer.type = Answer::FILL_IN_BLANK;
+            answer.textAnswer = questionNumber % 2 == 0 ? "Cumhuriyet" : "Cumhurriyet";
+        } else if (region.type == QuestionRegion::TRUE_FALSE) {
+            answerKey.addTrueFalseAnswer(questionNumber, questionNumber % 2 == 0);
+            answer.type = Answer::TRUE_FALSE;
+            answer.selectedOption = rng.uniform(0, 2);
+        } else {
+            answerKey.addMultipleChoiceAnswer(questionNumber, questionNumber % 5);
+            answer.type = Answer::MULTIPLE_CHOICE;
+            answer.selectedOption = rng.uniform(-1, 5);
+        }
+        studentAnswers.push_back(answer);
+    }
+
+    const std::vector<std::pair<std::string, std::string>> textPairs = {
+        {"Istanbul", "İstanbul"}, {"Mustafa Kemal", "Mustafa Kemal Atatürk"},
+        {"1923", "1932"}, {"Cumhuriyet", "Cumhurriyet"}, {"Ankara", "Izmir"}
+    };
+
+    PerspectiveCorrector corrector;
+    corrector.setVerbose(false);
+    BubbleDetector bubbleDetector(0.6);
+    HandwritingDetector handwritingDetector(0.02);
+    AnswerComparator comparator(false);
+    ScoreCalculator scoreCalculator(answerKey, comparator);
+
+    // Whole-class matrix: the synthetic sheet's text verdicts with random bubble marks per row
+    const size_t classSize = 100000;
+    AnswerMatrix classAnswers(classSize, static_cast<size_t>(answerKey.getTotalQuestions()));
+    scoreCalculator.encodeAnswers(studentAnswers, classAnswers, 0);
+    for (size_t student = 1; student < classSize; student++) {
+        for (const auto& answer : studentAnswers) {
+            size_t question = static_cast<size_t>(answer.questionNumber - 1);
+            uint8_t code = classAnswers.get(0, question);
+            if (answer.type != Answer::FILL_IN_BLANK) {
+                code = AnswerMatrix::optionCode(rng.uniform(-1, answer.type == Answer::TRUE_FALSE ? 2 : 5));
+            }
+            classAnswers.set(student, question, code);
+        }
+    }
+
+    std::vector<BenchResult> results;
+    auto selected = [&config](const std::string& name) {
+        return config.filter.empty() ||
+               std::find(config.filter.begin(), config.filter.end(), name) != config.filter.end();
+    };
+
+    int batchMismatches = 0;
+    if (selected("score") || selected("score_batch")) {
+        const size_t checkSheets = 2000;
+        cv::RNG checkRng(config.seed + 1);
+        batchMismatches = countBatchMismatches(answerKey, studentAnswers, comparator, checkRng, checkSheets);
+        std::cout << "calculateScores / calculateScore eşdeğerliği: " << checkSheets << " kağıt, "
+                  << batchMismatches << " uyuşmazlık\n" << std::endl;
+    }
+
+    std::cout << "Isınma: " << config.warmup << ", iterasyon: " << config.iterations
+              << ", seed: " << config.seed << " (süreler ms)\n" << std::endl;
+    std::cout << std::left << std::setw(13) << "aşama" << std::right
+              << std::setw(11) << "min" << std::setw(11) << "ort" << std::setw(11) << "p50"
+              << std::setw(11) << "p90" << std::setw(11) << "p99" << std::setw(11) << "maks" << std::endl;
+
+    volatile int sink = 0;      // keeps results observable so calls are not optimised away
+
+    if (selected("perspective")) {
+        results.push_back(runBench("perspective", "PerspectiveCorrector::correctPerspective", config, [&](int) {
+            sink = sink + corrector.correctPerspective(photo).rows;
+        }));
+        printResult(results.back());
+    }
+
+    if (selected("analyze")) {
+        results.push_back(runBench("analyze", "SheetStructureAnalyzer::analyzeSheet", config, [&](int) {
+            sink = sink + static_cast<int>(analyzer.analyzeSheet(sheet).size());
+        }));
+        printResult(results.back());
+    }
+
+    if (selected("bubble")) {
+        results.push_back(runBench("bubble", "BubbleDetector::detectMarkedAnswer", config, [&](int i) {
+            const QuestionRegion& region = choiceRegions[i % choiceRegions.size()];
+            sink = sink + bubbleDetector.detectMarkedAnswer(sheet, region.region, region.numOptions);
+        }));
+        printResult(results.back());
+    }
+
+    if (selected("handwriting")) {
+        results.push_back(runBench("handwriting", "HandwritingDetector::hasHandwriting", config, [&](int i) {
+            sink = sink + handwritingDetector.hasHandwriting(sheet, fillRegions[i % fillRegions.size()].region);
+        }));
+        printResult(results.back());
+    }
+
+    if (selected("ocr")) {
+        std::unique_ptr<OCRProcessor> ocr;
+        {
+            ScopedSilence silence;
+            ocr = std::make_unique<OCRProcessor>("tur");
+        }
+        if (ocr->isInitialized()) {
+            cv::Mat line = sheet(fillRegions.front().region).clone();
+            results.push_back(runBench("ocr", "OCRProcessor::recognizeText", config, [&](int) {
+                sink = sink + static_cast<int>(ocr->recognizeText(line).size());
+            }));
+            printResult(results.back());
+        } else {
+            std::cout << std::left << std::setw(13) << "ocr" << "atlandı (Tesseract başlatılamadı)" << std::endl;
+        }
+    }
+
+    if (selected("similarity")) {
+        results.push_back(runBench("similarity", "AnswerComparator::calculateTextSimilarity", config, [&](int i) {
+            const auto& pair = textPairs[i % textPairs.size()];
+            sink = sink + static_cast<int>(comparator.calculateTextSimilarity(pair.first, pair.second) * 100.0);
+        }));
+        printResult(results.back());
+    }
+
+    if (selected("score")) {
+        results.push_back(runBench("score", "ScoreCalculator::calculateScore", config, [&](int) {
+            sink = sink + scoreCalculator.calculateScore(studentAnswers).correctAnswers;
+        }));
+        printResult(results.back());
+    }
+
+    if (selected("score_batch")) {
+        results.push_back(runBench("score_batch", "ScoreCalculator::calculateScores", config, [&](int i) {
+            sink = sink + scoreCalculator.calculateScores(classAnswers).correctAnswers[i % classSize];
+        }));
+        printResult(results.back());
+    }
+
+    if (results.empty()) {
+        std::cerr << "HATA: Seçilen aşamaların hiçbiri ölçülemedi" << std::endl;
+        return 1;
+    }
+
+    if (!config.jsonPath.empty()) {
+        if (!writeJson(config.jsonPath, config, results)) {
+            return 1;
+        }
+        std::cout << "\nJSON: " << config.jsonPath << std::endl;
+    }
+
+    return batchMismatches == 0 ? 0 : 1;
+}
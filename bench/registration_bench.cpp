@@ -0,0 +1,267 @@
+/**
+ * Kağıt Kayıt (Registration) Benchmark'ı
+ * Köşe işaretçili sentetik bir kağıdı rastgele perspektifle 1920x1440 gürültülü bir masa
+ * fotoğrafına yerleştirir ve köşe bulma süresini iki yol için karşılaştırır:
+ *   - KONTUR:    PerspectiveCorrector::detectPaperCorners (tam kare Canny + findContours)
+ *   - İŞARETÇİ:  PerspectiveCorrector::detectFiducialMarkers (küçültülmüş köşe pencereleri)
+ * İşaretçi merkezlerinin bilinen homografiye göre hatasını ve işaretçisiz kağıtta AUTO
+ * modunun kontur yoluna düştüğünü de raporlar; köşelerine yakın dolu cevap balonları olan
+ * işaretçisiz kağıt da işaretçi sanılmamalıdır. Son olarak düzeltme (warp) maliyetini
+ * karşılaştırır: tam renkli, tam gri ve yalnızca şablon bölgeleri (SheetWarp, ilk kare ve
+ * haritaları yeniden kullanan sonraki kareler).
+ *
+ * Kullanım: ./registration_bench [iterasyon] [seed]
+ */
+
+#include "PerspectiveCorrector.h"
+#include "SheetWarp.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const int SHEET_WIDTH = 850;
+const int SHEET_HEIGHT = 1100;
+const float MARKER_INSET = 25.0f;
+const int MARKER_HALF = 15;
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<cv::Point2f> markerCenters() {
+    return {
+        cv::Point2f(MARKER_INSET, MARKER_INSET),
+        cv::Point2f(SHEET_WIDTH - 1 - MARKER_INSET, MARKER_INSET),
+        cv::Point2f(SHEET_WIDTH - 1 - MARKER_INSET, SHEET_HEIGHT - 1 - MARKER_INSET),
+        cv::Point2f(MARKER_INSET, SHEET_HEIGHT - 1 - MARKER_INSET)
+    };
+}
+
+cv::Mat createSheet(bool withMarkers, bool filledCornerBubbles = false) {
+    cv::Mat sheet(SHEET_HEIGHT, SHEET_WIDTH, CV_8UC3, cv::Scalar(245, 245, 245));
+
+    for (int i = 0; i < 10; i++) {
+        int y = 120 + i * 50;
+        cv::putText(sheet, std::to_string(i + 1) + ".", cv::Point(60, y + 8),
+                    cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 0, 0), 2);
+        for (int option = 0; option < 5; option++) {
+            cv::circle(sheet, cv::Point(150 + option * 120, y), 12, cv::Scalar(40, 40, 40), 2);
+        }
+    }
+    for (int i = 0; i < 5; i++) {
+        cv::line(sheet, cv::Point(100, 620 + i * 70), cv::Point(780, 620 + i * 70), cv::Scalar(0, 0, 0), 1);
+    }
+
+    if (withMarkers) {
+        // Top: solid squares, bottom: concentric targets
+        std::vector<cv::Point2f> centers = markerCenters();
+        for (size_t i = 0; i < centers.size(); i++) {
+            cv::Point center(cvRound(centers[i].x), cvRound(centers[i].y));
+            if (i < 2) {
+                cv::rectangle(sheet, center - cv::Point(MARKER_HALF, MARKER_HALF),
+                              center + cv::Point(MARKER_HALF, MARKER_HALF), cv::Scalar(0, 0, 0), cv::FILLED);
+            } else {
+                cv::circle(sheet, center, MARKER_HALF, cv::Scalar(0, 0, 0), cv::FILLED);
+                cv::circle(sheet, center, 10, cv::Scalar(245, 245, 245), cv::FILLED);
+                cv::circle(sheet, center, 5, cv::Scalar(0, 0, 0), cv::FILLED);
+            }
+        }
+    }
+
+    if (filledCornerBubbles) {
+        // Marked answers where the markers would be: the worst case for the marker search
+        std::vector<cv::Point2f> centers = markerCenters();
+        for (size_t i = 0; i < centers.size(); i++) {
+            cv::Point center(cvRound(centers[i].x) + (i == 1 || i == 2 ? -8 : 8),
+                             cvRound(centers[i].y) + (i < 2 ? 8 : -8));
+            cv::circle(sheet, center, 13, cv::Scalar(20, 20, 20), cv::FILLED);
+        }
+    }
+
+    return sheet;
+}
+
+cv::Mat createPhoto(const cv::Mat& sheet, cv::RNG& rng, cv::Mat& homography) {
+    std::vector<cv::Point2f> src = {
+        cv::Point2f(0, 0),
+        cv::Point2f(SHEET_WIDTH - 1, 0),
+        cv::Point2f(SHEET_WIDTH - 1, SHEET_HEIGHT - 1),
+        cv::Point2f(0, SHEET_HEIGHT - 1)
+    };
+    // Keystone from a tilted camera, roughly keeping the sheet's aspect ratio
+    std::vector<cv::Point2f> dst = {
+        cv::Point2f(520, 120), cv::Point2f(1420, 160), cv::Point2f(1470, 1330), cv::Point2f(470, 1290)
+    };
+    for (auto& point : dst) {
+        point.x += rng.uniform(-20.0f, 20.0f);
+        point.y += rng.uniform(-20.0f, 20.0f);
+    }
+    homography = cv::getPerspectiveTransform(src, dst);
+
+    cv::Mat photo(1440, 1920, CV_8UC3, cv::Scalar(90, 90, 90));
+    cv::Mat noise(photo.size(), CV_8UC3);
+    rng.fill(noise, cv::RNG::UNIFORM, 0, 30);
+    cv::add(photo, noise, photo);
+
+    cv::warpPerspective(sheet, photo, homography, photo.size(), cv::INTER_LINEAR, cv::BORDER_TRANSPARENT);
+    return photo;
+}
+
+// Rows of templates/default_sheet.yml (TF, MC, FILL) with the grader's 4 px padding
+std::vector<cv::Rect> defaultTemplateRects() {
+    std::vector<cv::Rect> rects;
+    for (int i = 0; i < 5; i++) {
+        rects.push_back(cv::Rect(46, 46 + i * 50, 758, 48));
+    }
+    for (int i = 0; i < 10; i++) {
+        rects.push_back(cv::Rect(46, 96 + i * 50, 758, 48));
+    }
+    for (int i = 0; i < 5; i++) {
+        rects.push_back(cv::Rect(46, 496 + i * 70, 758, 68));
+    }
+    return rects;
+}
+
+void runWarpComparison(PerspectiveCorrector& corrector, const cv::Mat& photo, int iterations) {
+    cv::Mat homography;
+    if (!corrector.registerSheet(photo, homography, SHEET_WIDTH, SHEET_HEIGHT)) {
+        return;
+    }
+    const cv::Mat& gray = corrector.getRegistrationGray();
+    cv::Size sheetSize(SHEET_WIDTH, SHEET_HEIGHT);
+    std::vector<cv::Rect> rects = defaultTemplateRects();
+
+    cv::Mat warped;
+    auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        cv::warpPerspective(photo, warped, homography, sheetSize);
+    }
+    double colorMs = elapsedMs(start) / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        cv::warpPerspective(gray, warped, homography, sheetSize);
+    }
+    double grayMs = elapsedMs(start) / iterations;
+
+    // New homography every sheet (batch): maps are built and used once
+    SheetWarp sheetWarp;
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        sheetWarp.reset();
+        sheetWarp.setHomography(homography, sheetSize);
+        sheetWarp.setSource(gray);
+        warped = sheetWarp.renderRegions(rects);
+    }
+    double regionColdMs = elapsedMs(start) / iterations;
+    size_t warpedPixels = sheetWarp.getWarpedPixelCount();
+
+    // Steady camera: same homography, new frame, maps reused
+    start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; it++) {
+        sheetWarp.setHomography(homography, sheetSize);
+        sheetWarp.setSource(gray);
+        warped = sheetWarp.renderRegions(rects);
+    }
+    double regionWarmMs = elapsedMs(start) / iterations;
+
+    std::cout << "\n--- Düzeltme (850x1100) ---" << std::endl;
+    std::cout << "Tam renkli warp:        " << colorMs << " ms" << std::endl;
+    std::cout << "Tam gri warp:           " << grayMs << " ms" << std::endl;
+    std::cout << "Bölge warp (ilk kare):  " << regionColdMs << " ms  (" << warpedPixels << " / "
+              << sheetSize.area() << " piksel)" << std::endl;
+    std::cout << "Bölge warp (harita hazır): " << regionWarmMs << " ms" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? std::max(1, std::stoi(argv[1])) : 50;
+    uint64_t seed = (argc > 2) ? std::stoull(argv[2]) : 42;
+
+    cv::setNumThreads(1);
+    cv::RNG rng(seed);
+
+    PerspectiveCorrector corrector;
+    corrector.setMarkerInset(MARKER_INSET);
+
+    cv::Mat markedSheet = createSheet(true);
+    cv::Mat plainSheet = createSheet(false);
+    cv::Mat bubbleSheet = createSheet(false, true);
+
+    double contourMs = 0.0;
+    double fiducialMs = 0.0;
+    double maxError = 0.0;
+    int contourFound = 0;
+    int fiducialFound = 0;
+    std::vector<cv::Point2f> expected;
+    cv::Mat lastPhoto;
+
+    for (int it = 0; it < iterations; it++) {
+        cv::Mat homography;
+        cv::Mat photo = createPhoto(markedSheet, rng, homography);
+        cv::perspectiveTransform(markerCenters(), expected, homography);
+        lastPhoto = photo;
+
+        auto start = std::chrono::steady_clock::now();
+        try {
+            corrector.detectPaperCorners(photo);
+            contourFound++;
+        } catch (const std::exception&) {
+        }
+        contourMs += elapsedMs(start);
+
+        std::vector<cv::Point2f> centers;
+        start = std::chrono::steady_clock::now();
+        bool found = corrector.detectFiducialMarkers(photo, centers);
+        fiducialMs += elapsedMs(start);
+
+        if (found) {
+            fiducialFound++;
+            for (size_t i = 0; i < centers.size(); i++) {
+                maxError = std::max(maxError, static_cast<double>(cv::norm(centers[i] - expected[i])));
+            }
+        }
+    }
+
+    // Sheets without markers must not produce a false registration, even with filled
+    // bubbles at the corners (every other photo)
+    int falsePositives = 0;
+    int fallbacks = 0;
+    for (int it = 0; it < std::min(iterations, 20); it++) {
+        cv::Mat homography;
+        cv::Mat photo = createPhoto((it % 2 == 0) ? plainSheet : bubbleSheet, rng, homography);
+
+        std::vector<cv::Point2f> centers;
+        if (corrector.detectFiducialMarkers(photo, centers)) {
+            falsePositives++;
+        }
+        corrector.correctPerspective(photo);
+        if (corrector.getLastMethod() == PerspectiveCorrector::CONTOUR) {
+            fallbacks++;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n=== Kağıt Kayıt Benchmark (" << iterations << " fotoğraf, 1920x1440) ===" << std::endl;
+    std::cout << "KONTUR:   " << contourMs / iterations << " ms/kare  (bulunan: "
+              << contourFound << "/" << iterations << ")" << std::endl;
+    std::cout << "İŞARETÇİ: " << fiducialMs / iterations << " ms/kare  (bulunan: "
+              << fiducialFound << "/" << iterations << ", maks. hata " << maxError << " px)" << std::endl;
+    if (fiducialMs > 0.0) {
+        std::cout << "Hızlanma: " << contourMs / fiducialMs << "x" << std::endl;
+    }
+    std::cout << "İşaretçisiz kağıt (yarısı köşede dolu balonlu): yanlış pozitif " << falsePositives << ", kontura düşen "
+              << fallbacks << "/" << std::min(iterations, 20) << std::endl;
+
+    runWarpComparison(corrector, lastPhoto, iterations);
+
+    return (fiducialFound == iterations && falsePositives == 0
+            && fallbacks == std::min(iterations, 20)) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+/**
+ * Belge Kamerası Oturumu Benchmark'ı
+ * Kamera altında çevrilen bir desteyi 1280x720 sentetik karelerle taklit eder: her kağıt
+ * birkaç hareketli kareyle (kayan sayfa ve el) gelir, sonra gürültülü sabit karelerde durur.
+ * Kağıtlar aynı şablonda ve aynı yazılarla, yalnızca balon işaretlerinde farklıdır; bazıları
+ * tekrar gösterilir (aynı sayfa geri çevrilmiş gibi). Hareketten sonra sabitlenen her sayfa
+ * tam bir kez çekilmelidir, tekrarlar dahil. DocumentSession::update kare başına süresini,
+ * kaçırılan / fazla çekimleri ve olası tekrar uyarılarının tekrarlara ve farklı kağıtlara
+ * dağılımını raporlar.
+ *
+ * Kullanım: ./session_bench [kağıt sayısı] [seed]
+ */
+
+#include "DocumentSession.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const int FRAME_WIDTH = 1280;
+const int FRAME_HEIGHT = 720;
+const int MOVING_FRAMES = 4;
+const int STILL_FRAMES = 10;
+const int REPEAT_EVERY = 5;     // every 5th sheet is the previous one shown again
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Same layout and writing on every sheet; only the filled bubbles differ
+cv::Mat createSheet(cv::RNG& rng) {
+    static const char* const WORDS[] = {"ankara", "izmir", "bursa", "konya", "edirne"};
+
+    cv::Mat sheet(1100, 850, CV_8UC3, cv::Scalar(245, 245, 245));
+
+    for (int i = 0; i < 10; i++) {
+        int y = 120 + i * 50;
+        cv::putText(sheet, std::to_string(i + 1) + ".", cv::Point(60, y + 8),
+                    cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 0, 0), 2);
+        for (int option = 0; option < 5; option++) {
+            cv::circle(sheet, cv::Point(150 + option * 120, y), 12, cv::Scalar(40, 40, 40), 2);
+        }
+        cv::circle(sheet, cv::Point(150 + rng.uniform(0, 5) * 120, y), 10, cv::Scalar(0, 0, 0), cv::FILLED);
+    }
+    for (int i = 0; i < 5; i++) {
+        int y = 620 + i * 70;
+        cv::line(sheet, cv::Point(100, y), cv::Point(780, y), cv::Scalar(0, 0, 0), 1);
+        cv::putText(sheet, WORDS[i], cv::Point(150, y - 10),
+                    cv::FONT_HERSHEY_SIMPLEX, 1.0, cv::Scalar(0, 0, 0), 2);
+    }
+
+    return sheet;
+}
+
+// The sheet lies on the platen at a fixed pose, offset while it is being placed
+cv::Mat renderFrame(const cv::Mat& sheet, cv::Point2f offset, bool hand, cv::RNG& rng) {
+    std::vector<cv::Point2f> src = {
+        cv::Point2f(0, 0), cv::Point2f(849, 0), cv::Point2f(849, 1099), cv::Point2f(0, 1099)
+    };
+    std::vector<cv::Point2f> dst = {
+        cv::Point2f(370, 40), cv::Point2f(910, 45), cv::Point2f(915, 690), cv::Point2f(365, 685)
+    };
+    for (auto& point : dst) {
+        point += offset;
+    }
+
+    cv::Mat frame(FRAME_HEIGHT, FRAME_WIDTH, CV_8UC3, cv::Scalar(70, 70, 70));
+    cv::warpPerspective(sheet, frame, cv::getPerspectiveTransform(src, dst), frame.size(),
+                        cv::INTER_LINEAR, cv::BORDER_TRANSPARENT);
+    if (hand) {
+        cv::ellipse(frame, cv::Point(cvRound(900 + offset.x), cvRound(500 + offset.y)), cv::Size(160, 90),
+                    30.0, 0.0, 360.0, cv::Scalar(120, 150, 200), cv::FILLED);
+    }
+
+    // Sensor noise
+    cv::Mat noise(frame.size(), CV_16SC3);
+    rng.fill(noise, cv::RNG::NORMAL, cv::Scalar::all(0), cv::Scalar::all(3));
+    cv::Mat noisy;
+    cv::add(frame, noise, noisy, cv::noArray(), CV_8UC3);
+    return noisy;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int sheetCount = (argc > 1) ? std::max(2, std::stoi(argv[1])) : 40;
+    uint64_t seed = (argc > 2) ? std::stoull(argv[2]) : 42;
+
+    cv::setNumThreads(1);
+    cv::RNG rng(seed);
+
+    DocumentSession session;
+
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+    size_t frames = 0;
+    int expectedCaptures = 0;
+    int expectedRepeats = 0;
+    int missed = 0;
+    int falseCaptures = 0;
+    int flaggedRepeats = 0;     // repeats warned as suspected duplicates
+    int flaggedDistinct = 0;    // different sheets warned anyway (still captured)
+    cv::Mat previousSheet;
+
+    for (int s = 0; s < sheetCount; s++) {
+        bool repeat = !previousSheet.empty() && s % REPEAT_EVERY == REPEAT_EVERY - 1;
+        cv::Mat sheet = repeat ? previousSheet : createSheet(rng);
+        expectedCaptures++;
+        if (repeat) {
+            expectedRepeats++;
+        }
+
+        int capturesForSheet = 0;
+        for (int f = 0; f < MOVING_FRAMES + STILL_FRAMES; f++) {
+            bool moving = f < MOVING_FRAMES;
+            float slide = moving ? 60.0f * (MOVING_FRAMES - f) : 0.0f;
+            cv::Mat frame = renderFrame(sheet, cv::Point2f(slide, -slide / 3.0f), moving, rng);
+
+            auto start = std::chrono::steady_clock::now();
+            DocumentSession::Event event = session.update(frame);
+            double ms = elapsedMs(start);
+            totalMs += ms;
+            maxMs = std::max(maxMs, ms);
+            frames++;
+
+            if (event == DocumentSession::CAPTURED) {
+                capturesForSheet++;
+                if (session.isSuspectedDuplicate()) {
+                    (repeat ? flaggedRepeats : flaggedDistinct)++;
+                }
+            }
+        }
+
+        if (capturesForSheet == 0) {
+            missed++;
+        } else {
+            falseCaptures += capturesForSheet - 1;
+        }
+        previousSheet = sheet;
+    }
+
+    const SessionStats& stats = session.getStats();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Kare:              " << frames << " (" << FRAME_WIDTH << "x" << FRAME_HEIGHT << ")" << std::endl;
+    std::cout << "update ort/maks:   " << (totalMs / frames) << " / " << maxMs << " ms" << std::endl;
+    std::cout << "Çekilen:           " << stats.captured << " / " << expectedCaptures << " kağıt" << std::endl;
+    std::cout << "Olası tekrar:      " << flaggedRepeats << " / " << expectedRepeats << " tekrar, "
+              << flaggedDistinct << " / " << (expectedCaptures - expectedRepeats) << " farklı kağıt" << std::endl;
+    std::cout << "Kaçırılan:         " << missed << std::endl;
+    std::cout << "Yanlış çekim:      " << falseCaptures << std::endl;
+    std::cout << "Bulanık kare:      " << stats.blurryFrames << std::endl;
+
+    return (missed == 0 && falseCaptures == 0) ? 0 : 1;
+}
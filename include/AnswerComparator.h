@@ -14,6 +14,7 @@ public:
     bool compareTrueFalse(int studentAnswer, int correctAnswer) const;
     bool compareAnswer(const Answer& studentAns, const Answer& correctAns) const;
     void setCaseSensitive(bool sensitive);
+    bool isCaseSensitive() const;
     double calculateTextSimilarity(const std::string& text1, const std::string& text2) const;
 
 private:
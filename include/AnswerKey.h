@@ -1,6 +1,7 @@
 #ifndef ANSWER_KEY_H
 #define ANSWER_KEY_H
 
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <map>
@@ -17,6 +18,8 @@ struct Answer {
 class AnswerKey {
 public:
     AnswerKey();
+    AnswerKey(const AnswerKey& other);
+    AnswerKey& operator=(const AnswerKey& other);
     
     void addMultipleChoiceAnswer(int questionNum, int correctOption);
     void addFillInBlankAnswer(int questionNum, const std::string& correctText);
@@ -27,9 +30,14 @@ public:
     bool loadFromFile(const std::string& filename);
     bool saveToFile(const std::string& filename) const;
     void clear();
+    const std::map<int, Answer>& getAnswers() const;
+    // Unique across all keys in the process and renewed by every edit, copy and assignment;
+    // compiled keys compare against it
+    uint64_t getRevision() const;
 
 private:
     std::map<int, Answer> answers;
+    uint64_t revision;
 };
 
 #endif
@@ -0,0 +1,62 @@
+#ifndef ANSWER_MATRIX_H
+#define ANSWER_MATRIX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Sınıf ölçeğinde puanlama için öğrenci × soru cevap matrisi, hücre başına bir baytlık kod.
+ * Sütun düzenlidir: sütun q soru q+1'e karşılık gelir ve bir sütundaki öğrenciler bellekte
+ * ardışıktır, böylece ScoreCalculator::calculateScores her soruda bitişik baytlar üzerinde döner.
+ *
+ * Balon kodu: bit k = seçenek k işaretli (k < MAX_OPTIONS), 0 = boş, birden fazla bit = çoklu işaret.
+ * Yazı sorularında karşılaştırma kodlarken yapılır: TEXT_MATCH / TEXT_MISMATCH. Bu kodlar ve
+ * TYPE_MISMATCH üst iki bittedir, hiçbir seçenek koduyla çakışmaz.
+ *
+ * Bu üç kod anahtara bağlıdır; matris ilk encodeAnswers çağrısında kodlandığı anahtar
+ * revizyonunu kaydeder. Anahtar düzenlendikten sonra eski matris puanlanmaz: resize ile
+ * sıfırlanıp kağıtlar yeniden kodlanmalıdır.
+ */
+class AnswerMatrix {
+public:
+    static constexpr uint8_t BLANK = 0;
+    static constexpr uint8_t TEXT_MATCH = 0x40;
+    static constexpr uint8_t TEXT_MISMATCH = 0x80;
+    static constexpr uint8_t TYPE_MISMATCH = 0xC0;   // answer type differs from the key: never correct
+    static constexpr int MAX_OPTIONS = 6;             // option bits 0-5
+
+    AnswerMatrix();
+    AnswerMatrix(size_t studentCount, size_t questionCount);
+    AnswerMatrix(const AnswerMatrix& other);
+    AnswerMatrix& operator=(const AnswerMatrix& other);
+
+    void resize(size_t studentCount, size_t questionCount);    // all cells BLANK, no key revision
+
+    // AnswerKey revision the cells were encoded against, 0 = none yet. claimKeyRevision stamps an
+    // unstamped matrix and reports whether it matches; safe while rows are encoded in parallel.
+    uint64_t getKeyRevision() const { return keyRevision.load(std::memory_order_relaxed); }
+    bool claimKeyRevision(uint64_t revision);
+
+    // -1 (blank / multiple as reported by the readers) and out-of-range options map to BLANK
+    static uint8_t optionCode(int option);
+    static uint8_t markCode(const std::vector<int>& markedOptions);
+
+    void set(size_t student, size_t question, uint8_t code) { codes[question * studentCount + student] = code; }
+    uint8_t get(size_t student, size_t question) const { return codes[question * studentCount + student]; }
+
+    uint8_t* column(size_t question) { return codes.data() + question * studentCount; }
+    const uint8_t* column(size_t question) const { return codes.data() + question * studentCount; }
+
+    size_t getStudentCount() const;
+    size_t getQuestionCount() const;
+
+private:
+    size_t studentCount;
+    size_t questionCount;
+    std::vector<uint8_t> codes;
+    std::atomic<uint64_t> keyRevision;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef BATCH_GRADER_H
+#define BATCH_GRADER_H
+
+#include "AnswerKey.h"
+#include "CompiledAnswerKey.h"
+#include "OCREnginePool.h"
+#include "ScoreCalculator.h"
+#include "SheetResult.h"
+#include "SheetTemplate.h"
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct BatchOptions {
+    int numWorkers;                 // 0 = donanım thread sayısı
+    std::string language;
+    bool partialCreditEnabled;
+    double partialCreditThreshold;
+    std::string templatePath;       // boş = varsayılan yerleşim
+    bool grayWarp;                  // düzeltilmiş kağıt tek kanal
+    bool regionWarp;                // yalnızca şablon bölgeleri dönüştürülür
+
+    BatchOptions() : numWorkers(0), language("tur"), partialCreditEnabled(true),
+                     partialCreditThreshold(0.7), grayWarp(true), regionWarp(false) {}
+};
+
+/**
+ * Çok sayıda sınav kağıdını pencere açmadan, thread havuzu ile değerlendirir.
+ * Worker'lar motorlarını önceden ısıtılmış bir OCREnginePool'dan ödünç alır; Tesseract
+ * Init maliyeti havuz kurulurken bir kez ödenir, start() tekrar çağrılsa da tekrarlanmaz.
+ */
+class BatchGrader {
+public:
+    // Called on the worker thread as soon as a sheet is graded; must be thread-safe
+    using ResultCallback = std::function<void(size_t index, const SheetResult& result)>;
+
+    explicit BatchGrader(const AnswerKey& answerKey, const BatchOptions& options = BatchOptions());
+    ~BatchGrader();
+
+    static std::vector<std::string> collectImagePaths(const std::string& directoryOrManifest);
+
+    bool start();
+    void submitFile(const std::string& imagePath);
+    void submitImage(const std::string& sheetId, const cv::Mat& image);
+    std::vector<SheetResult> finish();
+    std::vector<SheetResult> gradeFiles(const std::vector<std::string>& imagePaths);
+    void setResultCallback(ResultCallback callback);   // before start()
+    int getWorkerCount() const;
+    OCRPoolStats getOCRPoolStats() const;
+
+private:
+    struct SheetJob {
+        size_t index;
+        std::string sheetId;
+        std::string imagePath;
+        cv::Mat image;
+    };
+
+    const AnswerKey& answerKey;
+    BatchOptions options;
+
+    std::vector<std::thread> workers;
+    std::deque<SheetJob> pendingJobs;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    size_t submittedCount;
+    bool stopping;
+
+    std::unique_ptr<OCREnginePool> enginePool;
+    SheetTemplate sheetTemplate;    // parsed once in start(), read-only while workers run
+    std::shared_ptr<const CompiledAnswerKey> compiledKey;  // compiled in start(), shared by all workers
+
+    std::mutex resultsMutex;
+    std::vector<std::pair<size_t, SheetResult>> completedResults;
+    std::chrono::steady_clock::time_point batchStartTime;   // sheets/s gauge since start()
+    ResultCallback resultCallback;
+
+    void enqueue(SheetJob job);
+    void workerLoop(OCREnginePool::Lease engine);
+    void stopWorkers();
+
+    BatchGrader(const BatchGrader&) = delete;
+    BatchGrader& operator=(const BatchGrader&) = delete;
+};
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef BUBBLE_FILL_KERNEL_H
+#define BUBBLE_FILL_KERNEL_H
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Sabit yerleşimdeki çok sayıda balonu tek çağrıda skorlar. Her yarıçap için iç disk ve
+ * arka plan halkası, vektör genişliğine yuvarlanmış 0x00/0xFF bit maskeleri olarak bir kez
+ * hazırlanır; koyu piksel sayımı OpenCV universal intrinsics (cv::v_uint8) ile yapılır,
+ * böylece SSE/AVX2/NEON aynı kaynaktan derlenir. Kağıt kenarına taşan balonlar skaler
+ * yoldan sayılır; iki yol bit düzeyinde aynı sonucu verir.
+ */
+class BubbleFillKernel {
+public:
+    // Per-lane u8 accumulators hold up to 255 rows between flushes
+    static constexpr int MAX_RADIUS = 127;
+
+    BubbleFillKernel();
+
+    int registerMask(int innerRadius, int annulusInnerRadius, int annulusOuterRadius);
+    void clear();
+    size_t getMaskCount() const;
+
+    // Ink = gray <= darkThreshold (same rule as THRESH_BINARY_INV)
+    void scoreBatch(const cv::Mat& gray, int darkThreshold,
+                    const cv::Point* centers, const int* maskIds, size_t count,
+                    double* fills, double* backgrounds) const;
+    void scoreBatchScalar(const cv::Mat& gray, int darkThreshold,
+                          const cv::Point* centers, const int* maskIds, size_t count,
+                          double* fills, double* backgrounds) const;
+
+    static bool isVectorized();
+    static int getVectorWidth();
+
+private:
+    // Square window of side 2*radius+1, rows padded to 'stride' bytes
+    struct BitMask {
+        int radius;
+        int stride;
+        int area;
+        std::vector<uchar> bits;
+    };
+
+    struct MaskPair {
+        BitMask disc;
+        BitMask ring;
+    };
+
+    std::vector<MaskPair> masks;
+
+    static BitMask buildMask(int outerRadius, int holeRadius);
+    static int countDarkScalar(const cv::Mat& gray, int darkThreshold, const cv::Point& center,
+                               const BitMask& mask, int& area);
+    static bool fitsVectorWindow(const cv::Mat& gray, const cv::Point& center, const BitMask& mask);
+    static int countDarkVector(const cv::Mat& gray, int darkThreshold, const cv::Point& center,
+                               const BitMask& mask);
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef BUBBLE_SAMPLER_H
+#define BUBBLE_SAMPLER_H
+
+#include "BubbleScoringContext.h"
+#include "SheetStructureAnalyzer.h"
+#include "SheetTemplate.h"
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * Düzeltilmiş (850x1100) kağıtta balon konumları yerleşimden bellidir; HoughCircles ile
+ * yeniden aramak yerine merkez/yarıçap tablosu bir kez hesaplanır; doluluk ve arka plan
+ * kontrastı BubbleScoringContext ile tek toplu çağrıda (SIMD maske) ölçülür. Deterministiktir;
+ * yerleşim kurulduktan sonra sample() aynı boyuttaki kağıtlar için bellek ayırmaz.
+ */
+class BubbleSampler {
+public:
+    explicit BubbleSampler(double fillThreshold = 0.6, double minContrast = 0.3);
+
+    // Same geometry the Hough path assumes: equal slices, centered, radius = min(w, h) / 3
+    static void computeBubbleGeometry(const cv::Rect& questionRegion, int numOptions,
+                                      std::vector<cv::Point>& centers, int& radius);
+
+    // Regions carrying a layoutIndex take their bubbles from the compiled template tables
+    void setLayout(const std::vector<QuestionRegion>& regions, const SheetTemplate* sheetTemplate = nullptr);
+    bool matchesLayout(const std::vector<QuestionRegion>& regions) const;
+    bool hasLayout() const;
+
+    void sample(const cv::Mat& sheet);
+    void sample(SheetContext& sheet);
+    int getMarkedAnswer(size_t regionIndex) const;
+    int getMarkCount(size_t regionIndex) const;     // tells "blank" from "multiple" when getMarkedAnswer is -1
+    double getFillPercentage(size_t regionIndex, int option) const;
+    BubbleScore getBubbleScore(size_t regionIndex, int option) const;
+    const BubbleScoringContext& getScoringContext() const;
+    void setScoringMethod(BubbleScoringContext::ScoringMethod method);
+    size_t getBubbleCount() const;
+
+    void setFillThreshold(double threshold);
+
+private:
+    struct QuestionSlot {
+        size_t firstBubble;
+        int numOptions;
+    };
+
+    double fillThreshold;
+    double minContrast;             // fill must exceed the surrounding paper by this much
+
+    std::vector<cv::Rect> layoutRegions;
+    std::vector<int> layoutOptions;
+    std::vector<int> layoutIndices;
+    std::vector<int> regionSlots;           // region index -> slot, -1 if no bubbles
+    std::vector<QuestionSlot> slots;
+    std::vector<cv::Point> bubbleCenters;
+    std::vector<int> bubbleMasks;           // bubble -> scoring context mask id
+    std::vector<BubbleScore> bubbleScores;
+
+    BubbleScoringContext scoringContext;
+
+    const BubbleScore* findScore(size_t regionIndex, int option) const;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef BUBBLE_SCORING_CONTEXT_H
+#define BUBBLE_SCORING_CONTEXT_H
+
+#include "BubbleFillKernel.h"
+#include "SheetContext.h"
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+struct BubbleScore {
+    double fill;            // iç diskteki mürekkep oranı
+    double background;      // balonun dışındaki halkadaki mürekkep oranı
+    double contrast;        // fill - background
+
+    BubbleScore() : fill(0.0), background(0.0), contrast(0.0) {}
+};
+
+/**
+ * Kağıt başına bir kez: gri -> Otsu eşiği (SheetContext'ten). İki skor yolu aynı sonucu verir:
+ *   - INTEGRAL_LOOKUP: mürekkep (0/1) integral görüntüsü; disk ve halka satır bantlarına
+ *     ayrılmıştır, bir balonun skoru bant başına dört okumadır.
+ *   - SIMD_MASK: integral kurulmaz; tüm balonlar BubbleFillKernel ile bit maskesi altında
+ *     vektörel sayılır. Sabit yerleşimli yoğun kağıtlarda varsayılan yoldur.
+ * inkRatio ve tekil score() gerektiğinde integrali SheetContext'ten tembel olarak alır.
+ */
+class BubbleScoringContext {
+public:
+    enum ScoringMethod {
+        INTEGRAL_LOOKUP,
+        SIMD_MASK
+    };
+
+    explicit BubbleScoringContext(double innerRadiusRatio = 0.8,
+                                  double annulusInnerRatio = 1.2,
+                                  double annulusOuterRatio = 1.5);
+
+    int registerRadius(int bubbleRadius);
+    void clearRadii();
+
+    void setMethod(ScoringMethod method);
+    ScoringMethod getMethod() const;
+
+    // The sheet (or context) must stay alive until scoring of this sheet is done
+    void prepare(const cv::Mat& sheet);
+    void prepare(SheetContext& sheet);
+    bool isPrepared() const;
+
+    BubbleScore score(const cv::Point& center, int maskId) const;
+    void scoreBatch(const std::vector<cv::Point>& centers, const std::vector<int>& maskIds,
+                    std::vector<BubbleScore>& scores) const;
+    double inkRatio(const cv::Rect& rect) const;
+    int getInkThreshold() const;
+
+private:
+    // Rows [dyStart, dyEnd] of a disc that share the same half width
+    struct Band {
+        int dyStart;
+        int dyEnd;
+        int halfWidth;
+    };
+
+    struct RadiusMasks {
+        int bubbleRadius;
+        std::vector<Band> innerDisc;
+        std::vector<Band> annulusInner;
+        std::vector<Band> annulusOuter;
+    };
+
+    double innerRadiusRatio;
+    double annulusInnerRatio;
+    double annulusOuterRatio;
+
+    ScoringMethod method;
+    std::vector<RadiusMasks> masks;
+    BubbleFillKernel fillKernel;
+
+    SheetContext localContext;
+    SheetContext* source;
+    cv::Mat grayView;
+    mutable cv::Mat integralInk;
+    mutable std::vector<double> fillBuffer;
+    mutable std::vector<double> backgroundBuffer;
+    int inkThreshold;
+
+    static std::vector<Band> buildDiscBands(int radius);
+    void ensureIntegral() const;
+    long long sumBands(const cv::Point& center, const std::vector<Band>& bands, long long& area) const;
+    long long sumRect(int x0, int y0, int x1, int y1) const;
+};
+
+#endif
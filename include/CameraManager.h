@@ -1,27 +1,90 @@
 #ifndef CAMERA_MANAGER_H
 #define CAMERA_MANAGER_H
 
+#include "FrameSource.h"
 #include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <thread>
+
+struct FrameInfo {
+    uint64_t sequence;                                  // grabber'ın kare numarası (1'den başlar)
+    std::chrono::steady_clock::time_point timestamp;    // yakalama anı
+
+    FrameInfo() : sequence(0) {}
+};
+
+struct CameraStats {
+    uint64_t grabbedFrames;     // kameradan okunan
+    uint64_t deliveredFrames;   // getLatestFrame ile verilen
+    uint64_t droppedFrames;     // okunmadan yerine yenisi yazılan
+    uint64_t failedReads;
+
+    CameraStats() : grabbedFrames(0), deliveredFrames(0), droppedFrames(0), failedReads(0) {}
+};
 
 class CameraManager {
 public:
     CameraManager();
     ~CameraManager();
-    
+
     bool initCamera(int deviceId = 0);
+    // Any FrameSource: device, recorded video or image directory (replay)
+    bool openSource(std::unique_ptr<FrameSource> frameSource);
     cv::Mat captureFrame();
     bool isReady() const;
+    // A recording reached its end and every grabbed frame was handed out
+    bool isFinished() const;
+    const FrameSource* getSource() const;
     void releaseCamera();
     bool setResolution(int width, int height);
     bool setFPS(int fps);
 
+    // Background grabber: capture never waits for processing, processing always gets the newest frame
+    bool startGrabber();
+    void stopGrabber();
+    bool isGrabbing() const;
+    // Non-blocking; false if no frame arrived since the last call. The frame is a view into
+    // the triple buffer and stays valid until the next getLatestFrame call.
+    bool getLatestFrame(cv::Mat& frame, FrameInfo* info = nullptr);
+    // Without the grabber: every frame in order, blocking; false at the end of a recording
+    bool readNextFrame(cv::Mat& frame, FrameInfo* info = nullptr);
+    CameraStats getStats() const;
+
 private:
-    cv::VideoCapture camera;
+    struct FrameSlot {
+        cv::Mat image;
+        FrameInfo info;
+    };
+
+    // Index of the shared slot in the low bits, FRESH_FLAG when it holds an unread frame
+    static const uint8_t FRESH_FLAG = 0x4;
+    static const uint8_t INDEX_MASK = 0x3;
+
+    std::unique_ptr<FrameSource> source;
     bool isInitialized;
     int currentDeviceId;
-    
+    uint64_t readSequence;
+
+    // Triple buffer: the writer owns writeIndex, the reader readIndex, the third is shared
+    FrameSlot slots[3];
+    std::atomic<uint8_t> sharedSlot;
+    uint8_t writeIndex;
+    uint8_t readIndex;
+
+    std::thread grabberThread;
+    std::atomic<bool> grabbing;
+    std::atomic<bool> sourceFinished;
+    std::atomic<uint64_t> grabbedFrames;
+    std::atomic<uint64_t> deliveredFrames;
+    std::atomic<uint64_t> droppedFrames;
+    std::atomic<uint64_t> failedReads;
+
+    void grabberLoop();
+
     CameraManager(const CameraManager&) = delete;
     CameraManager& operator=(const CameraManager&) = delete;
 };
@@ -0,0 +1,58 @@
+#ifndef COMPILED_ANSWER_KEY_H
+#define COMPILED_ANSWER_KEY_H
+
+#include "AnswerKey.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * AnswerKey'in puanlama için derlenmiş, salt okunur biçimi. Bir kez kurulur ve değiştirilmez;
+ * bu yüzden shared_ptr<const> ile worker thread'ler arasında kilitsiz paylaşılabilir.
+ *
+ * Sorular indeksle (soru numarası - 1, AnswerMatrix sütunuyla aynı) yoğun dizilerde tutulur:
+ * tür etiketi, seçenek, AnswerMatrix kodu ve kırpılmış / küçük harfe çevrilmiş yazı cevabı.
+ * Sorgular ve matches() bellek ayırmaz.
+ */
+class CompiledAnswerKey {
+public:
+    static constexpr uint8_t NO_ANSWER = 0xFF;     // type tag of a question missing from the key
+
+    explicit CompiledAnswerKey(const AnswerKey& answerKey);
+
+    static std::shared_ptr<const CompiledAnswerKey> compile(const AnswerKey& answerKey);
+
+    // Built from this revision of the source key; stale once the key is edited
+    uint64_t getRevision() const { return revision; }
+    bool isCurrent(const AnswerKey& answerKey) const { return answerKey.getRevision() == revision; }
+
+    size_t size() const { return types.size(); }    // highest question number in the key
+    int getAnswerCount() const { return answerCount; }
+
+    bool hasAnswer(size_t index) const { return index < types.size() && types[index] != NO_ANSWER; }
+    Answer::Type getType(size_t index) const { return static_cast<Answer::Type>(types[index]); }
+    int getSelectedOption(size_t index) const { return selectedOptions[index]; }
+    uint8_t getOptionCode(size_t index) const { return optionCodes[index]; }
+    const std::string& getText(size_t index) const { return texts[index]; }
+    const std::string& getFoldedText(size_t index) const { return foldedTexts[index]; }
+
+    // Same verdict as AnswerComparator::compareAnswer against this question, without copies
+    bool matches(size_t index, const Answer& studentAnswer, bool caseSensitive) const;
+    bool matchesText(size_t index, const std::string& studentText, bool caseSensitive) const;
+
+    Answer toAnswer(size_t index) const;
+
+private:
+    uint64_t revision;
+    int answerCount;
+
+    std::vector<uint8_t> types;
+    std::vector<int> selectedOptions;
+    std::vector<uint8_t> optionCodes;       // AnswerMatrix code a correct cell carries
+    std::vector<std::string> texts;         // as entered
+    std::vector<std::string> trimmedTexts;
+    std::vector<std::string> foldedTexts;   // trimmed and lower-cased
+};
+
+#endif
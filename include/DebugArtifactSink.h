@@ -0,0 +1,79 @@
+#ifndef DEBUG_ARTIFACT_SINK_H
+#define DEBUG_ARTIFACT_SINK_H
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * Hata ayıklama görüntüleri (OCR girişleri, ROI kırpıntıları) için tek çıkış noktası.
+ * Varsayılan seviye OFF'tur: isEnabled() tek bir atomik okumadır, klonlama veya disk
+ * erişimi yapılmaz. Açıkken görüntüler sınırlı bir kuyruğa alınır ve arka plandaki tek
+ * bir thread tarafından yazılır; kuyruk doluysa yeni görüntü düşürülür, çağıran beklemez.
+ *
+ * Seviye OMR_DEBUG_ARTIFACTS ortam değişkeni (off|basic|verbose) ile de seçilebilir.
+ */
+class DebugArtifactSink {
+public:
+    enum Level {
+        OFF = 0,
+        BASIC = 1,      // kağıt/soru başına kırpıntılar
+        VERBOSE = 2     // her OCR çağrısının girişi
+    };
+
+    static DebugArtifactSink& instance();
+
+    // Cheap guard for call sites: build filenames and crops only when this is true
+    static bool isEnabled(Level level) {
+        return level != OFF && activeLevel.load(std::memory_order_relaxed) >= level;
+    }
+
+    void configure(Level level, const std::string& outputDir = ".", size_t maxQueueSize = 64);
+    void configureFromEnvironment(Level defaultLevel = OFF);
+    static bool parseLevel(const std::string& text, Level& level);
+
+    void submit(Level level, const std::string& filename, const cv::Mat& image);
+    void flush();
+    void shutdown();
+
+    Level getLevel() const;
+    uint64_t getWrittenCount() const;
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Artifact {
+        std::string path;
+        cv::Mat image;
+    };
+
+    static std::atomic<int> activeLevel;
+
+    std::string outputDir;
+    size_t maxQueueSize;
+
+    std::thread writerThread;
+    std::deque<Artifact> pendingArtifacts;
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::condition_variable drainedCondition;
+    bool writing;
+    bool stopping;
+
+    std::atomic<uint64_t> writtenCount;
+    std::atomic<uint64_t> droppedCount;
+
+    DebugArtifactSink();
+    ~DebugArtifactSink();
+
+    void writerLoop();
+
+    DebugArtifactSink(const DebugArtifactSink&) = delete;
+    DebugArtifactSink& operator=(const DebugArtifactSink&) = delete;
+};
+
+#endif
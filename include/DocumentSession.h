@@ -0,0 +1,86 @@
+#ifndef DOCUMENT_SESSION_H
+#define DOCUMENT_SESSION_H
+
+#include <opencv2/opencv.hpp>
+#include <bitset>
+#include <cstddef>
+
+struct DocumentSessionConfig {
+    int thumbnailWidth;         // ölçümler bu genişlikte gri küçük resimde yapılır
+    double maxMotion;           // ardışık küçük resimler arası ortalama fark (gri seviye); altı = sabit
+    double rearmMotion;         // bu kadar hareket görülünce yeni kağıt beklenir
+    int settleFrames;           // çekim için art arda sabit kare sayısı
+    double minSharpness;        // küçük resimde Laplacian varyansı alt sınırı
+    int duplicateDistance;      // bu kadar bitten az farklı hash = muhtemelen aynı kağıt (yalnızca uyarı)
+
+    DocumentSessionConfig()
+        : thumbnailWidth(160), maxMotion(2.0), rearmMotion(6.0), settleFrames(5),
+          minSharpness(150.0), duplicateDistance(16) {}
+};
+
+struct SessionStats {
+    size_t frames;
+    size_t captured;
+    size_t suspectedDuplicates;     // çekildi, ama hash'i önceki kağıda çok yakın
+    size_t blurryFrames;            // sabit ama netlik sınırının altında
+
+    SessionStats() : frames(0), captured(0), suspectedDuplicates(0), blurryFrames(0) {}
+};
+
+/**
+ * Belge kamerası altında çevrilen kağıt destesi için otomatik çekim kararı.
+ * Her kare için yalnızca küçük bir gri resim üzerinde hareket (ardışık kare farkı) ve
+ * netlik (Laplacian varyansı) ölçülür. Kağıt yeterince uzun süre sabit ve net kalınca çekilir.
+ * Bir çekimden sonra yeni çekim için önce belirgin hareket (sayfa çevirme) görülmelidir;
+ * hareketten sonra sabitlenen her sayfa yeni kağıt sayılır. Küçük resimde kağıt birkaç on
+ * piksel kapladığından aynı şablondaki kağıtlar yalnızca işaretlerle ayırt edilemez: algısal
+ * hash (DCT) son çekilenle çok yakınsa çekim atlanmaz, yalnızca olası tekrar olarak işaretlenir.
+ */
+class DocumentSession {
+public:
+    enum Event {
+        MOVING,         // kağıt/el hareket ediyor
+        SETTLING,       // sabitleniyor, henüz yeterli kare yok
+        BLURRY,         // sabit ama net değil
+        CAPTURED,       // yeni kağıt: bu kare değerlendirilmeli (bkz. isSuspectedDuplicate)
+        IDLE            // bu kağıt zaten işlendi, hareket bekleniyor
+    };
+
+    using SheetHash = std::bitset<255>;
+
+    explicit DocumentSession(const DocumentSessionConfig& config = DocumentSessionConfig());
+
+    Event update(const cv::Mat& frame);
+    void reset();
+
+    double getSharpness() const;
+    double getMotion() const;
+    int getStableFrames() const;
+    // Last capture looked like the one before it; it is graded anyway, the caller may warn
+    bool isSuspectedDuplicate() const;
+    const SessionStats& getStats() const;
+
+    void drawOverlay(cv::Mat& frame, Event event) const;
+
+    static SheetHash perceptualHash(const cv::Mat& grayThumbnail);
+    static int hashDistance(const SheetHash& a, const SheetHash& b);
+
+private:
+    DocumentSessionConfig config;
+    SessionStats stats;
+
+    cv::Mat thumbnail;
+    cv::Mat previousThumbnail;
+    cv::Mat laplacian;
+    double sharpness;
+    double motion;
+    int stableFrames;
+    bool armed;             // false after a capture until the scene moves again
+    bool hasCapture;
+    bool suspectedDuplicate;
+    SheetHash lastCapturedHash;
+
+    void makeThumbnail(const cv::Mat& frame);
+};
+
+#endif
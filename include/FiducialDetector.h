@@ -0,0 +1,64 @@
+#ifndef FIDUCIAL_DETECTOR_H
+#define FIDUCIAL_DETECTOR_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+struct FiducialConfig {
+    int searchLongSide;             // kaba arama görüntüsünün uzun kenarı (px)
+    double cornerWindowFraction;    // köşe penceresi = görüntü boyutunun bu oranı
+    double minMarkerFraction;       // işaretçi kenarı / pencere kenarı alt sınırı
+    double maxMarkerFraction;       // ... üst sınırı
+    double minExtent;               // kontur alanı / sınır kutusu alanı (kare ~1.0, daire ~0.785)
+    double minInkRatio;             // kutudaki mürekkep oranı (dolu kare ~1, hedef ~0.5, boş balon ~0.2)
+    double minAspectRatio;          // kısa kenar / uzun kenar (perspektif kısalmasına pay)
+    double minQuadAreaFraction;     // dört merkezin oluşturduğu alan / görüntü alanı
+    double maxDiscRectangularity;   // kontur alanı / döndürülmüş en küçük kutu; altı = yuvarlak (daire ~0.785)
+    double maxDiscFill;             // yuvarlak adayda mürekkep / kontur alanı; üstü = dolu balon, işaretçi değil
+    double maxMarkerSizeRatio;      // en büyük / en küçük işaretçi kenarı
+    double maxQuadAspectError;      // dörtgen en-boy oranının beklenenden bağıl sapması
+
+    FiducialConfig()
+        : searchLongSide(640), cornerWindowFraction(0.4), minMarkerFraction(0.03),
+          maxMarkerFraction(0.5), minExtent(0.6), minInkRatio(0.4), minAspectRatio(0.5),
+          minQuadAreaFraction(0.15), maxDiscRectangularity(0.88), maxDiscFill(0.95),
+          maxMarkerSizeRatio(2.0), maxQuadAspectError(0.3) {}
+};
+
+/**
+ * Kağıdın dört köşesine basılmış koyu işaretçileri (dolu kare veya iç içe hedef) bulur.
+ * Arama küçültülmüş gri görüntüde yalnızca dört köşe penceresinde yapılır; bulunan aday
+ * tam çözünürlükte küçük bir ROI içinde ağırlık merkezine göre inceltilir. Tam kare Canny /
+ * findContours gerekmez; kağıt kenarı masaya karşı görünmese de çalışır.
+ *
+ * İşaretçisiz kağıtta dolu cevap balonları da koyu ve yuvarlaktır: dolu daireler aday
+ * sayılmaz, dört işaretçi benzer boyutta olmalı ve merkezleri şablondaki işaretçi
+ * dörtgeninin en-boy oranına uymalıdır.
+ */
+class FiducialDetector {
+public:
+    explicit FiducialDetector(const FiducialConfig& config = FiducialConfig());
+
+    // Marker centers in full-resolution pixels, ordered TL, TR, BR, BL. expectedAspect is the
+    // width / height of the marker quad on the corrected sheet; 0 skips that check.
+    bool detectMarkers(const cv::Mat& image, std::vector<cv::Point2f>& centers, double expectedAspect = 0.0);
+
+    void setConfig(const FiducialConfig& config);
+    const FiducialConfig& getConfig() const;
+
+private:
+    FiducialConfig config;
+
+    cv::Mat grayBuffer;
+    cv::Mat smallBuffer;
+    cv::Mat windowBinary;
+    cv::Mat refineBinary;
+
+    bool findMarkerInWindow(const cv::Mat& small, const cv::Rect& window, const cv::Point2f& outerCorner,
+                            cv::Rect& markerBox);
+    bool refineMarker(const cv::Mat& gray, const cv::Rect& searchBox, cv::Point2f& center);
+    bool isPlausibleQuad(const std::vector<cv::Point2f>& centers, const std::vector<double>& markerSides,
+                         const cv::Size& imageSize, double expectedAspect) const;
+};
+
+#endif
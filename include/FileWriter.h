@@ -2,8 +2,10 @@
 #define FILE_WRITER_H
 
 #include "ScoreCalculator.h"
+#include "SheetResult.h"
 #include <opencv2/opencv.hpp>
 #include <string>
+#include <vector>
 
 class FileWriter {
 public:
@@ -11,6 +13,7 @@ public:
     
     bool saveResultsToText(const std::string& filename, const ExamScore& score, const std::string& studentName = "", const std::string& examName = "") const;
     bool saveResultsToCSV(const std::string& filename, const ExamScore& score, const std::string& studentName = "") const;
+    bool saveBatchResultsToCSV(const std::string& filename, const std::vector<SheetResult>& results) const;
     bool saveResultImage(const std::string& filename, const cv::Mat& image) const;
     std::string createTimestampedFilename(const std::string& prefix, const std::string& extension) const;
 
@@ -0,0 +1,121 @@
+#ifndef FRAME_SOURCE_H
+#define FRAME_SOURCE_H
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Kare kaynağı: kamera, video dosyası veya görüntü klasörü. Kayıtlı kaynaklar gerçek
+ * zamanlı (kaydın FPS'i ile) ya da olabildiğince hızlı oynatılabilir; böylece kamera
+ * işlem hattı webcam olmadan, başsız bir makinede tekrarlanabilir biçimde ölçülebilir.
+ */
+class FrameSource {
+public:
+    enum Pacing {
+        REALTIME,       // kayıtlar kendi FPS'inde gelir (kamera her zaman gerçek zamanlı)
+        AS_FAST_AS_POSSIBLE
+    };
+
+    virtual ~FrameSource();
+
+    // "0", "1": device id; a directory: image sequence; anything else: video file
+    static std::unique_ptr<FrameSource> create(const std::string& spec, Pacing pacing = REALTIME);
+    static bool parsePacing(const std::string& name, Pacing& pacing);
+
+    virtual bool open() = 0;
+    virtual bool isOpened() const = 0;
+    // false on end of stream or read error; isFinished() tells them apart
+    bool read(cv::Mat& frame);
+    virtual void release() = 0;
+
+    virtual bool isLive() const = 0;
+    virtual bool isFinished() const;
+    virtual bool set(int propertyId, double value);
+    virtual double get(int propertyId) const = 0;
+    virtual std::string describe() const = 0;
+
+    Pacing getPacing() const;
+    size_t getFramesRead() const;
+
+protected:
+    explicit FrameSource(Pacing pacing);
+
+    virtual bool readFrame(cv::Mat& frame) = 0;
+    void resetPacing();
+
+    bool finished;
+
+private:
+    Pacing pacing;
+    size_t framesRead;
+    std::chrono::steady_clock::time_point replayStart;
+
+    FrameSource(const FrameSource&) = delete;
+    FrameSource& operator=(const FrameSource&) = delete;
+};
+
+class DeviceFrameSource : public FrameSource {
+public:
+    explicit DeviceFrameSource(int deviceId);
+
+    bool open() override;
+    bool isOpened() const override;
+    void release() override;
+    bool isLive() const override;
+    bool set(int propertyId, double value) override;
+    double get(int propertyId) const override;
+    std::string describe() const override;
+
+protected:
+    bool readFrame(cv::Mat& frame) override;
+
+private:
+    int deviceId;
+    cv::VideoCapture capture;
+};
+
+class VideoFileFrameSource : public FrameSource {
+public:
+    VideoFileFrameSource(const std::string& path, Pacing pacing);
+
+    bool open() override;
+    bool isOpened() const override;
+    void release() override;
+    bool isLive() const override;
+    double get(int propertyId) const override;
+    std::string describe() const override;
+
+protected:
+    bool readFrame(cv::Mat& frame) override;
+
+private:
+    std::string path;
+    cv::VideoCapture capture;
+};
+
+class ImageSequenceFrameSource : public FrameSource {
+public:
+    ImageSequenceFrameSource(const std::string& directory, Pacing pacing, double fps = 30.0);
+
+    bool open() override;
+    bool isOpened() const override;
+    void release() override;
+    bool isLive() const override;
+    double get(int propertyId) const override;
+    std::string describe() const override;
+
+protected:
+    bool readFrame(cv::Mat& frame) override;
+
+private:
+    std::string directory;
+    double fps;
+    std::vector<std::string> paths;
+    size_t nextIndex;
+    cv::Size frameSize;
+};
+
+#endif
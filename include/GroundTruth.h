@@ -0,0 +1,66 @@
+#ifndef GROUND_TRUTH_H
+#define GROUND_TRUTH_H
+
+#include "AnswerKey.h"
+#include "AnswerComparator.h"
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+struct SheetResult;
+
+struct AccuracyStats {
+    size_t sheetsEvaluated;
+    size_t sheetsFailed;            // ground truth exists but grading failed (e.g. no registration)
+    size_t sheetsWithoutTruth;
+    size_t perfectSheets;
+
+    size_t bubbleQuestions;         // MC + TF
+    size_t bubbleCorrect;
+    size_t missedMarks;             // marked on the sheet, read as blank
+    size_t falseMarks;              // blank on the sheet, read as marked
+    size_t textQuestions;
+    size_t textExact;
+    double textSimilaritySum;
+
+    AccuracyStats()
+        : sheetsEvaluated(0), sheetsFailed(0), sheetsWithoutTruth(0), perfectSheets(0),
+          bubbleQuestions(0), bubbleCorrect(0), missedMarks(0), falseMarks(0),
+          textQuestions(0), textExact(0), textSimilaritySum(0.0) {}
+
+    double bubbleAccuracy() const;
+    double textAccuracy() const;
+    double meanTextSimilarity() const;
+};
+
+/**
+ * Sentetik kağıtların gerçek cevapları. Dosya cevap anahtarı biçimini kağıt adıyla genişletir:
+ * "sheet,questionNum,type,answer" (ör. "sheet_000001.jpg,1,MC,2"); boş bırakılan soruda
+ * cevap alanı boştur. Kağıtlar dosya adıyla eşleşir, klasör yolu önemsizdir.
+ */
+class GroundTruth {
+public:
+    GroundTruth();
+
+    static void writeHeader(std::ostream& out);
+    static void writeSheet(std::ostream& out, const std::string& sheetId, const std::vector<Answer>& answers);
+
+    bool loadFromFile(const std::string& filename);
+    const std::vector<Answer>* find(const std::string& sheetId) const;
+    size_t getSheetCount() const;
+
+    AccuracyStats evaluate(const std::vector<SheetResult>& results, const AnswerComparator& comparator) const;
+
+    // Adds one successfully read sheet; answers are matched by (type, question number) since
+    // templates may restart numbering per block
+    void evaluateSheet(const std::string& sheetId, const std::vector<Answer>& readAnswers,
+                       const AnswerComparator& comparator, AccuracyStats& stats) const;
+
+private:
+    std::map<std::string, std::vector<Answer>> sheets;
+
+    static std::string sheetKey(const std::string& sheetId);
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef HANDWRITING_DETECTOR_H
 #define HANDWRITING_DETECTOR_H
 
+#include "SheetContext.h"
 #include <opencv2/opencv.hpp>
 
 class HandwritingDetector {
@@ -8,17 +9,22 @@ public:
     explicit HandwritingDetector(double minDensity = 0.05);
     
     bool hasHandwriting(const cv::Mat& image, const cv::Rect& region);
+    bool hasHandwriting(SheetContext& sheet, const cv::Rect& region);
     cv::Mat extractHandwritingROI(const cv::Mat& image, const cv::Rect& region);
+    cv::Mat extractHandwritingROI(SheetContext& sheet, const cv::Rect& region);
     double calculatePixelDensity(const cv::Mat& roi);
     void setMinDensity(double density);
     std::vector<cv::Rect> detectHandwritingRegions(const cv::Mat& image, const std::vector<cv::Rect>& searchRegions);
     double detectHandwritingConfidence(const cv::Mat& image, const cv::Rect& region);
+    double detectHandwritingConfidence(SheetContext& sheet, const cv::Rect& region);
 
 private:
     double minimumPixelDensity;
     cv::Mat preprocessingKernel;
+    cv::Mat openedBuffer;
     
-    cv::Mat preprocessForDetection(const cv::Mat& roi);
+    static bool isInside(const cv::Size& size, const cv::Rect& region);
+    cv::Mat preprocessForDetection(SheetContext& sheet, const cv::Rect& region);
     double analyzePixelDensity(const cv::Mat& roi);
     int countEdgePixels(const cv::Mat& roi);
     bool hasConnectedComponents(const cv::Mat& roi);
@@ -1,6 +1,7 @@
 #ifndef IMAGE_ENHANCER_H
 #define IMAGE_ENHANCER_H
 
+#include "SheetContext.h"
 #include <opencv2/opencv.hpp>
 
 class ImageEnhancer {
@@ -13,11 +14,14 @@ public:
     cv::Mat enhanceContrast(const cv::Mat& image, double clipLimit = 2.0, int tileSize = 8);
     cv::Mat sharpenImage(const cv::Mat& image);
     cv::Mat preprocessForOCR(const cv::Mat& image);
+    cv::Mat preprocessForOCR(SheetContext& sheet, const cv::Rect& region);
     cv::Mat preprocessForBubbles(const cv::Mat& image);
+    cv::Mat preprocessForBubbles(SheetContext& sheet);
 
 private:
     cv::Ptr<cv::CLAHE> clahe;
     cv::Mat convertToGray(const cv::Mat& image);
+    cv::Mat preprocessGrayForOCR(const cv::Mat& gray);
 };
 
 #endif
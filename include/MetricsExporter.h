@@ -0,0 +1,51 @@
+#ifndef METRICS_EXPORTER_H
+#define METRICS_EXPORTER_H
+
+#include "MetricsRegistry.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * MetricsRegistry'yi dışarı açar: 127.0.0.1 üzerinde Prometheus metin uç noktası
+ * (GET /metrics) ve/veya belirli aralıklarla bir dosyaya döküm. Her ikisi de kendi
+ * arka plan thread'inde çalışır; değerlendirme thread'leri hiç beklemez.
+ */
+class MetricsExporter {
+public:
+    explicit MetricsExporter(MetricsRegistry& registry = MetricsRegistry::instance());
+    ~MetricsExporter();
+
+    // Listens on localhost only; not available on Windows
+    bool startHttp(int port);
+
+    // Rewrites the file every intervalSeconds and once more on stop()
+    bool startFileDump(const std::string& filename, double intervalSeconds);
+
+    void stop();
+
+private:
+    MetricsRegistry& registry;
+
+    std::thread httpThread;
+    int listenSocket;
+
+    std::thread fileThread;
+    std::string dumpFilename;
+    double dumpIntervalSeconds;
+
+    std::atomic<bool> stopping;
+    std::mutex stopMutex;
+    std::condition_variable stopCondition;
+
+    void httpLoop();
+    void serveClient(int clientSocket);
+    void fileLoop();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Counter {
+public:
+    void increment(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value{0};
+};
+
+class Gauge {
+public:
+    void set(double newValue) { value.store(newValue, std::memory_order_relaxed); }
+    void add(double delta);
+    double get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value{0.0};
+};
+
+/**
+ * Sabit kovalı histogram. observe() tek bir kova sayacını, toplam sayıyı ve toplamı atomik
+ * olarak günceller; kilit yoktur. Kovalar Prometheus'a kümülatif olarak yazılır.
+ */
+class Histogram {
+public:
+    explicit Histogram(const std::vector<double>& upperBounds);
+
+    void observe(double value);
+
+    const std::vector<double>& getUpperBounds() const;
+    uint64_t getBucketCount(size_t index) const;    // not cumulative; index == bounds.size() is +Inf
+    uint64_t getCount() const;
+    double getSum() const;
+
+    static std::vector<double> latencyBuckets();    // seconds, 0.5 ms .. 10 s
+    static std::vector<double> linearBuckets(double start, double width, int count);
+
+private:
+    std::vector<double> upperBounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    std::atomic<uint64_t> count{0};
+    Gauge sum;
+};
+
+// Observes the scope's duration in seconds
+class ScopedLatency {
+public:
+    explicit ScopedLatency(Histogram& histogram)
+        : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency() {
+        histogram.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+private:
+    Histogram& histogram;
+    std::chrono::steady_clock::time_point start;
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+};
+
+/**
+ * Uzun süren toplu / servis değerlendirmesi için metrik kaydı (sayaç, gösterge, histogram).
+ * Kayıt bir kez kilitle yapılır ve kalıcı bir referans döner; güncellemeler yalnızca atomik
+ * işlemdir. Sıcak yolda referans statik yerelde tutulur:
+ *
+ *   static Histogram& latency = MetricsRegistry::instance().stageLatency("ocr");
+ *   ScopedLatency timer(latency);
+ *
+ * Etiketler Prometheus biçiminde verilir: "stage=\"ocr\"".
+ */
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    // The same name and labels always return the same metric
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const std::vector<double>& upperBounds, const std::string& labels = "");
+
+    // omr_stage_duration_seconds{stage="..."}
+    Histogram& stageLatency(const std::string& stage);
+
+    std::string renderPrometheus() const;
+    bool writeToFile(const std::string& filename) const;
+
+private:
+    enum Kind { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Entry {
+        std::string name;
+        std::string help;
+        std::string labels;
+        Kind kind;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    MetricsRegistry();
+
+    Entry* find(const std::string& name, const std::string& labels, Kind kind);
+
+    mutable std::mutex registryMutex;
+    std::vector<std::unique_ptr<Entry>> entries;    // registration order; never erased
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef OCR_ENGINE_POOL_H
+#define OCR_ENGINE_POOL_H
+
+#include "OCRProcessor.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct OCREngineConfig {
+    std::string language;
+    std::string dataPath;               // boş = Tesseract varsayılanı
+    tesseract::PageSegMode pageSegMode;
+    std::string charWhitelist;          // boş = kısıtlama yok
+
+    OCREngineConfig() : language("tur"), pageSegMode(tesseract::PSM_SINGLE_LINE),
+                        charWhitelist(OCRProcessor::DEFAULT_CHAR_WHITELIST) {}
+};
+
+struct OCRPoolStats {
+    size_t poolSize;
+    size_t inUse;
+    uint64_t checkouts;
+    uint64_t contendedCheckouts;        // had to wait for a free engine
+    uint64_t recognitions;              // recognizeText calls on pool engines
+    double totalWaitMs;
+    double maxWaitMs;
+    double averageWaitMs;
+    double utilization;                 // recognizeText time / (poolSize * uptime), however long leases are held
+    double warmupMs;
+
+    OCRPoolStats() : poolSize(0), inUse(0), checkouts(0), contendedCheckouts(0), recognitions(0),
+                     totalWaitMs(0.0), maxWaitMs(0.0), averageWaitMs(0.0),
+                     utilization(0.0), warmupMs(0.0) {}
+};
+
+/**
+ * Başlangıçta N adet Tesseract motorunu (dil, PSM, whitelist sabit) hazırlar ve
+ * thread'lere RAII Lease ile ödünç verir. Sıcak yolda Init maliyeti ödenmez.
+ * Kullanım oranı motorların recognizeText içinde geçirdiği süreden hesaplanır; worker'ın
+ * ömrü boyunca tutulan Lease motoru meşgul göstermez. Bekleme süreleri ödünç alma başınadır.
+ */
+class OCREnginePool {
+public:
+    class Lease {
+    public:
+        Lease();
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        OCRProcessor* operator->() const;
+        OCRProcessor& operator*() const;
+        explicit operator bool() const;
+        void release();
+
+    private:
+        friend class OCREnginePool;
+        Lease(OCREnginePool* pool, OCRProcessor* engine);
+
+        OCREnginePool* pool;
+        OCRProcessor* engine;
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+    };
+
+    explicit OCREnginePool(size_t poolSize, const OCREngineConfig& config = OCREngineConfig());
+
+    Lease checkout();
+    Lease tryCheckout(std::chrono::milliseconds timeout);
+    size_t size() const;
+    size_t available() const;
+    bool isInitialized() const;
+    const OCREngineConfig& getConfig() const;
+    OCRPoolStats getStats() const;
+    void printStats() const;
+
+private:
+    OCREngineConfig config;
+    std::vector<std::unique_ptr<OCRProcessor>> engines;
+    std::vector<OCRProcessor*> idleEngines;
+
+    mutable std::mutex poolMutex;
+    std::condition_variable engineAvailable;
+
+    std::chrono::steady_clock::time_point readyTime;
+    double warmupMs;
+    uint64_t checkoutCount;
+    uint64_t contendedCount;
+    double totalWaitMs;
+    double maxWaitMs;
+
+    Lease acquireLocked(std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::time_point requestTime);
+    void checkin(OCRProcessor* engine);
+
+    OCREnginePool(const OCREnginePool&) = delete;
+    OCREnginePool& operator=(const OCREnginePool&) = delete;
+};
+
+#endif
@@ -4,28 +4,46 @@
 #include <opencv2/opencv.hpp>
 #include <tesseract/baseapi.h>
 #include <allheaders.h>
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
 
 class OCRProcessor {
 public:
+    // How a cv::Mat reaches Tesseract: direct buffer hand-off or the legacy JPEG round trip
+    enum ImageTransferMode { IN_MEMORY, TEMP_FILE };
+    static const char* const DEFAULT_CHAR_WHITELIST;
+
     explicit OCRProcessor(const char* language = "tur", const char* dataPath = nullptr);
     ~OCRProcessor();
     
     std::string recognizeText(const cv::Mat& handwritingROI);
     cv::Mat preprocessForOCR(const cv::Mat& image);
     void setPageSegmentationMode(tesseract::PageSegMode mode);
+    void setCharWhitelist(const std::string& whitelist);
     float getConfidence() const;
     std::string recognizeTextWithConfidence(const cv::Mat& handwritingROI, float minConfidence = 50.0f);
     bool isInitialized() const;
+    void setImageTransferMode(ImageTransferMode mode);
+    ImageTransferMode getImageTransferMode() const;
+    // Only the hand-off recognizeText starts with (no recognition); lets benchmarks time it alone
+    bool transferImage(const cv::Mat& image);
+    // Time inside recognizeText; safe to read while another thread is recognizing
+    double getBusyMs() const;
+    uint64_t getRecognizeCount() const;
 
 private:
     tesseract::TessBaseAPI* tesseractAPI;
     bool initialized;
     float lastConfidence;
+    ImageTransferMode transferMode;
+    std::atomic<uint64_t> busyMicros;
+    std::atomic<uint64_t> recognizeCount;
     
     std::string postProcessText(const std::string& rawText);
     Pix* matToPix(const cv::Mat& image);
+    bool setTesseractImage(const cv::Mat& image, Pix** ownedPix);
     std::string trimText(const std::string& text);
     
     OCRProcessor(const OCRProcessor&) = delete;
@@ -1,11 +1,43 @@
 #ifndef PERSPECTIVE_CORRECTOR_H
 #define PERSPECTIVE_CORRECTOR_H
 
+#include "FiducialDetector.h"
 #include <opencv2/opencv.hpp>
 #include <vector>
 
+// detectPaperCorners aşama süreleri; seviye 0 = tam çözünürlük gri dönüşüm
+struct CornerDetectionTiming {
+    std::vector<cv::Size> levelSizes;
+    std::vector<double> levelMs;
+    double edgeMs;          // blur + Canny + dilate (üst seviyede)
+    double contourMs;       // findContours + dörtgen seçimi
+    double refineMs;        // tam çözünürlükte cornerSubPix
+    double totalMs;
+
+    CornerDetectionTiming() : edgeMs(0.0), contourMs(0.0), refineMs(0.0), totalMs(0.0) {}
+};
+
 class PerspectiveCorrector {
 public:
+    // AUTO: köşe işaretçileri, bulunamazsa kağıt konturu
+    enum RegistrationMode {
+        AUTO,
+        FIDUCIAL_ONLY,
+        CONTOUR_ONLY
+    };
+
+    enum RegistrationMethod {
+        NONE,
+        FIDUCIAL,
+        CONTOUR
+    };
+
+    // WARP_GRAY: düzeltilmiş kağıt tek kanal (kayıt sırasında üretilen gri görüntüden)
+    enum WarpMode {
+        WARP_COLOR,
+        WARP_GRAY
+    };
+
     explicit PerspectiveCorrector(double cannyThreshold1 = 50.0, double cannyThreshold2 = 150.0);
     
     std::vector<cv::Point2f> detectPaperCorners(const cv::Mat& image);
@@ -13,13 +45,56 @@ public:
     cv::Mat correctPerspective(const cv::Mat& image, int outputWidth = 850, int outputHeight = 1100);
     void setCannyThresholds(double threshold1, double threshold2);
 
+    // Image -> corrected sheet homography without warping (for SheetWarp / tracking)
+    bool registerSheet(const cv::Mat& image, cv::Mat& homography, int outputWidth = 850, int outputHeight = 1100);
+    // Gray of the last registerSheet input; valid until the next call (aliases 1-channel input)
+    const cv::Mat& getRegistrationGray() const;
+    void setWarpMode(WarpMode mode);
+    WarpMode getWarpMode() const;
+    void setVerbose(bool verbose);
+
+    // Marker centers -> (inset, inset), (w-1-inset, inset), ... of the corrected sheet; the quad
+    // must match that layout's aspect ratio
+    bool detectFiducialMarkers(const cv::Mat& image, std::vector<cv::Point2f>& centers,
+                               int outputWidth = 850, int outputHeight = 1100);
+    cv::Mat applyFiducialTransform(const cv::Mat& image, const std::vector<cv::Point2f>& centers, int outputWidth = 850, int outputHeight = 1100);
+
+    void setRegistrationMode(RegistrationMode mode);
+    RegistrationMode getRegistrationMode() const;
+    void setMarkerInset(float inset);
+    float getMarkerInset() const;
+    void setFiducialConfig(const FiducialConfig& config);
+    RegistrationMethod getLastMethod() const;
+    double getLastRegistrationMs() const;
+
+    // Corner search runs on the pyramid level whose long side is closest to this (0 = full resolution)
+    void setPyramidTargetSize(int targetSize);
+    void setSubPixelRefinement(bool enabled);
+    const CornerDetectionTiming& getLastCornerTiming() const;
+    void printCornerTiming() const;
+
 private:
     double cannyThreshold1;
     double cannyThreshold2;
+    RegistrationMode registrationMode;
+    float markerInset;
+    FiducialDetector fiducialDetector;
+    RegistrationMethod lastMethod;
+    double lastRegistrationMs;
+    int pyramidTargetSize;
+    bool subPixelRefinement;
+    CornerDetectionTiming lastCornerTiming;
+    WarpMode warpMode;
+    cv::Mat registrationGray;
+    bool verbose;
     
+    static std::vector<cv::Point2f> sheetCorners(int outputWidth, int outputHeight, float inset);
+    double markerQuadAspect(int outputWidth, int outputHeight) const;
+    cv::Mat warpToSheet(const cv::Mat& image, const cv::Mat& homography, int outputWidth, int outputHeight);
     std::vector<cv::Point2f> orderPoints(const std::vector<cv::Point2f>& points);
-    std::vector<cv::Point2f> findLargestQuadrilateral(const std::vector<std::vector<cv::Point>>& contours);
+    std::vector<cv::Point2f> findLargestQuadrilateral(const std::vector<std::vector<cv::Point>>& contours, double minArea = 10000.0);
     cv::Mat preprocessForEdgeDetection(const cv::Mat& image);
+    void refineCorners(const cv::Mat& gray, std::vector<cv::Point2f>& corners, int level);
 };
 
 #endif
@@ -0,0 +1,17 @@
+#ifndef QUESTION_REGION_H
+#define QUESTION_REGION_H
+
+#include <opencv2/opencv.hpp>
+
+struct QuestionRegion {
+    int questionNumber;
+    cv::Rect region;
+    enum Type { MULTIPLE_CHOICE, FILL_IN_BLANK, TRUE_FALSE } type;
+    int numOptions;
+    int layoutIndex;        // SheetTemplate tablosundaki satır, -1 = şablondan gelmiyor
+    
+    QuestionRegion(int num, const cv::Rect& rect, Type t, int options = 0, int layout = -1)
+        : questionNumber(num), region(rect), type(t), numOptions(options), layoutIndex(layout) {}
+};
+
+#endif
@@ -3,6 +3,10 @@
 
 #include "AnswerKey.h"
 #include "AnswerComparator.h"
+#include "AnswerMatrix.h"
+#include "CompiledAnswerKey.h"
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <map>
 
@@ -29,17 +33,44 @@ struct ExamScore {
                   unanswered(0), rawScore(0.0), percentageScore(0.0) {}
 };
 
+// Per-student totals from calculateScores; index = AnswerMatrix row
+struct BatchScores {
+    int totalQuestions;
+    double maxScore;
+    std::vector<uint16_t> correctAnswers;
+    std::vector<uint16_t> incorrectAnswers;
+    std::vector<uint16_t> unanswered;
+    std::vector<float> rawScore;
+    std::vector<float> percentageScore;
+
+    BatchScores() : totalQuestions(0), maxScore(0.0) {}
+    size_t size() const { return correctAnswers.size(); }
+};
+
 class ScoreCalculator {
 public:
     ScoreCalculator(const AnswerKey& answerKey, const AnswerComparator& comparator);
     
     ExamScore calculateScore(const std::vector<Answer>& studentAnswers);
+
+    // Share one compiled key between workers; without it (or once the key is edited) each
+    // calculator compiles its own on the next call
+    void setCompiledKey(std::shared_ptr<const CompiledAnswerKey> compiledKey);
     void setPointsPerQuestion(double points);
     void setQuestionPoints(int questionNum, double points);
     void setPartialCreditEnabled(bool enable);
     void setPartialCreditThreshold(double threshold);
     std::map<std::string, double> getStatistics(const ExamScore& score) const;
 
+    // Columnar scoring for whole classes. A blank cell counts as unanswered, several marks
+    // as incorrect; text cells carry an exact-match verdict, so partial credit is not applied.
+    // Text and type verdicts depend on the key: after a key edit calculateScores rejects the
+    // matrix (empty result) until it is resized and re-encoded; point changes need no re-encode.
+    // Both may run on several threads sharing one calculator while the key is not edited;
+    // calculateScore keeps per-call scratch and needs a calculator per thread.
+    void encodeAnswers(const std::vector<Answer>& studentAnswers, AnswerMatrix& matrix, size_t student) const;
+    BatchScores calculateScores(const AnswerMatrix& answers) const;
+
 private:
     const AnswerKey& answerKey;
     const AnswerComparator& comparator;
@@ -47,7 +78,10 @@ private:
     std::map<int, double> customPoints;
     bool partialCreditEnabled;
     double partialCreditThreshold;
-    
+    mutable std::shared_ptr<const CompiledAnswerKey> compiledKey;     // swapped with std::atomic_load/store
+    std::vector<const Answer*> studentSlots;    // calculateScore scratch: answer per question index
+
+    std::shared_ptr<const CompiledAnswerKey> currentKey() const;
     double getQuestionPoints(int questionNum) const;
     double calculatePartialCredit(const Answer& studentAns, const Answer& correctAns) const;
 };
@@ -0,0 +1,63 @@
+#ifndef SHEET_CONTEXT_H
+#define SHEET_CONTEXT_H
+
+#include <opencv2/opencv.hpp>
+#include <deque>
+
+/**
+ * Düzeltilmiş bir kağıdın ortak ön işleme önbelleği. Gri, bulanık, adaptif ikili, Otsu ikili
+ * ve mürekkep integral görüntüleri ilk istendiğinde bir kez hesaplanır; aynı kağıt üzerinde
+ * çalışan tüm dedektörler bu görüntüleri paylaşır. reset() tamponları korur, böylece aynı
+ * boyuttaki sonraki kağıtlar bellek ayırmaz. Thread-safe değildir: her worker kendi
+ * SheetContext'ini kullanır. Dönen referanslar bir sonraki reset()'e kadar geçerlidir.
+ */
+class SheetContext {
+public:
+    SheetContext();
+    explicit SheetContext(const cv::Mat& sheet);
+
+    void reset(const cv::Mat& sheet);
+    bool empty() const;
+
+    const cv::Mat& image() const;
+    cv::Size size() const;
+
+    const cv::Mat& gray();
+    const cv::Mat& blurred(int kernelSize = 3);
+    // Gaussian adaptive on blurred(3), ink = 255 (block 11, C 2)
+    const cv::Mat& adaptiveBinary();
+    // Global Otsu on gray, ink = 255
+    const cv::Mat& otsuBinary();
+    int otsuThreshold();
+    // CV_32S integral of the Otsu ink mask as 0/1, (rows+1)x(cols+1)
+    const cv::Mat& inkIntegral();
+
+    // Number of full-image passes done since the last reset()
+    int getComputeCount() const;
+
+private:
+    struct BlurEntry {
+        int kernelSize;
+        bool valid;
+        cv::Mat image;
+    };
+
+    cv::Mat sheet;
+
+    cv::Mat grayImage;      // own buffer, never aliases the caller's sheet
+    cv::Mat grayView;
+    cv::Mat adaptiveImage;
+    cv::Mat otsuImage;
+    cv::Mat inkMask;
+    cv::Mat integralImage;
+    std::deque<BlurEntry> blurs;     // deque: earlier references stay valid
+
+    bool hasGray;
+    bool hasAdaptive;
+    bool hasOtsu;
+    bool hasIntegral;
+    int otsuValue;
+    int computeCount;
+};
+
+#endif
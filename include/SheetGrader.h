@@ -0,0 +1,58 @@
+#ifndef SHEET_GRADER_H
+#define SHEET_GRADER_H
+
+#include "PerspectiveCorrector.h"
+#include "BubbleSampler.h"
+#include "HandwritingDetector.h"
+#include "OCRProcessor.h"
+#include "SheetStructureAnalyzer.h"
+#include "SheetContext.h"
+#include "SheetTemplate.h"
+#include "SheetWarp.h"
+#include "AnswerKey.h"
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * Tek bir sınav kağıdının görüntüden cevaplara kadar olan işlem hattı.
+ * Pencere açmaz; OCR motoru dışarıdan verilir (TessBaseAPI thread-safe değildir,
+ * her thread kendi OCRProcessor'ını kullanmalıdır).
+ */
+class SheetGrader {
+public:
+    explicit SheetGrader(OCRProcessor& ocrProcessor, double fillThreshold = 0.6, double minHandwritingDensity = 0.02);
+
+    bool loadTemplate(const std::string& filename);
+    void setTemplate(const SheetTemplate& sheetTemplate);
+
+    cv::Mat correctPerspective(const cv::Mat& image);
+    std::vector<QuestionRegion> analyzeStructure(const cv::Mat& correctedSheet);
+    std::vector<Answer> readAnswers(const cv::Mat& correctedSheet, const std::vector<QuestionRegion>& regions);
+    std::vector<Answer> processSheet(const cv::Mat& image);
+    cv::Mat visualizeRegions(const cv::Mat& correctedSheet, const std::vector<QuestionRegion>& regions);
+    void setVerbose(bool verbose);
+
+    // WARP_GRAY: one-channel corrected sheet; region warp: only template rows/boxes are warped
+    void setWarpMode(PerspectiveCorrector::WarpMode mode);
+    void setRegionWarp(bool enabled);
+
+private:
+    OCRProcessor& ocrProcessor;
+    PerspectiveCorrector perspectiveCorrector;
+    BubbleSampler bubbleSampler;
+    HandwritingDetector handwritingDetector;
+    SheetStructureAnalyzer sheetAnalyzer;
+    SheetContext sheetContext;      // per-sheet preprocessing cache, buffers reused
+    SheetWarp sheetWarp;
+    bool regionWarp;
+    bool verbose;
+
+    std::vector<Answer> processSheetRegions(const cv::Mat& image);
+    void applyTemplateRegistration();
+
+    SheetGrader(const SheetGrader&) = delete;
+    SheetGrader& operator=(const SheetGrader&) = delete;
+};
+
+#endif
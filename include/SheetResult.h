@@ -0,0 +1,21 @@
+#ifndef SHEET_RESULT_H
+#define SHEET_RESULT_H
+
+#include "AnswerKey.h"
+#include "ScoreCalculator.h"
+#include <string>
+#include <vector>
+
+// One graded sheet: BatchGrader output, read by FileWriter and GroundTruth without OCR headers
+struct SheetResult {
+    std::string sheetId;
+    bool success;
+    std::string errorMessage;
+    std::vector<Answer> studentAnswers;
+    ExamScore score;
+    double processingMs;
+
+    SheetResult() : success(false), processingMs(0.0) {}
+};
+
+#endif
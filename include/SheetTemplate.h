@@ -0,0 +1,107 @@
+#ifndef SHEET_TEMPLATE_H
+#define SHEET_TEMPLATE_H
+
+#include "QuestionRegion.h"
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Bir blok: aynı tipteki soruların rows x columns ızgarası. Sorular önce sütun boyunca
+ * (yukarıdan aşağı), sonra sağdaki sütuna geçerek numaralanır.
+ */
+struct TemplateBlock {
+    QuestionRegion::Type type;
+    int firstQuestion;
+    int rows;
+    int columns;
+    int x;
+    int y;
+    int width;              // tek sütunun genişliği; <= 0 ise sheetWidth - 2 * x
+    int rowHeight;
+    int rowSpacing;
+    int columnSpacing;
+    int options;            // MC seçenek sayısı (TF için 2, FILL için 0)
+    int bubbleRadius;       // 0 = otomatik: min(seçenek genişliği, yükseklik) / 3
+
+    TemplateBlock()
+        : type(QuestionRegion::MULTIPLE_CHOICE), firstQuestion(1), rows(0), columns(1),
+          x(0), y(0), width(0), rowHeight(0), rowSpacing(0), columnSpacing(0),
+          options(0), bubbleRadius(0) {}
+};
+
+/**
+ * Şablonun derlenmiş hali: bölge ve balon tabloları yapı-dizisi (SoA) olarak bitişik tutulur.
+ * Bölge i'nin balonları [firstBubble[i], firstBubble[i] + optionCount[i]) aralığındadır.
+ */
+struct CompiledSheetLayout {
+    std::vector<int> questionNumber;
+    std::vector<uint8_t> type;          // QuestionRegion::Type
+    std::vector<int> regionX;
+    std::vector<int> regionY;
+    std::vector<int> regionWidth;
+    std::vector<int> regionHeight;
+    std::vector<int> optionCount;
+    std::vector<int> firstBubble;
+
+    std::vector<int> bubbleX;
+    std::vector<int> bubbleY;
+    std::vector<int> bubbleRadius;
+
+    size_t regionCount() const { return questionNumber.size(); }
+    size_t bubbleCount() const { return bubbleX.size(); }
+    cv::Rect regionRect(size_t index) const {
+        return cv::Rect(regionX[index], regionY[index], regionWidth[index], regionHeight[index]);
+    }
+};
+
+/**
+ * Veri tabanlı sınav kağıdı yerleşimi. cv::FileStorage ile YAML/JSON'dan bir kez okunur ve
+ * CompiledSheetLayout tablolarına derlenir; kağıt başına analiz bu tabloların taranmasıdır.
+ * Yeni bir sınav düzeni için yeniden derleme gerekmez.
+ */
+class SheetTemplate {
+public:
+    SheetTemplate();
+
+    // Geometry SheetStructureAnalyzer used to hardcode: 10 MC + 5 FILL + 5 TF
+    static SheetTemplate createDefault(int sheetWidth = 850, int sheetHeight = 1100);
+
+    bool loadFromFile(const std::string& filename);
+    bool saveToFile(const std::string& filename) const;
+
+    void addBlock(const TemplateBlock& block);
+    void clear();
+
+    std::vector<QuestionRegion> buildRegions(const cv::Size& imageSize) const;
+
+    const std::string& getName() const;
+    void setName(const std::string& name);
+    int getSheetWidth() const;
+    int getSheetHeight() const;
+    void setSheetDimensions(int sheetHeight, int sheetWidth);
+    // Printed corner markers; without them registration goes straight to the paper outline
+    bool hasMarkers() const;
+    int getMarkerInset() const;
+    void setMarkers(bool markers, int markerInset);
+    const std::vector<TemplateBlock>& getBlocks() const;
+    const CompiledSheetLayout& getLayout() const;
+
+    static const char* typeName(QuestionRegion::Type type);
+    static bool parseType(const std::string& name, QuestionRegion::Type& type);
+
+private:
+    std::string name;
+    int sheetWidth;
+    int sheetHeight;
+    bool markers;
+    int markerInset;        // marker center to sheet corner, both axes
+    std::vector<TemplateBlock> blocks;
+    CompiledSheetLayout layout;
+
+    void compile();
+    bool validateBlock(const TemplateBlock& block, size_t index) const;
+};
+
+#endif
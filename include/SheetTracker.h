@@ -0,0 +1,75 @@
+#ifndef SHEET_TRACKER_H
+#define SHEET_TRACKER_H
+
+#include "PerspectiveCorrector.h"
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+struct SheetTrackerConfig {
+    cv::Size windowSize;            // LK pencere boyutu
+    int maxLevel;                   // LK piramit seviyesi
+    double maxForwardBackwardError; // ileri-geri izleme hatası sınırı (px)
+    double maxAreaChange;           // kareler arası dörtgen alan değişimi oranı
+    double stableMotion;            // bu kadar pikselden az hareket = sabit kare
+    int redetectInterval;           // bu kadar karede bir tam tespit (0 = yalnızca kayıpta)
+
+    SheetTrackerConfig()
+        : windowSize(21, 21), maxLevel(3), maxForwardBackwardError(1.5), maxAreaChange(0.3),
+          stableMotion(1.0), redetectInterval(90) {}
+};
+
+/**
+ * Kamera karelerinde kağıdın dört köşesini izler. Tam tespit (işaretçi / kontur) yalnızca
+ * başlangıçta, izleme kaybında ve seyrek aralıklarla yapılır; arada köşeler piramidal
+ * Lucas-Kanade optik akışı ile ileri-geri doğrulanarak taşınır. Önceki karenin piramidi
+ * saklanır, her kare için yalnızca bir piramit kurulur.
+ */
+class SheetTracker {
+public:
+    enum State {
+        LOST,
+        DETECTED,
+        TRACKING
+    };
+
+    explicit SheetTracker(int sheetWidth = 850, int sheetHeight = 1100,
+                          const SheetTrackerConfig& config = SheetTrackerConfig());
+
+    State update(const cv::Mat& frame);
+    void reset();
+
+    State getState() const;
+    bool hasSheet() const;
+    const std::vector<cv::Point2f>& getCorners() const;    // image TL, TR, BR, BL
+    cv::Mat getHomography() const;                          // image -> corrected sheet
+    int getStableFrames() const;
+    double getLastMotion() const;
+    double getLastUpdateMs() const;
+    PerspectiveCorrector& getCorrector();
+
+    void drawOverlay(cv::Mat& frame, int autoCaptureFrames = 0) const;
+
+private:
+    SheetTrackerConfig config;
+    PerspectiveCorrector corrector;
+    std::vector<cv::Point2f> sheetCorners;
+
+    State state;
+    std::vector<cv::Point2f> corners;
+    cv::Mat homography;
+    int framesSinceDetection;
+    int stableFrames;
+    double lastMotion;
+    double lastUpdateMs;
+
+    cv::Mat currentGray;
+    cv::Mat previousGray;
+    std::vector<cv::Mat> currentPyramid;
+    std::vector<cv::Mat> previousPyramid;
+
+    bool track(std::vector<cv::Point2f>& tracked);
+    bool detect(const cv::Mat& gray);
+    bool isPlausible(const std::vector<cv::Point2f>& quad, const cv::Size& frameSize) const;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef SHEET_WARP_H
+#define SHEET_WARP_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * Düzeltilmiş kağıdın yalnızca istenen dikdörtgenlerini üreten tembel perspektif dönüşümü.
+ * Her dikdörtgen için remap haritaları homografiden bir kez hesaplanır (sabit noktalı
+ * CV_16SC2) ve homografi değişmedikçe yeni kaynak karelerde yeniden kullanılır; pikseller
+ * ilk istendiğinde dönüştürülür. Şablon satırları ve yazı kutuları dışındaki alan hiç
+ * dönüştürülmez.
+ */
+class SheetWarp {
+public:
+    SheetWarp();
+
+    // imageToSheet: 3x3 homography from the source photo to the corrected sheet
+    void setHomography(const cv::Mat& imageToSheet, const cv::Size& sheetSize);
+    // New pixels for the same geometry: warped regions are dropped, maps are kept
+    void setSource(const cv::Mat& image);
+    void reset();
+
+    void precomputeMaps(const std::vector<cv::Rect>& sheetRects);
+    cv::Mat region(const cv::Rect& sheetRect);
+    // Sheet-sized image with only these rectangles warped; the rest is filled with their mean
+    cv::Mat renderRegions(const std::vector<cv::Rect>& sheetRects);
+
+    bool isReady() const;
+    const cv::Size& getSheetSize() const;
+    size_t getWarpedPixelCount() const;     // since the last setSource
+    size_t getMapBuildCount() const;        // since the last homography change
+
+private:
+    struct RegionMaps {
+        cv::Rect rect;
+        cv::Mat fixedMap;       // CV_16SC2 integer source coordinates
+        cv::Mat fractionMap;    // CV_16UC1 interpolation table indices
+    };
+
+    struct WarpedRegion {
+        cv::Rect rect;
+        cv::Mat pixels;
+    };
+
+    cv::Matx33d imageToSheet;
+    cv::Matx33d sheetToImage;
+    cv::Size sheetSize;
+    bool hasHomography;
+    cv::Mat source;
+
+    std::vector<RegionMaps> maps;
+    std::vector<WarpedRegion> warped;
+    size_t warpedPixelCount;
+    size_t mapBuildCount;
+
+    const RegionMaps& mapsFor(const cv::Rect& rect);
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+/**
+ * Aşama izleme: RAII kapsamlı süre aralıkları, thread başına halka tamponda tutulur ve
+ * Chrome / Perfetto iz dosyası (JSON) olarak yazılır (chrome://tracing, ui.perfetto.dev).
+ *
+ * Yalnızca -DOMR_ENABLE_TRACING=ON ile derlenir. Kapalıyken makrolar boş ifadeye açılır:
+ * argümanları değerlendirilmez, saat okunmaz, hiçbir kod üretilmez.
+ *
+ *   OMR_TRACE_SCOPE("BubbleSampler::sample");
+ *   OMR_TRACE_SCOPE_ARG("region", "question", region.questionNumber);
+ *   OMR_TRACE_THREAD_NAME("batch-worker");
+ *   OMR_TRACE_SESSION();     // main(): kapsam bitince OMR_TRACE_FILE'a (omr_trace.json) yazar
+ */
+
+#if OMR_ENABLE_TRACING
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct TraceEvent {
+    const char* name;       // string literal, stored by pointer
+    const char* argName;    // nullptr = no argument
+    int64_t arg;
+    int64_t startNs;
+    int64_t durationNs;
+};
+
+class Tracer {
+public:
+    // Per thread; when full the oldest spans are overwritten
+    static constexpr size_t RING_CAPACITY = 1 << 16;
+
+    static Tracer& instance();
+    static int64_t nowNs();
+
+    void record(const char* name, const char* argName, int64_t arg, int64_t startNs, int64_t endNs);
+    void setThreadName(const std::string& name);
+
+    // Call after the traced threads have stopped; a thread still recording may tear its oldest slot
+    bool writeChromeTrace(const std::string& filename, size_t* eventCount = nullptr, size_t* droppedCount = nullptr);
+
+private:
+    struct ThreadBuffer {
+        std::vector<TraceEvent> events;
+        std::atomic<uint64_t> written;
+        int threadId;
+        std::string threadName;
+
+        explicit ThreadBuffer(int threadId) : events(RING_CAPACITY), written(0), threadId(threadId) {}
+    };
+
+    Tracer();
+
+    ThreadBuffer& localBuffer();
+
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;     // outlive their threads
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* argName = nullptr, int64_t arg = 0)
+        : name(name), argName(argName), arg(arg), startNs(Tracer::nowNs()) {}
+    ~TraceScope() { Tracer::instance().record(name, argName, arg, startNs, Tracer::nowNs()); }
+
+private:
+    const char* name;
+    const char* argName;
+    int64_t arg;
+    int64_t startNs;
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+// Writes the trace when main() leaves its scope; path from OMR_TRACE_FILE
+class TraceSession {
+public:
+    TraceSession();
+    ~TraceSession();
+
+private:
+    std::string path;
+};
+
+#define OMR_TRACE_CONCAT_INNER(a, b) a##b
+#define OMR_TRACE_CONCAT(a, b) OMR_TRACE_CONCAT_INNER(a, b)
+#define OMR_TRACE_SCOPE(name) TraceScope OMR_TRACE_CONCAT(omrTraceScope, __LINE__)(name)
+#define OMR_TRACE_SCOPE_ARG(name, argName, value) \
+    TraceScope OMR_TRACE_CONCAT(omrTraceScope, __LINE__)(name, argName, static_cast<int64_t>(value))
+#define OMR_TRACE_THREAD_NAME(threadName) Tracer::instance().setThreadName(threadName)
+#define OMR_TRACE_SESSION() TraceSession omrTraceSession
+
+#else
+
+#define OMR_TRACE_SCOPE(name) ((void)0)
+#define OMR_TRACE_SCOPE_ARG(name, argName, value) ((void)0)
+#define OMR_TRACE_THREAD_NAME(threadName) ((void)0)
+#define OMR_TRACE_SESSION() ((void)0)
+
+#endif
+
+#endif
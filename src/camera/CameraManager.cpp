@@ -1,7 +1,9 @@
 #include "CameraManager.h"
 #include <iostream>
 
-CameraManager::CameraManager() : isInitialized(false), currentDeviceId(-1) {
+CameraManager::CameraManager()
+    : isInitialized(false), currentDeviceId(-1), readSequence(0), sharedSlot(1), writeIndex(0), readIndex(2),
+      grabbing(false), sourceFinished(false), grabbedFrames(0), deliveredFrames(0), droppedFrames(0), failedReads(0) {
 }
 
 CameraManager::~CameraManager() {
@@ -9,27 +11,45 @@ CameraManager::~CameraManager() {
 }
 
 bool CameraManager::initCamera(int deviceId) {
+    if (!openSource(std::make_unique<DeviceFrameSource>(deviceId))) {
+        std::cerr << "Hata: Kamera açılamadı (Device ID: " << deviceId << ")" << std::endl;
+        return false;
+    }
+    
+    currentDeviceId = deviceId;
+    
+    // Set default resolution (720p for better performance)
+    setResolution(1280, 720);
+    
+    std::cout << "Kamera başarıyla başlatıldı (Device ID: " << deviceId << ")" << std::endl;
+    return true;
+}
+
+bool CameraManager::openSource(std::unique_ptr<FrameSource> frameSource) {
     try {
         // Release previous camera if exists
         if (isInitialized) {
             releaseCamera();
         }
         
-        // Open camera
-        camera.open(deviceId);
-        
-        if (!camera.isOpened()) {
-            std::cerr << "Hata: Kamera açılamadı (Device ID: " << deviceId << ")" << std::endl;
+        if (!frameSource || !frameSource->open()) {
             return false;
         }
         
-        currentDeviceId = deviceId;
+        source = std::move(frameSource);
         isInitialized = true;
+        readSequence = 0;
+        sourceFinished = false;
+        grabbedFrames = 0;
+        deliveredFrames = 0;
+        droppedFrames = 0;
+        failedReads = 0;
         
-        // Set default resolution (720p for better performance)
-        setResolution(1280, 720);
-        
-        std::cout << "Kamera başarıyla başlatıldı (Device ID: " << deviceId << ")" << std::endl;
+        if (!source->isLive()) {
+            std::cout << "Kaynak açıldı: " << source->describe() << " ("
+                      << (source->getPacing() == FrameSource::REALTIME ? "gerçek zamanlı" : "olabildiğince hızlı")
+                      << ")" << std::endl;
+        }
         return true;
         
     } catch (const cv::Exception& e) {
@@ -40,16 +60,26 @@ bool CameraManager::initCamera(int deviceId) {
 }
 
 cv::Mat CameraManager::captureFrame() {
-    if (!isInitialized || !camera.isOpened()) {
+    if (!isReady()) {
         throw std::runtime_error("Kamera başlatılmamış veya hazır değil!");
     }
     
+    // The grabber owns the device: wait for its next frame instead of reading concurrently
+    if (isGrabbing()) {
+        cv::Mat latest;
+        while (!getLatestFrame(latest)) {
+            if (!isGrabbing()) {
+                throw std::runtime_error("Kare yakalayıcı durdu!");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return latest.clone();
+    }
+    
     cv::Mat frame;
     try {
-        camera >> frame;
-        
-        if (frame.empty()) {
-            throw std::runtime_error("Boş frame yakalandı!");
+        if (!source->read(frame)) {
+            throw std::runtime_error(source->isFinished() ? "Kayıt sona erdi!" : "Boş frame yakalandı!");
         }
         
         return frame;
@@ -60,12 +90,29 @@ cv::Mat CameraManager::captureFrame() {
 }
 
 bool CameraManager::isReady() const {
-    return isInitialized && camera.isOpened();
+    return isInitialized && source && source->isOpened();
+}
+
+bool CameraManager::isFinished() const {
+    if (!source) {
+        return false;
+    }
+    // The grabber reports the end itself; the source is not touched while it runs
+    if (sourceFinished.load(std::memory_order_acquire)) {
+        return !(sharedSlot.load(std::memory_order_acquire) & FRESH_FLAG);
+    }
+    return !isGrabbing() && source->isFinished();
+}
+
+const FrameSource* CameraManager::getSource() const {
+    return source.get();
 }
 
 void CameraManager::releaseCamera() {
-    if (camera.isOpened()) {
-        camera.release();
+    stopGrabber();
+    
+    if (source && source->isOpened()) {
+        source->release();
         std::cout << "Kamera kaynağı serbest bırakıldı" << std::endl;
     }
     isInitialized = false;
@@ -77,12 +124,18 @@ bool CameraManager::setResolution(int width, int height) {
         return false;
     }
     
-    camera.set(cv::CAP_PROP_FRAME_WIDTH, width);
-    camera.set(cv::CAP_PROP_FRAME_HEIGHT, height);
+    // VideoCapture is not thread-safe
+    if (isGrabbing()) {
+        std::cerr << "Hata: Kare yakalayıcı çalışırken kamera ayarı değiştirilemez" << std::endl;
+        return false;
+    }
+    
+    source->set(cv::CAP_PROP_FRAME_WIDTH, width);
+    source->set(cv::CAP_PROP_FRAME_HEIGHT, height);
     
     // Verify the resolution was set
-    int actualWidth = static_cast<int>(camera.get(cv::CAP_PROP_FRAME_WIDTH));
-    int actualHeight = static_cast<int>(camera.get(cv::CAP_PROP_FRAME_HEIGHT));
+    int actualWidth = static_cast<int>(source->get(cv::CAP_PROP_FRAME_WIDTH));
+    int actualHeight = static_cast<int>(source->get(cv::CAP_PROP_FRAME_HEIGHT));
     
     std::cout << "Çözünürlük ayarlandı: " << actualWidth << "x" << actualHeight << std::endl;
     
@@ -94,10 +147,161 @@ bool CameraManager::setFPS(int fps) {
         return false;
     }
     
-    camera.set(cv::CAP_PROP_FPS, fps);
+    // VideoCapture is not thread-safe
+    if (isGrabbing()) {
+        std::cerr << "Hata: Kare yakalayıcı çalışırken kamera ayarı değiştirilemez" << std::endl;
+        return false;
+    }
+    
+    source->set(cv::CAP_PROP_FPS, fps);
     
-    int actualFPS = static_cast<int>(camera.get(cv::CAP_PROP_FPS));
+    int actualFPS = static_cast<int>(source->get(cv::CAP_PROP_FPS));
     std::cout << "FPS ayarlandı: " << actualFPS << std::endl;
     
     return true;
 }
+
+bool CameraManager::startGrabber() {
+    if (!isReady()) {
+        std::cerr << "Hata: Kamera başlatılmadan kare yakalayıcı açılamaz" << std::endl;
+        return false;
+    }
+    if (isGrabbing()) {
+        return true;
+    }
+    if (grabberThread.joinable()) {
+        grabberThread.join();   // finished at the end of a recording
+    }
+    
+    // Preallocate all three slots at the capture size so the grabber never allocates
+    int width = static_cast<int>(source->get(cv::CAP_PROP_FRAME_WIDTH));
+    int height = static_cast<int>(source->get(cv::CAP_PROP_FRAME_HEIGHT));
+    for (auto& slot : slots) {
+        if (width > 0 && height > 0) {
+            slot.image.create(height, width, CV_8UC3);
+        }
+        slot.info = FrameInfo();
+    }
+    
+    writeIndex = 0;
+    sharedSlot.store(1);
+    readIndex = 2;
+    grabbedFrames = 0;
+    deliveredFrames = 0;
+    droppedFrames = 0;
+    failedReads = 0;
+    sourceFinished = false;
+    
+    grabbing = true;
+    grabberThread = std::thread(&CameraManager::grabberLoop, this);
+    std::cout << "Kare yakalayıcı başlatıldı" << std::endl;
+    return true;
+}
+
+void CameraManager::stopGrabber() {
+    grabbing = false;
+    if (grabberThread.joinable()) {
+        grabberThread.join();
+        
+        CameraStats stats = getStats();
+        std::cout << "Kare yakalayıcı durduruldu: " << stats.grabbedFrames << " kare yakalandı, "
+                  << stats.deliveredFrames << " işlendi, " << stats.droppedFrames << " düşürüldü";
+        if (stats.failedReads > 0) {
+            std::cout << ", " << stats.failedReads << " okuma hatası";
+        }
+        std::cout << std::endl;
+    }
+}
+
+bool CameraManager::isGrabbing() const {
+    return grabbing.load(std::memory_order_acquire);
+}
+
+void CameraManager::grabberLoop() {
+    uint64_t sequence = 0;
+    
+    while (grabbing.load(std::memory_order_acquire)) {
+        FrameSlot& slot = slots[writeIndex];
+        
+        bool ok = false;
+        try {
+            // Same size and type as the preallocated slot: read() reuses its buffer
+            ok = source->read(slot.image) && !slot.image.empty();
+        } catch (const cv::Exception& e) {
+            std::cerr << "Frame yakalama hatası: " << e.what() << std::endl;
+        }
+        
+        // End of a recording: no more frames will come
+        if (!ok && source->isFinished()) {
+            sourceFinished.store(true, std::memory_order_release);
+            grabbing.store(false, std::memory_order_release);
+            break;
+        }
+        
+        if (!ok) {
+            failedReads.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            continue;
+        }
+        
+        slot.info.sequence = ++sequence;
+        slot.info.timestamp = std::chrono::steady_clock::now();
+        grabbedFrames.fetch_add(1, std::memory_order_relaxed);
+        
+        // Publish: the written slot becomes the shared one, the old shared slot is ours to overwrite
+        uint8_t previous = sharedSlot.exchange(static_cast<uint8_t>(writeIndex | FRESH_FLAG),
+                                               std::memory_order_acq_rel);
+        if (previous & FRESH_FLAG) {
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        writeIndex = previous & INDEX_MASK;
+    }
+}
+
+bool CameraManager::getLatestFrame(cv::Mat& frame, FrameInfo* info) {
+    if (!(sharedSlot.load(std::memory_order_acquire) & FRESH_FLAG)) {
+        return false;
+    }
+    
+    // Take the fresh slot and hand back the one we were reading
+    uint8_t previous = sharedSlot.exchange(readIndex, std::memory_order_acq_rel);
+    readIndex = previous & INDEX_MASK;
+    
+    frame = slots[readIndex].image;
+    if (info) {
+        *info = slots[readIndex].info;
+    }
+    deliveredFrames.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool CameraManager::readNextFrame(cv::Mat& frame, FrameInfo* info) {
+    if (!isReady() || isGrabbing()) {
+        return false;
+    }
+    
+    if (!source->read(frame)) {
+        if (!source->isFinished()) {
+            failedReads.fetch_add(1, std::memory_order_relaxed);
+        }
+        return false;
+    }
+    
+    grabbedFrames.fetch_add(1, std::memory_order_relaxed);
+    deliveredFrames.fetch_add(1, std::memory_order_relaxed);
+    readSequence++;
+    if (info) {
+        info->sequence = readSequence;
+        info->timestamp = std::chrono::steady_clock::now();
+    }
+    return true;
+}
+
+CameraStats CameraManager::getStats() const {
+    CameraStats stats;
+    stats.grabbedFrames = grabbedFrames.load(std::memory_order_relaxed);
+    stats.deliveredFrames = deliveredFrames.load(std::memory_order_relaxed);
+    stats.droppedFrames = droppedFrames.load(std::memory_order_relaxed);
+    stats.failedReads = failedReads.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,180 @@
+#include "DocumentSession.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+DocumentSession::DocumentSession(const DocumentSessionConfig& config)
+    : config(config), sharpness(0.0), motion(0.0), stableFrames(0), armed(true), hasCapture(false),
+      suspectedDuplicate(false) {
+}
+
+void DocumentSession::reset() {
+    stats = SessionStats();
+    previousThumbnail.release();
+    sharpness = 0.0;
+    motion = 0.0;
+    stableFrames = 0;
+    armed = true;
+    hasCapture = false;
+    suspectedDuplicate = false;
+    lastCapturedHash.reset();
+}
+
+void DocumentSession::makeThumbnail(const cv::Mat& frame) {
+    // Shrink first: the color conversion then touches a few thousand pixels, not the whole frame
+    int width = std::min(config.thumbnailWidth, frame.cols);
+    int height = std::max(1, cvRound(frame.rows * static_cast<double>(width) / frame.cols));
+
+    cv::Mat small;
+    cv::resize(frame, small, cv::Size(width, height), 0, 0, cv::INTER_AREA);
+    if (small.channels() == 3) {
+        cv::cvtColor(small, thumbnail, cv::COLOR_BGR2GRAY);
+    } else if (small.channels() == 4) {
+        cv::cvtColor(small, thumbnail, cv::COLOR_BGRA2GRAY);
+    } else {
+        thumbnail = small;
+    }
+}
+
+DocumentSession::Event DocumentSession::update(const cv::Mat& frame) {
+    if (frame.empty()) {
+        return MOVING;
+    }
+
+    stats.frames++;
+    makeThumbnail(frame);
+
+    // Mean absolute difference to the previous thumbnail; the first frame counts as movement
+    if (previousThumbnail.empty() || previousThumbnail.size() != thumbnail.size()) {
+        motion = config.rearmMotion;
+    } else {
+        cv::Mat difference;
+        cv::absdiff(thumbnail, previousThumbnail, difference);
+        motion = cv::mean(difference)[0];
+    }
+
+    // Variance of the Laplacian: low when the page is out of focus or motion-blurred
+    cv::Laplacian(thumbnail, laplacian, CV_16S);
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(laplacian, mean, stddev);
+    sharpness = stddev[0] * stddev[0];
+
+    // Keep this thumbnail for the next frame; the hash below only needs the copy
+    std::swap(previousThumbnail, thumbnail);
+    const cv::Mat& current = previousThumbnail;
+
+    if (motion >= config.rearmMotion) {
+        armed = true;
+    }
+
+    if (motion > config.maxMotion) {
+        stableFrames = 0;
+        return MOVING;
+    }
+
+    stableFrames++;
+    if (!armed) {
+        return IDLE;
+    }
+    if (stableFrames < config.settleFrames) {
+        return SETTLING;
+    }
+    if (sharpness < config.minSharpness) {
+        stats.blurryFrames++;
+        return BLURRY;
+    }
+
+    // Settled and sharp after movement: a new sheet. Two sheets of one template that differ
+    // only in marks hash alike at thumbnail scale, so a close hash is only a warning; dropping
+    // the capture would lose a real student's sheet.
+    SheetHash hash = perceptualHash(current);
+    armed = false;
+
+    suspectedDuplicate = hasCapture && hashDistance(hash, lastCapturedHash) <= config.duplicateDistance;
+    if (suspectedDuplicate) {
+        stats.suspectedDuplicates++;
+    }
+
+    lastCapturedHash = hash;
+    hasCapture = true;
+    stats.captured++;
+    return CAPTURED;
+}
+
+DocumentSession::SheetHash DocumentSession::perceptualHash(const cv::Mat& grayThumbnail) {
+    // 16x16 lowest DCT frequencies of a 32x32 image, thresholded at their median (DC excluded).
+    // Sheets of one template differ only in marks; 64 bits cannot separate them reliably.
+    cv::Mat resized, floating, coefficients;
+    cv::resize(grayThumbnail, resized, cv::Size(32, 32), 0, 0, cv::INTER_AREA);
+    resized.convertTo(floating, CV_32F);
+    cv::dct(floating, coefficients);
+
+    std::vector<float> values;
+    values.reserve(255);
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            if (x != 0 || y != 0) {
+                values.push_back(coefficients.at<float>(y, x));
+            }
+        }
+    }
+
+    std::vector<float> sorted(values);
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    float median = sorted[sorted.size() / 2];
+
+    SheetHash hash;
+    for (size_t i = 0; i < values.size(); i++) {
+        hash[i] = values[i] > median;
+    }
+    return hash;
+}
+
+int DocumentSession::hashDistance(const SheetHash& a, const SheetHash& b) {
+    return static_cast<int>((a ^ b).count());
+}
+
+double DocumentSession::getSharpness() const {
+    return sharpness;
+}
+
+double DocumentSession::getMotion() const {
+    return motion;
+}
+
+int DocumentSession::getStableFrames() const {
+    return stableFrames;
+}
+
+bool DocumentSession::isSuspectedDuplicate() const {
+    return suspectedDuplicate;
+}
+
+const SessionStats& DocumentSession::getStats() const {
+    return stats;
+}
+
+void DocumentSession::drawOverlay(cv::Mat& frame, Event event) const {
+    // Hershey fonts have no Turkish glyphs: ASCII labels
+    const char* label = "HAREKET";
+    cv::Scalar color(0, 0, 255);
+    switch (event) {
+        case SETTLING:  label = "SABITLENIYOR"; color = cv::Scalar(0, 255, 255); break;
+        case BLURRY:    label = "BULANIK";      color = cv::Scalar(0, 128, 255); break;
+        case CAPTURED:
+            label = suspectedDuplicate ? "CEKILDI (AYNI?)" : "CEKILDI";
+            color = suspectedDuplicate ? cv::Scalar(255, 128, 0) : cv::Scalar(0, 255, 0);
+            break;
+        case IDLE:      label = "SAYFA CEVIRIN"; color = cv::Scalar(255, 255, 255); break;
+        case MOVING:    break;
+    }
+
+    char metrics[64];
+    std::snprintf(metrics, sizeof(metrics), "netlik %.0f  hareket %.1f", sharpness, motion);
+    char counts[64];
+    std::snprintf(counts, sizeof(counts), "cekilen %zu  ayni? %zu", stats.captured, stats.suspectedDuplicates);
+
+    cv::putText(frame, label, cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 0.8, color, 2);
+    cv::putText(frame, metrics, cv::Point(10, 60), cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(255, 255, 255), 1);
+    cv::putText(frame, counts, cv::Point(10, 85), cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(255, 255, 255), 1);
+}
@@ -0,0 +1,259 @@
+#include "FrameSource.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool isImageFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png" ||
+           ext == ".bmp" || ext == ".tif" || ext == ".tiff";
+}
+
+bool isDeviceId(const std::string& spec) {
+    return !spec.empty() && std::all_of(spec.begin(), spec.end(),
+                                        [](unsigned char c) { return std::isdigit(c); });
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// FrameSource
+
+FrameSource::FrameSource(Pacing pacing) : finished(false), pacing(pacing), framesRead(0) {
+}
+
+FrameSource::~FrameSource() {
+}
+
+std::unique_ptr<FrameSource> FrameSource::create(const std::string& spec, Pacing pacing) {
+    if (isDeviceId(spec)) {
+        return std::make_unique<DeviceFrameSource>(std::stoi(spec));
+    }
+
+    std::error_code ec;
+    if (fs::is_directory(spec, ec)) {
+        return std::make_unique<ImageSequenceFrameSource>(spec, pacing);
+    }
+    return std::make_unique<VideoFileFrameSource>(spec, pacing);
+}
+
+bool FrameSource::parsePacing(const std::string& name, Pacing& pacing) {
+    if (name == "realtime") {
+        pacing = REALTIME;
+    } else if (name == "fast") {
+        pacing = AS_FAST_AS_POSSIBLE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool FrameSource::read(cv::Mat& frame) {
+    if (finished || !isOpened()) {
+        return false;
+    }
+
+    // Recordings are released at their own frame rate; a late consumer is not waited for
+    if (pacing == REALTIME && !isLive()) {
+        if (framesRead == 0) {
+            replayStart = std::chrono::steady_clock::now();
+        }
+        double fps = get(cv::CAP_PROP_FPS);
+        if (fps <= 0.0) {
+            fps = 30.0;
+        }
+        auto due = replayStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(framesRead / fps));
+        std::this_thread::sleep_until(due);
+    }
+
+    if (!readFrame(frame)) {
+        return false;
+    }
+    framesRead++;
+    return true;
+}
+
+void FrameSource::resetPacing() {
+    finished = false;
+    framesRead = 0;
+}
+
+bool FrameSource::isFinished() const {
+    return finished;
+}
+
+bool FrameSource::set(int, double) {
+    return false;
+}
+
+FrameSource::Pacing FrameSource::getPacing() const {
+    return pacing;
+}
+
+size_t FrameSource::getFramesRead() const {
+    return framesRead;
+}
+
+// ----------------------------------------------------------------------------
+// DeviceFrameSource
+
+DeviceFrameSource::DeviceFrameSource(int deviceId) : FrameSource(REALTIME), deviceId(deviceId) {
+}
+
+bool DeviceFrameSource::open() {
+    resetPacing();
+    return capture.open(deviceId);
+}
+
+bool DeviceFrameSource::isOpened() const {
+    return capture.isOpened();
+}
+
+void DeviceFrameSource::release() {
+    capture.release();
+}
+
+bool DeviceFrameSource::isLive() const {
+    return true;
+}
+
+bool DeviceFrameSource::set(int propertyId, double value) {
+    return capture.set(propertyId, value);
+}
+
+double DeviceFrameSource::get(int propertyId) const {
+    return capture.get(propertyId);
+}
+
+std::string DeviceFrameSource::describe() const {
+    return "kamera " + std::to_string(deviceId);
+}
+
+bool DeviceFrameSource::readFrame(cv::Mat& frame) {
+    // A camera does not end; an empty frame is a read error
+    return capture.read(frame) && !frame.empty();
+}
+
+// ----------------------------------------------------------------------------
+// VideoFileFrameSource
+
+VideoFileFrameSource::VideoFileFrameSource(const std::string& path, Pacing pacing)
+    : FrameSource(pacing), path(path) {
+}
+
+bool VideoFileFrameSource::open() {
+    resetPacing();
+    return capture.open(path);
+}
+
+bool VideoFileFrameSource::isOpened() const {
+    return capture.isOpened();
+}
+
+void VideoFileFrameSource::release() {
+    capture.release();
+}
+
+bool VideoFileFrameSource::isLive() const {
+    return false;
+}
+
+double VideoFileFrameSource::get(int propertyId) const {
+    return capture.get(propertyId);
+}
+
+std::string VideoFileFrameSource::describe() const {
+    return "video " + path;
+}
+
+bool VideoFileFrameSource::readFrame(cv::Mat& frame) {
+    if (!capture.read(frame) || frame.empty()) {
+        finished = true;
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// ImageSequenceFrameSource
+
+ImageSequenceFrameSource::ImageSequenceFrameSource(const std::string& directory, Pacing pacing, double fps)
+    : FrameSource(pacing), directory(directory), fps(fps), nextIndex(0) {
+}
+
+bool ImageSequenceFrameSource::open() {
+    resetPacing();
+    paths.clear();
+    nextIndex = 0;
+
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file() && isImageFile(entry.path())) {
+            paths.push_back(entry.path().string());
+        }
+    }
+
+    // Frame order is file name order (frame_0001.png, frame_0002.png, ...)
+    std::sort(paths.begin(), paths.end());
+
+    if (paths.empty()) {
+        std::cerr << "Hata: Klasörde görüntü bulunamadı: " << directory << std::endl;
+        return false;
+    }
+
+    cv::Mat first = cv::imread(paths.front());
+    frameSize = first.size();
+    return true;
+}
+
+bool ImageSequenceFrameSource::isOpened() const {
+    return !paths.empty();
+}
+
+void ImageSequenceFrameSource::release() {
+    paths.clear();
+    nextIndex = 0;
+}
+
+bool ImageSequenceFrameSource::isLive() const {
+    return false;
+}
+
+double ImageSequenceFrameSource::get(int propertyId) const {
+    switch (propertyId) {
+        case cv::CAP_PROP_FPS:          return fps;
+        case cv::CAP_PROP_FRAME_WIDTH:  return frameSize.width;
+        case cv::CAP_PROP_FRAME_HEIGHT: return frameSize.height;
+        case cv::CAP_PROP_FRAME_COUNT:  return static_cast<double>(paths.size());
+        case cv::CAP_PROP_POS_FRAMES:   return static_cast<double>(nextIndex);
+        default:                        return 0.0;
+    }
+}
+
+std::string ImageSequenceFrameSource::describe() const {
+    return "görüntü klasörü " + directory + " (" + std::to_string(paths.size()) + " kare)";
+}
+
+bool ImageSequenceFrameSource::readFrame(cv::Mat& frame) {
+    // Unreadable files are skipped, not treated as the end of the sequence
+    while (nextIndex < paths.size()) {
+        frame = cv::imread(paths[nextIndex++]);
+        if (!frame.empty()) {
+            return true;
+        }
+        std::cerr << "Uyarı: Kare okunamadı: " << paths[nextIndex - 1] << std::endl;
+    }
+
+    finished = true;
+    return false;
+}
@@ -1,4 +1,5 @@
 #include "BubbleDetector.h"
+#include "Tracer.h"
 #include <iostream>
 #include <algorithm>
 
@@ -16,25 +17,28 @@ std::vector<cv::Vec3f> BubbleDetector::detectBubbles(
     int minRadius,
     int maxRadius) {
     
-    cv::Mat gray;
-    if (image.channels() == 3) {
-        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
-    } else {
-        gray = image.clone();
-    }
+    SheetContext context(image);
+    return detectBubbles(context, cv::Rect(0, 0, image.cols, image.rows), minRadius, maxRadius);
+}
+
+std::vector<cv::Vec3f> BubbleDetector::detectBubbles(
+    SheetContext& sheet,
+    const cv::Rect& region,
+    int minRadius,
+    int maxRadius) {
     
-    // Apply Gaussian blur
-    cv::Mat blurred;
-    cv::GaussianBlur(gray, blurred, cv::Size(5, 5), 0);
+    // Gaussian 5x5 is computed once per sheet and shared by every region
+    cv::Mat blurred = sheet.blurred(5)(region);
     
-    // Detect circles using HoughCircles
+    // Detect circles using HoughCircles (coordinates are relative to region)
+    OMR_TRACE_SCOPE("cv::HoughCircles");
     std::vector<cv::Vec3f> circles;
     cv::HoughCircles(
         blurred,
         circles,
         cv::HOUGH_GRADIENT,
         1,                          // dp: inverse ratio of accumulator resolution
-        gray.rows / 16,            // minDist: minimum distance between centers
+        std::max(1, region.height / 16), // minDist: minimum distance between centers
         50,                         // param1: upper threshold for Canny
         30,                         // param2: threshold for center detection
         minRadius,
@@ -78,12 +82,12 @@ double BubbleDetector::calculateFillPercentage(
     // Extract bubble ROI
     cv::Mat bubbleROI = extractBubbleROI(image, center, radius);
     
-    // Convert to grayscale if needed
+    // Convert to grayscale if needed (the masked ROI is already a private copy)
     cv::Mat gray;
     if (bubbleROI.channels() == 3) {
         cv::cvtColor(bubbleROI, gray, cv::COLOR_BGR2GRAY);
     } else {
-        gray = bubbleROI.clone();
+        gray = bubbleROI;
     }
     
     // Apply threshold to separate filled from unfilled
@@ -115,17 +119,19 @@ std::vector<int> BubbleDetector::detectMarkedBubbles(
     const std::vector<cv::Rect>& bubbleRegions) {
     
     std::vector<int> markedIndices;
+    SheetContext sheet(image);
     
     for (size_t i = 0; i < bubbleRegions.size(); i++) {
         cv::Rect region = bubbleRegions[i];
         
         // Extract region
-        cv::Mat roi = image(region);
+        cv::Mat roi = sheet.gray()(region);
         
         // Detect bubbles in this region
         int estimatedRadius = std::min(region.width, region.height) / 3;
         std::vector<cv::Vec3f> bubbles = detectBubbles(
-            roi,
+            sheet,
+            region,
             estimatedRadius - 5,
             estimatedRadius + 5
         );
@@ -155,8 +161,24 @@ int BubbleDetector::detectMarkedAnswer(
     const cv::Rect& questionRegion,
     int numOptions) {
     
+    // Single question: preprocess only its region
+    SheetContext context(image(questionRegion));
+    return detectMarkedAnswer(
+        context,
+        cv::Rect(0, 0, questionRegion.width, questionRegion.height),
+        numOptions
+    );
+}
+
+int BubbleDetector::detectMarkedAnswer(
+    SheetContext& sheet,
+    const cv::Rect& questionRegion,
+    int numOptions) {
+    
+    OMR_TRACE_SCOPE("BubbleDetector::detectMarkedAnswer");
+    
     // Extract question region
-    cv::Mat roi = image(questionRegion);
+    cv::Mat roi = sheet.gray()(questionRegion);
     
     // Divide region into equal parts for each option
     int optionWidth = questionRegion.width / numOptions;
@@ -170,7 +192,8 @@ int BubbleDetector::detectMarkedAnswer(
         // Detect bubbles in this option
         int estimatedRadius = std::min(optionWidth, questionRegion.height) / 3;
         std::vector<cv::Vec3f> bubbles = detectBubbles(
-            optionROI,
+            sheet,
+            optionRect + questionRegion.tl(),
             estimatedRadius - 5,
             estimatedRadius + 5
         );
@@ -0,0 +1,242 @@
+#include "BubbleFillKernel.h"
+#include <opencv2/core/hal/intrin.hpp>
+#include <algorithm>
+#include <cmath>
+
+// Function-style intrinsics (v_add, v_le, VTraits) are the portable API from OpenCV 4.9 on
+#if (CV_SIMD || CV_SIMD_SCALABLE) && \
+    (CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 9))
+#define OMR_BUBBLE_SIMD 1
+#else
+#define OMR_BUBBLE_SIMD 0
+#endif
+
+namespace {
+
+int discHalfWidth(int radius, int dy) {
+    return static_cast<int>(std::floor(std::sqrt(static_cast<double>(radius * radius - dy * dy))));
+}
+
+} // namespace
+
+BubbleFillKernel::BubbleFillKernel() {
+}
+
+bool BubbleFillKernel::isVectorized() {
+    return OMR_BUBBLE_SIMD != 0;
+}
+
+int BubbleFillKernel::getVectorWidth() {
+#if OMR_BUBBLE_SIMD
+    return cv::VTraits<cv::v_uint8>::vlanes();
+#else
+    return 1;
+#endif
+}
+
+BubbleFillKernel::BitMask BubbleFillKernel::buildMask(int outerRadius, int holeRadius) {
+    BitMask mask;
+    mask.radius = outerRadius;
+    mask.area = 0;
+
+    // Pad rows to whole vectors so the inner loop has no tail
+    int width = 2 * outerRadius + 1;
+    int lanes = getVectorWidth();
+    mask.stride = ((width + lanes - 1) / lanes) * lanes;
+    mask.bits.assign(static_cast<size_t>(width) * mask.stride, 0);
+
+    for (int dy = -outerRadius; dy <= outerRadius; dy++) {
+        uchar* row = &mask.bits[static_cast<size_t>(dy + outerRadius) * mask.stride];
+        int outerHalf = discHalfWidth(outerRadius, dy);
+        int holeHalf = (holeRadius > 0 && std::abs(dy) <= holeRadius) ? discHalfWidth(holeRadius, dy) : -1;
+
+        for (int dx = -outerHalf; dx <= outerHalf; dx++) {
+            if (std::abs(dx) <= holeHalf) {
+                continue;
+            }
+            row[dx + outerRadius] = 0xFF;
+            mask.area++;
+        }
+    }
+
+    return mask;
+}
+
+int BubbleFillKernel::registerMask(int innerRadius, int annulusInnerRadius, int annulusOuterRadius) {
+    innerRadius = std::max(1, std::min(innerRadius, MAX_RADIUS));
+    annulusOuterRadius = std::max(1, std::min(annulusOuterRadius, MAX_RADIUS));
+    annulusInnerRadius = std::max(0, std::min(annulusInnerRadius, annulusOuterRadius - 1));
+
+    MaskPair pair;
+    pair.disc = buildMask(innerRadius, 0);
+    pair.ring = buildMask(annulusOuterRadius, annulusInnerRadius);
+
+    masks.push_back(std::move(pair));
+    return static_cast<int>(masks.size() - 1);
+}
+
+void BubbleFillKernel::clear() {
+    masks.clear();
+}
+
+size_t BubbleFillKernel::getMaskCount() const {
+    return masks.size();
+}
+
+int BubbleFillKernel::countDarkScalar(
+    const cv::Mat& gray,
+    int darkThreshold,
+    const cv::Point& center,
+    const BitMask& mask,
+    int& area) {
+
+    int dark = 0;
+    area = 0;
+    int x0 = center.x - mask.radius;
+    int y0 = center.y - mask.radius;
+    int side = 2 * mask.radius + 1;
+
+    for (int r = 0; r < side; r++) {
+        int y = y0 + r;
+        if (y < 0 || y >= gray.rows) {
+            continue;
+        }
+
+        const uchar* src = gray.ptr<uchar>(y);
+        const uchar* bits = &mask.bits[static_cast<size_t>(r) * mask.stride];
+        int cStart = std::max(0, -x0);
+        int cEnd = std::min(side, gray.cols - x0);
+
+        for (int c = cStart; c < cEnd; c++) {
+            if (bits[c]) {
+                area++;
+                dark += src[x0 + c] <= darkThreshold ? 1 : 0;
+            }
+        }
+    }
+
+    return dark;
+}
+
+bool BubbleFillKernel::fitsVectorWindow(const cv::Mat& gray, const cv::Point& center, const BitMask& mask) {
+    int x0 = center.x - mask.radius;
+    int y0 = center.y - mask.radius;
+    int side = 2 * mask.radius + 1;
+    // Loads cover the padded stride, which must stay inside the row
+    return x0 >= 0 && y0 >= 0 && y0 + side <= gray.rows && x0 + mask.stride <= gray.cols;
+}
+
+int BubbleFillKernel::countDarkVector(
+    const cv::Mat& gray,
+    int darkThreshold,
+    const cv::Point& center,
+    const BitMask& mask) {
+
+#if OMR_BUBBLE_SIMD
+    const int lanes = cv::VTraits<cv::v_uint8>::vlanes();
+    const int x0 = center.x - mask.radius;
+    const int y0 = center.y - mask.radius;
+    const int side = 2 * mask.radius + 1;
+
+    const cv::v_uint8 threshold = cv::vx_setall_u8(static_cast<uchar>(darkThreshold));
+    const cv::v_uint8 one = cv::vx_setall_u8(1);
+    cv::v_uint8 counts = cv::vx_setzero_u8();
+    int pendingRows = 0;
+    int dark = 0;
+
+    // At most stride/lanes increments per lane per row
+    const int flushEvery = std::max(1, 255 / (mask.stride / lanes));
+
+    for (int r = 0; r < side; r++) {
+        const uchar* src = gray.ptr<uchar>(y0 + r) + x0;
+        const uchar* bits = &mask.bits[static_cast<size_t>(r) * mask.stride];
+
+        for (int c = 0; c < mask.stride; c += lanes) {
+            cv::v_uint8 isDark = cv::v_le(cv::vx_load(src + c), threshold);
+            counts = cv::v_add(counts, cv::v_and(cv::v_and(isDark, cv::vx_load(bits + c)), one));
+        }
+
+        if (++pendingRows == flushEvery || r == side - 1) {
+            cv::v_uint16 low, high;
+            cv::v_expand(counts, low, high);
+            cv::v_uint32 a, b;
+            cv::v_expand(cv::v_add(low, high), a, b);
+            dark += static_cast<int>(cv::v_reduce_sum(cv::v_add(a, b)));
+            counts = cv::vx_setzero_u8();
+            pendingRows = 0;
+        }
+    }
+
+    return dark;
+#else
+    int area = 0;
+    return countDarkScalar(gray, darkThreshold, center, mask, area);
+#endif
+}
+
+void BubbleFillKernel::scoreBatch(
+    const cv::Mat& gray,
+    int darkThreshold,
+    const cv::Point* centers,
+    const int* maskIds,
+    size_t count,
+    double* fills,
+    double* backgrounds) const {
+
+    CV_Assert(gray.type() == CV_8UC1);
+
+    // Nothing can be <= a negative threshold: no ink class on this sheet
+    if (darkThreshold < 0) {
+        std::fill(fills, fills + count, 0.0);
+        std::fill(backgrounds, backgrounds + count, 0.0);
+        return;
+    }
+
+    darkThreshold = std::min(darkThreshold, 255);
+
+    for (size_t i = 0; i < count; i++) {
+        const MaskPair& pair = masks[maskIds[i]];
+        int discArea = pair.disc.area;
+        int ringArea = pair.ring.area;
+        int discDark;
+        int ringDark;
+
+        if (fitsVectorWindow(gray, centers[i], pair.disc)) {
+            discDark = countDarkVector(gray, darkThreshold, centers[i], pair.disc);
+        } else {
+            discDark = countDarkScalar(gray, darkThreshold, centers[i], pair.disc, discArea);
+        }
+
+        if (fitsVectorWindow(gray, centers[i], pair.ring)) {
+            ringDark = countDarkVector(gray, darkThreshold, centers[i], pair.ring);
+        } else {
+            ringDark = countDarkScalar(gray, darkThreshold, centers[i], pair.ring, ringArea);
+        }
+
+        fills[i] = discArea > 0 ? static_cast<double>(discDark) / discArea : 0.0;
+        backgrounds[i] = ringArea > 0 ? static_cast<double>(ringDark) / ringArea : 0.0;
+    }
+}
+
+void BubbleFillKernel::scoreBatchScalar(
+    const cv::Mat& gray,
+    int darkThreshold,
+    const cv::Point* centers,
+    const int* maskIds,
+    size_t count,
+    double* fills,
+    double* backgrounds) const {
+
+    CV_Assert(gray.type() == CV_8UC1);
+
+    for (size_t i = 0; i < count; i++) {
+        const MaskPair& pair = masks[maskIds[i]];
+        int discArea = 0;
+        int ringArea = 0;
+        int discDark = countDarkScalar(gray, darkThreshold, centers[i], pair.disc, discArea);
+        int ringDark = countDarkScalar(gray, darkThreshold, centers[i], pair.ring, ringArea);
+
+        fills[i] = discArea > 0 ? static_cast<double>(discDark) / discArea : 0.0;
+        backgrounds[i] = ringArea > 0 ? static_cast<double>(ringDark) / ringArea : 0.0;
+    }
+}
@@ -0,0 +1,224 @@
+#include "BubbleSampler.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+int optionCount(const QuestionRegion& region) {
+    switch (region.type) {
+        case QuestionRegion::MULTIPLE_CHOICE:
+            return region.numOptions;
+        case QuestionRegion::TRUE_FALSE:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+BubbleSampler::BubbleSampler(double fillThreshold, double minContrast)
+    : fillThreshold(fillThreshold), minContrast(minContrast) {
+
+    if (fillThreshold < 0.0 || fillThreshold > 1.0) {
+        std::cerr << "Uyarı: Fill threshold 0.0-1.0 arasında olmalı. 0.6 kullanılıyor." << std::endl;
+        this->fillThreshold = 0.6;
+    }
+}
+
+void BubbleSampler::computeBubbleGeometry(
+    const cv::Rect& questionRegion,
+    int numOptions,
+    std::vector<cv::Point>& centers,
+    int& radius) {
+
+    centers.clear();
+    radius = 0;
+    if (numOptions <= 0) {
+        return;
+    }
+
+    int optionWidth = questionRegion.width / numOptions;
+    radius = std::min(optionWidth, questionRegion.height) / 3;
+
+    for (int i = 0; i < numOptions; i++) {
+        centers.emplace_back(
+            questionRegion.x + i * optionWidth + optionWidth / 2,
+            questionRegion.y + questionRegion.height / 2
+        );
+    }
+}
+
+void BubbleSampler::setLayout(const std::vector<QuestionRegion>& regions, const SheetTemplate* sheetTemplate) {
+    layoutRegions.clear();
+    layoutOptions.clear();
+    layoutIndices.clear();
+    regionSlots.assign(regions.size(), -1);
+    slots.clear();
+    bubbleCenters.clear();
+    bubbleMasks.clear();
+    scoringContext.clearRadii();
+
+    std::vector<cv::Point> centers;
+
+    for (size_t r = 0; r < regions.size(); r++) {
+        int numOptions = optionCount(regions[r]);
+        layoutRegions.push_back(regions[r].region);
+        layoutOptions.push_back(numOptions);
+        layoutIndices.push_back(regions[r].layoutIndex);
+
+        if (numOptions <= 0) {
+            continue;
+        }
+
+        QuestionSlot slot;
+        slot.firstBubble = bubbleCenters.size();
+        slot.numOptions = numOptions;
+
+        const CompiledSheetLayout* layout = sheetTemplate ? &sheetTemplate->getLayout() : nullptr;
+        int index = regions[r].layoutIndex;
+
+        if (layout && index >= 0 && static_cast<size_t>(index) < layout->regionCount() &&
+            layout->regionRect(index) == regions[r].region && layout->optionCount[index] == numOptions) {
+            // Compiled template: centers and radii are a table read
+            for (int b = layout->firstBubble[index]; b < layout->firstBubble[index] + numOptions; b++) {
+                bubbleCenters.emplace_back(layout->bubbleX[b], layout->bubbleY[b]);
+                bubbleMasks.push_back(scoringContext.registerRadius(layout->bubbleRadius[b]));
+            }
+        } else {
+            int radius = 0;
+            computeBubbleGeometry(regions[r].region, numOptions, centers, radius);
+            int maskIndex = scoringContext.registerRadius(radius);
+
+            for (const auto& center : centers) {
+                bubbleCenters.push_back(center);
+                bubbleMasks.push_back(maskIndex);
+            }
+        }
+
+        regionSlots[r] = static_cast<int>(slots.size());
+        slots.push_back(slot);
+    }
+
+    bubbleScores.assign(bubbleCenters.size(), BubbleScore());
+}
+
+bool BubbleSampler::matchesLayout(const std::vector<QuestionRegion>& regions) const {
+    if (regions.size() != layoutRegions.size()) {
+        return false;
+    }
+
+    for (size_t r = 0; r < regions.size(); r++) {
+        if (regions[r].region != layoutRegions[r] || optionCount(regions[r]) != layoutOptions[r] ||
+            regions[r].layoutIndex != layoutIndices[r]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool BubbleSampler::hasLayout() const {
+    return !layoutRegions.empty();
+}
+
+void BubbleSampler::sample(const cv::Mat& sheet) {
+    if (sheet.empty() || bubbleCenters.empty()) {
+        std::fill(bubbleScores.begin(), bubbleScores.end(), BubbleScore());
+        return;
+    }
+
+    // One Otsu pass per sheet, then all bubbles in a single batch
+    scoringContext.prepare(sheet);
+    scoringContext.scoreBatch(bubbleCenters, bubbleMasks, bubbleScores);
+}
+
+void BubbleSampler::sample(SheetContext& sheet) {
+    if (sheet.empty() || bubbleCenters.empty()) {
+        std::fill(bubbleScores.begin(), bubbleScores.end(), BubbleScore());
+        return;
+    }
+
+    scoringContext.prepare(sheet);
+    scoringContext.scoreBatch(bubbleCenters, bubbleMasks, bubbleScores);
+}
+
+int BubbleSampler::getMarkedAnswer(size_t regionIndex) const {
+    if (regionIndex >= regionSlots.size() || regionSlots[regionIndex] < 0) {
+        return -1;
+    }
+
+    const QuestionSlot& slot = slots[regionSlots[regionIndex]];
+    int marked = -1;
+
+    for (int option = 0; option < slot.numOptions; option++) {
+        const BubbleScore& score = bubbleScores[slot.firstBubble + option];
+        if (score.fill >= fillThreshold && score.contrast >= minContrast) {
+            if (marked >= 0) {
+                return -1; // multiple marks
+            }
+            marked = option;
+        }
+    }
+
+    return marked;
+}
+
+int BubbleSampler::getMarkCount(size_t regionIndex) const {
+    if (regionIndex >= regionSlots.size() || regionSlots[regionIndex] < 0) {
+        return 0;
+    }
+
+    const QuestionSlot& slot = slots[regionSlots[regionIndex]];
+    int count = 0;
+
+    for (int option = 0; option < slot.numOptions; option++) {
+        const BubbleScore& score = bubbleScores[slot.firstBubble + option];
+        if (score.fill >= fillThreshold && score.contrast >= minContrast) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+const BubbleScore* BubbleSampler::findScore(size_t regionIndex, int option) const {
+    if (regionIndex >= regionSlots.size() || regionSlots[regionIndex] < 0) {
+        return nullptr;
+    }
+
+    const QuestionSlot& slot = slots[regionSlots[regionIndex]];
+    if (option < 0 || option >= slot.numOptions) {
+        return nullptr;
+    }
+
+    return &bubbleScores[slot.firstBubble + option];
+}
+
+double BubbleSampler::getFillPercentage(size_t regionIndex, int option) const {
+    const BubbleScore* score = findScore(regionIndex, option);
+    return score ? score->fill : 0.0;
+}
+
+BubbleScore BubbleSampler::getBubbleScore(size_t regionIndex, int option) const {
+    const BubbleScore* score = findScore(regionIndex, option);
+    return score ? *score : BubbleScore();
+}
+
+const BubbleScoringContext& BubbleSampler::getScoringContext() const {
+    return scoringContext;
+}
+
+void BubbleSampler::setScoringMethod(BubbleScoringContext::ScoringMethod method) {
+    scoringContext.setMethod(method);
+}
+
+size_t BubbleSampler::getBubbleCount() const {
+    return bubbleCenters.size();
+}
+
+void BubbleSampler::setFillThreshold(double threshold) {
+    if (threshold >= 0.0 && threshold <= 1.0) {
+        fillThreshold = threshold;
+    }
+}
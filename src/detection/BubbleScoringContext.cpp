@@ -0,0 +1,233 @@
+#include "BubbleScoringContext.h"
+#include <algorithm>
+#include <cmath>
+
+BubbleScoringContext::BubbleScoringContext(
+    double innerRadiusRatio,
+    double annulusInnerRatio,
+    double annulusOuterRatio)
+    : innerRadiusRatio(innerRadiusRatio),
+      annulusInnerRatio(annulusInnerRatio),
+      annulusOuterRatio(annulusOuterRatio),
+      method(SIMD_MASK),
+      source(nullptr),
+      inkThreshold(0) {
+
+    if (this->innerRadiusRatio <= 0.0 || this->innerRadiusRatio > 1.0) {
+        this->innerRadiusRatio = 0.8;
+    }
+    if (this->annulusOuterRatio <= this->annulusInnerRatio) {
+        this->annulusInnerRatio = 1.2;
+        this->annulusOuterRatio = 1.5;
+    }
+}
+
+std::vector<BubbleScoringContext::Band> BubbleScoringContext::buildDiscBands(int radius) {
+    std::vector<Band> bands;
+
+    for (int dy = -radius; dy <= radius; dy++) {
+        int halfWidth = static_cast<int>(
+            std::floor(std::sqrt(static_cast<double>(radius * radius - dy * dy))));
+
+        // Merge consecutive rows of equal width into one rectangle
+        if (!bands.empty() && bands.back().halfWidth == halfWidth && bands.back().dyEnd == dy - 1) {
+            bands.back().dyEnd = dy;
+        } else {
+            Band band;
+            band.dyStart = dy;
+            band.dyEnd = dy;
+            band.halfWidth = halfWidth;
+            bands.push_back(band);
+        }
+    }
+
+    return bands;
+}
+
+int BubbleScoringContext::registerRadius(int bubbleRadius) {
+    for (size_t i = 0; i < masks.size(); i++) {
+        if (masks[i].bubbleRadius == bubbleRadius) {
+            return static_cast<int>(i);
+        }
+    }
+
+    auto scaled = [bubbleRadius](double ratio) {
+        return std::max(1, static_cast<int>(std::lround(bubbleRadius * ratio)));
+    };
+
+    // Same clamp as the fill kernel, so both paths score identical masks
+    int innerRadius = std::min(scaled(innerRadiusRatio), BubbleFillKernel::MAX_RADIUS);
+    int annulusOuterRadius = std::min(scaled(annulusOuterRatio), BubbleFillKernel::MAX_RADIUS);
+    int annulusInnerRadius = std::min(scaled(annulusInnerRatio), annulusOuterRadius - 1);
+
+    RadiusMasks radiusMasks;
+    radiusMasks.bubbleRadius = bubbleRadius;
+    // Interior only, so the printed outline does not count as ink
+    radiusMasks.innerDisc = buildDiscBands(innerRadius);
+    // Paper just outside the outline: local background for contrast
+    radiusMasks.annulusInner = buildDiscBands(annulusInnerRadius);
+    radiusMasks.annulusOuter = buildDiscBands(annulusOuterRadius);
+
+    masks.push_back(std::move(radiusMasks));
+    // Same id in both paths
+    fillKernel.registerMask(innerRadius, annulusInnerRadius, annulusOuterRadius);
+    return static_cast<int>(masks.size() - 1);
+}
+
+void BubbleScoringContext::clearRadii() {
+    masks.clear();
+    fillKernel.clear();
+}
+
+void BubbleScoringContext::setMethod(ScoringMethod method) {
+    this->method = method;
+}
+
+BubbleScoringContext::ScoringMethod BubbleScoringContext::getMethod() const {
+    return method;
+}
+
+void BubbleScoringContext::prepare(const cv::Mat& sheet) {
+    // Standalone use: buffers of the private context are reused across sheets
+    localContext.reset(sheet);
+    prepare(localContext);
+}
+
+void BubbleScoringContext::prepare(SheetContext& sheet) {
+    integralInk.release();
+    grayView.release();
+    source = nullptr;
+    if (sheet.empty()) {
+        return;
+    }
+
+    // Gray and Otsu come from the shared per-sheet cache
+    grayView = sheet.gray();
+    inkThreshold = sheet.otsuThreshold();
+    source = &sheet;
+
+    if (method == INTEGRAL_LOOKUP) {
+        ensureIntegral();
+    }
+}
+
+void BubbleScoringContext::ensureIntegral() const {
+    if (integralInk.empty() && source) {
+        integralInk = source->inkIntegral();
+    }
+}
+
+bool BubbleScoringContext::isPrepared() const {
+    return !grayView.empty();
+}
+
+long long BubbleScoringContext::sumRect(int x0, int y0, int x1, int y1) const {
+    // Inclusive pixel bounds, already clipped; integral is (rows+1)x(cols+1)
+    const int* top = integralInk.ptr<int>(y0);
+    const int* bottom = integralInk.ptr<int>(y1 + 1);
+    return static_cast<long long>(bottom[x1 + 1]) - top[x1 + 1] - bottom[x0] + top[x0];
+}
+
+long long BubbleScoringContext::sumBands(
+    const cv::Point& center,
+    const std::vector<Band>& bands,
+    long long& area) const {
+
+    int rows = integralInk.rows - 1;
+    int cols = integralInk.cols - 1;
+    long long ink = 0;
+    area = 0;
+
+    for (const Band& band : bands) {
+        int y0 = std::max(0, center.y + band.dyStart);
+        int y1 = std::min(rows - 1, center.y + band.dyEnd);
+        int x0 = std::max(0, center.x - band.halfWidth);
+        int x1 = std::min(cols - 1, center.x + band.halfWidth);
+
+        if (y0 > y1 || x0 > x1) {
+            continue;
+        }
+
+        ink += sumRect(x0, y0, x1, y1);
+        area += static_cast<long long>(y1 - y0 + 1) * (x1 - x0 + 1);
+    }
+
+    return ink;
+}
+
+BubbleScore BubbleScoringContext::score(const cv::Point& center, int maskId) const {
+    BubbleScore result;
+    ensureIntegral();
+    if (integralInk.empty() || maskId < 0 || maskId >= static_cast<int>(masks.size())) {
+        return result;
+    }
+
+    const RadiusMasks& radiusMasks = masks[maskId];
+
+    long long discArea = 0;
+    long long discInk = sumBands(center, radiusMasks.innerDisc, discArea);
+
+    long long holeArea = 0;
+    long long outerArea = 0;
+    long long holeInk = sumBands(center, radiusMasks.annulusInner, holeArea);
+    long long outerInk = sumBands(center, radiusMasks.annulusOuter, outerArea);
+
+    long long ringArea = outerArea - holeArea;
+    long long ringInk = outerInk - holeInk;
+
+    result.fill = discArea > 0 ? static_cast<double>(discInk) / discArea : 0.0;
+    result.background = ringArea > 0 ? static_cast<double>(ringInk) / ringArea : 0.0;
+    result.contrast = result.fill - result.background;
+
+    return result;
+}
+
+void BubbleScoringContext::scoreBatch(
+    const std::vector<cv::Point>& centers,
+    const std::vector<int>& maskIds,
+    std::vector<BubbleScore>& scores) const {
+
+    scores.assign(centers.size(), BubbleScore());
+    if (!isPrepared() || centers.empty() || maskIds.size() != centers.size()) {
+        return;
+    }
+
+    if (method == INTEGRAL_LOOKUP) {
+        for (size_t i = 0; i < centers.size(); i++) {
+            scores[i] = score(centers[i], maskIds[i]);
+        }
+        return;
+    }
+
+    fillBuffer.resize(centers.size());
+    backgroundBuffer.resize(centers.size());
+    fillKernel.scoreBatch(grayView, inkThreshold, centers.data(), maskIds.data(), centers.size(),
+                          fillBuffer.data(), backgroundBuffer.data());
+
+    for (size_t i = 0; i < centers.size(); i++) {
+        scores[i].fill = fillBuffer[i];
+        scores[i].background = backgroundBuffer[i];
+        scores[i].contrast = scores[i].fill - scores[i].background;
+    }
+}
+
+double BubbleScoringContext::inkRatio(const cv::Rect& rect) const {
+    ensureIntegral();
+    if (integralInk.empty()) {
+        return 0.0;
+    }
+
+    cv::Rect bounds(0, 0, integralInk.cols - 1, integralInk.rows - 1);
+    cv::Rect clipped = rect & bounds;
+    if (clipped.area() <= 0) {
+        return 0.0;
+    }
+
+    long long ink = sumRect(clipped.x, clipped.y,
+                            clipped.x + clipped.width - 1, clipped.y + clipped.height - 1);
+    return static_cast<double>(ink) / clipped.area();
+}
+
+int BubbleScoringContext::getInkThreshold() const {
+    return inkThreshold;
+}
@@ -1,4 +1,5 @@
 #include "HandwritingDetector.h"
+#include "Tracer.h"
 #include <iostream>
 
 HandwritingDetector::HandwritingDetector(double minDensity)
@@ -13,31 +14,11 @@ HandwritingDetector::HandwritingDetector(double minDensity)
     preprocessingKernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(2, 2));
 }
 
-cv::Mat HandwritingDetector::preprocessForDetection(const cv::Mat& roi) {
-    cv::Mat processed;
-    
-    // Convert to grayscale if needed
-    if (roi.channels() == 3) {
-        cv::cvtColor(roi, processed, cv::COLOR_BGR2GRAY);
-    } else {
-        processed = roi.clone();
-    }
-    
-    // Apply Gaussian blur to reduce noise
-    cv::GaussianBlur(processed, processed, cv::Size(3, 3), 0);
-    
-    // Apply adaptive threshold
-    cv::adaptiveThreshold(
-        processed, processed, 255,
-        cv::ADAPTIVE_THRESH_GAUSSIAN_C,
-        cv::THRESH_BINARY_INV,
-        11, 2
-    );
-    
-    // Remove small noise with morphological opening
-    cv::morphologyEx(processed, processed, cv::MORPH_OPEN, preprocessingKernel);
-    
-    return processed;
+cv::Mat HandwritingDetector::preprocessForDetection(SheetContext& sheet, const cv::Rect& region) {
+    // Gray -> 3x3 Gaussian -> adaptive (11, 2) come from the sheet cache, computed once per sheet;
+    // only the opening that removes small noise is done per region
+    cv::morphologyEx(sheet.adaptiveBinary()(region), openedBuffer, cv::MORPH_OPEN, preprocessingKernel);
+    return openedBuffer;
 }
 
 double HandwritingDetector::analyzePixelDensity(const cv::Mat& roi) {
@@ -57,12 +38,12 @@ double HandwritingDetector::analyzePixelDensity(const cv::Mat& roi) {
 int HandwritingDetector::countEdgePixels(const cv::Mat& roi) {
     cv::Mat edges;
     
-    // Convert to grayscale if needed
+    // Convert to grayscale if needed (Canny only reads, no copy for gray input)
     cv::Mat gray;
     if (roi.channels() == 3) {
         cv::cvtColor(roi, gray, cv::COLOR_BGR2GRAY);
     } else {
-        gray = roi.clone();
+        gray = roi;
     }
     
     // Apply Canny edge detection
@@ -102,29 +83,49 @@ bool HandwritingDetector::hasConnectedComponents(const cv::Mat& roi) {
 }
 
 double HandwritingDetector::calculatePixelDensity(const cv::Mat& roi) {
-    cv::Mat processed = preprocessForDetection(roi);
+    if (roi.empty()) {
+        return 0.0;
+    }
+    
+    SheetContext roiContext(roi);
+    cv::Mat processed = preprocessForDetection(roiContext, cv::Rect(0, 0, roi.cols, roi.rows));
     return analyzePixelDensity(processed);
 }
 
+bool HandwritingDetector::isInside(const cv::Size& size, const cv::Rect& region) {
+    return region.x >= 0 && region.y >= 0 &&
+           region.x + region.width <= size.width &&
+           region.y + region.height <= size.height;
+}
+
 bool HandwritingDetector::hasHandwriting(const cv::Mat& image, const cv::Rect& region) {
     // Validate region
-    if (region.x < 0 || region.y < 0 ||
-        region.x + region.width > image.cols ||
-        region.y + region.height > image.rows) {
+    if (!isInside(image.size(), region)) {
         std::cerr << "Uyarı: Geçersiz bölge koordinatları" << std::endl;
         return false;
     }
     
-    // Extract ROI
-    cv::Mat roi = image(region);
+    // Single region: preprocess only the ROI, as before
+    SheetContext roiContext(image(region));
+    return hasHandwriting(roiContext, cv::Rect(0, 0, region.width, region.height));
+}
+
+bool HandwritingDetector::hasHandwriting(SheetContext& sheet, const cv::Rect& region) {
+    OMR_TRACE_SCOPE("HandwritingDetector::hasHandwriting");
     
-    if (roi.empty()) {
+    // Validate region
+    if (!isInside(sheet.size(), region)) {
+        std::cerr << "Uyarı: Geçersiz bölge koordinatları" << std::endl;
+        return false;
+    }
+    
+    if (region.area() <= 0) {
         std::cout << "[DEBUG] ROI boş!" << std::endl;
         return false;
     }
     
     // Preprocess ROI
-    cv::Mat processed = preprocessForDetection(roi);
+    cv::Mat processed = preprocessForDetection(sheet, region);
     
     // Calculate pixel density
     double density = analyzePixelDensity(processed);
@@ -165,6 +166,16 @@ cv::Mat HandwritingDetector::extractHandwritingROI(const cv::Mat& image, const c
     return roi;
 }
 
+cv::Mat HandwritingDetector::extractHandwritingROI(SheetContext& sheet, const cv::Rect& region) {
+    // Validate region
+    if (!isInside(sheet.size(), region)) {
+        throw std::runtime_error("Geçersiz bölge koordinatları!");
+    }
+    
+    // Gray is already computed for the sheet; the copy keeps the crop independent of it
+    return sheet.gray()(region).clone();
+}
+
 void HandwritingDetector::setMinDensity(double density) {
     if (density >= 0.0 && density <= 1.0) {
         minimumPixelDensity = density;
@@ -176,9 +187,10 @@ std::vector<cv::Rect> HandwritingDetector::detectHandwritingRegions(
     const std::vector<cv::Rect>& searchRegions) {
     
     std::vector<cv::Rect> handwritingRegions;
+    SheetContext sheet(image);
     
     for (const auto& region : searchRegions) {
-        if (hasHandwriting(image, region)) {
+        if (hasHandwriting(sheet, region)) {
             handwritingRegions.push_back(region);
         }
     }
@@ -191,29 +203,33 @@ double HandwritingDetector::detectHandwritingConfidence(
     const cv::Rect& region) {
     
     // Validate region
-    if (region.x < 0 || region.y < 0 ||
-        region.x + region.width > image.cols ||
-        region.y + region.height > image.rows) {
+    if (!isInside(image.size(), region)) {
         return 0.0;
     }
     
-    // Extract ROI
-    cv::Mat roi = image(region);
+    SheetContext roiContext(image(region));
+    return detectHandwritingConfidence(roiContext, cv::Rect(0, 0, region.width, region.height));
+}
+
+double HandwritingDetector::detectHandwritingConfidence(
+    SheetContext& sheet,
+    const cv::Rect& region) {
     
-    if (roi.empty()) {
+    // Validate region
+    if (!isInside(sheet.size(), region) || region.area() <= 0) {
         return 0.0;
     }
     
     // Preprocess
-    cv::Mat processed = preprocessForDetection(roi);
+    cv::Mat processed = preprocessForDetection(sheet, region);
     
     // Calculate pixel density (weight: 0.4)
     double density = analyzePixelDensity(processed);
     double densityScore = std::min(density / 0.2, 1.0) * 0.4;
     
     // Calculate edge density (weight: 0.3)
-    int edgePixels = countEdgePixels(roi);
-    double edgeDensity = static_cast<double>(edgePixels) / roi.total();
+    int edgePixels = countEdgePixels(sheet.gray()(region));
+    double edgeDensity = static_cast<double>(edgePixels) / region.area();
     double edgeScore = std::min(edgeDensity / 0.15, 1.0) * 0.3;
     
     // Check connected components (weight: 0.3)
@@ -0,0 +1,351 @@
+#include "SheetTemplate.h"
+#include "BubbleSampler.h"
+#include <iostream>
+#include <set>
+
+namespace {
+
+int readInt(const cv::FileNode& node, const char* key, int defaultValue) {
+    cv::FileNode value = node[key];
+    return value.empty() ? defaultValue : static_cast<int>(value);
+}
+
+} // namespace
+
+SheetTemplate::SheetTemplate()
+    : name("default"), sheetWidth(850), sheetHeight(1100), markers(true), markerInset(25) {
+}
+
+SheetTemplate SheetTemplate::createDefault(int sheetWidth, int sheetHeight) {
+    SheetTemplate sheetTemplate;
+    sheetTemplate.sheetWidth = sheetWidth;
+    sheetTemplate.sheetHeight = sheetHeight;
+
+    // 10 multiple choice, questions 1-10: y = 100 + i * 50, 40 px tall
+    TemplateBlock multipleChoice;
+    multipleChoice.type = QuestionRegion::MULTIPLE_CHOICE;
+    multipleChoice.rows = 10;
+    multipleChoice.x = 50;
+    multipleChoice.y = 100;
+    multipleChoice.rowHeight = 40;
+    multipleChoice.rowSpacing = 10;
+    multipleChoice.options = 5;
+    sheetTemplate.blocks.push_back(multipleChoice);
+
+    // 5 fill-in-the-blank, questions 11-15: y = 500 + i * 70, 60 px tall
+    TemplateBlock fillInBlank;
+    fillInBlank.type = QuestionRegion::FILL_IN_BLANK;
+    fillInBlank.firstQuestion = 11;
+    fillInBlank.rows = 5;
+    fillInBlank.x = 50;
+    fillInBlank.y = 500;
+    fillInBlank.rowHeight = 60;
+    fillInBlank.rowSpacing = 10;
+    sheetTemplate.blocks.push_back(fillInBlank);
+
+    // 5 true/false, questions 16-20: y = 50 + i * 50, 40 px tall
+    TemplateBlock trueFalse;
+    trueFalse.type = QuestionRegion::TRUE_FALSE;
+    trueFalse.firstQuestion = 16;
+    trueFalse.rows = 5;
+    trueFalse.x = 50;
+    trueFalse.y = 50;
+    trueFalse.rowHeight = 40;
+    trueFalse.rowSpacing = 10;
+    trueFalse.options = 2;
+    sheetTemplate.blocks.push_back(trueFalse);
+
+    sheetTemplate.compile();
+    return sheetTemplate;
+}
+
+const char* SheetTemplate::typeName(QuestionRegion::Type type) {
+    switch (type) {
+        case QuestionRegion::MULTIPLE_CHOICE:
+            return "MULTIPLE_CHOICE";
+        case QuestionRegion::FILL_IN_BLANK:
+            return "FILL_IN_BLANK";
+        case QuestionRegion::TRUE_FALSE:
+            return "TRUE_FALSE";
+    }
+    return "MULTIPLE_CHOICE";
+}
+
+bool SheetTemplate::parseType(const std::string& name, QuestionRegion::Type& type) {
+    // Short forms match the answer key file (MC / FILL / TF)
+    if (name == "MULTIPLE_CHOICE" || name == "MC") {
+        type = QuestionRegion::MULTIPLE_CHOICE;
+    } else if (name == "FILL_IN_BLANK" || name == "FILL") {
+        type = QuestionRegion::FILL_IN_BLANK;
+    } else if (name == "TRUE_FALSE" || name == "TF") {
+        type = QuestionRegion::TRUE_FALSE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool SheetTemplate::validateBlock(const TemplateBlock& block, size_t index) const {
+    int width = block.width > 0 ? block.width : sheetWidth - 2 * block.x;
+
+    if (block.rows <= 0 || block.columns <= 0 || block.rowHeight <= 0 || width <= 0) {
+        std::cerr << "HATA: Şablon bloğu " << index << " geçersiz boyutlara sahip" << std::endl;
+        return false;
+    }
+    if (block.type == QuestionRegion::MULTIPLE_CHOICE && block.options < 2) {
+        std::cerr << "HATA: Şablon bloğu " << index << " en az 2 seçenek içermeli" << std::endl;
+        return false;
+    }
+    if (block.bubbleRadius < 0) {
+        std::cerr << "HATA: Şablon bloğu " << index << " negatif balon yarıçapı" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SheetTemplate::loadFromFile(const std::string& filename) {
+    SheetTemplate loaded;
+
+    try {
+        cv::FileStorage fs(filename, cv::FileStorage::READ);
+        if (!fs.isOpened()) {
+            std::cerr << "Şablon dosyası açılamadı: " << filename << std::endl;
+            return false;
+        }
+
+        cv::FileNode root = fs.root();
+        if (!fs["name"].empty()) {
+            loaded.name = static_cast<std::string>(fs["name"]);
+        }
+        loaded.sheetWidth = readInt(root, "sheetWidth", 850);
+        loaded.sheetHeight = readInt(root, "sheetHeight", 1100);
+        loaded.markers = readInt(root, "markers", 1) != 0;
+        loaded.markerInset = readInt(root, "markerInset", 25);
+
+        cv::FileNode blockNodes = fs["blocks"];
+        if (!blockNodes.isSeq() || blockNodes.size() == 0) {
+            std::cerr << "HATA: Şablonda 'blocks' listesi yok: " << filename << std::endl;
+            return false;
+        }
+
+        for (cv::FileNodeIterator it = blockNodes.begin(); it != blockNodes.end(); ++it) {
+            cv::FileNode node = *it;
+            TemplateBlock block;
+
+            std::string typeText = static_cast<std::string>(node["type"]);
+            if (!parseType(typeText, block.type)) {
+                std::cerr << "HATA: Bilinmeyen soru tipi: '" << typeText << "'" << std::endl;
+                return false;
+            }
+
+            int defaultOptions = block.type == QuestionRegion::MULTIPLE_CHOICE ? 5 :
+                                 (block.type == QuestionRegion::TRUE_FALSE ? 2 : 0);
+
+            block.firstQuestion = readInt(node, "firstQuestion", 1);
+            block.rows = readInt(node, "rows", 0);
+            block.columns = readInt(node, "columns", 1);
+            block.x = readInt(node, "x", 0);
+            block.y = readInt(node, "y", 0);
+            block.width = readInt(node, "width", 0);
+            block.rowHeight = readInt(node, "rowHeight", 0);
+            block.rowSpacing = readInt(node, "rowSpacing", 0);
+            block.columnSpacing = readInt(node, "columnSpacing", 0);
+            block.options = readInt(node, "options", defaultOptions);
+            block.bubbleRadius = readInt(node, "bubbleRadius", 0);
+
+            if (!loaded.validateBlock(block, loaded.blocks.size())) {
+                return false;
+            }
+            loaded.blocks.push_back(block);
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "HATA: Şablon okunamadı (" << filename << "): " << e.what() << std::endl;
+        return false;
+    }
+
+    loaded.compile();
+    *this = std::move(loaded);
+
+    std::cout << "Şablon yüklendi: " << name << " (" << layout.regionCount() << " soru, "
+              << layout.bubbleCount() << " balon)" << std::endl;
+    return true;
+}
+
+bool SheetTemplate::saveToFile(const std::string& filename) const {
+    try {
+        cv::FileStorage fs(filename, cv::FileStorage::WRITE);
+        if (!fs.isOpened()) {
+            std::cerr << "Şablon dosyası yazılamadı: " << filename << std::endl;
+            return false;
+        }
+
+        fs << "name" << name;
+        fs << "sheetWidth" << sheetWidth;
+        fs << "sheetHeight" << sheetHeight;
+        fs << "markers" << (markers ? 1 : 0);
+        fs << "markerInset" << markerInset;
+        fs << "blocks" << "[";
+        for (const auto& block : blocks) {
+            fs << "{";
+            fs << "type" << typeName(block.type);
+            fs << "firstQuestion" << block.firstQuestion;
+            fs << "rows" << block.rows;
+            fs << "columns" << block.columns;
+            fs << "x" << block.x;
+            fs << "y" << block.y;
+            fs << "width" << block.width;
+            fs << "rowHeight" << block.rowHeight;
+            fs << "rowSpacing" << block.rowSpacing;
+            fs << "columnSpacing" << block.columnSpacing;
+            fs << "options" << block.options;
+            fs << "bubbleRadius" << block.bubbleRadius;
+            fs << "}";
+        }
+        fs << "]";
+    } catch (const cv::Exception& e) {
+        std::cerr << "HATA: Şablon yazılamadı (" << filename << "): " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void SheetTemplate::addBlock(const TemplateBlock& block) {
+    if (!validateBlock(block, blocks.size())) {
+        return;
+    }
+    blocks.push_back(block);
+    compile();
+}
+
+void SheetTemplate::clear() {
+    blocks.clear();
+    compile();
+}
+
+void SheetTemplate::compile() {
+    layout = CompiledSheetLayout();
+
+    std::vector<cv::Point> centers;
+
+    for (const auto& block : blocks) {
+        int width = block.width > 0 ? block.width : sheetWidth - 2 * block.x;
+        int options = 0;
+        if (block.type == QuestionRegion::MULTIPLE_CHOICE) {
+            options = block.options;
+        } else if (block.type == QuestionRegion::TRUE_FALSE) {
+            options = 2;
+        }
+
+        // Column-major: down the first column, then the next one
+        for (int column = 0; column < block.columns; column++) {
+            for (int row = 0; row < block.rows; row++) {
+                cv::Rect rect(
+                    block.x + column * (width + block.columnSpacing),
+                    block.y + row * (block.rowHeight + block.rowSpacing),
+                    width,
+                    block.rowHeight
+                );
+
+                layout.questionNumber.push_back(block.firstQuestion + column * block.rows + row);
+                layout.type.push_back(static_cast<uint8_t>(block.type));
+                layout.regionX.push_back(rect.x);
+                layout.regionY.push_back(rect.y);
+                layout.regionWidth.push_back(rect.width);
+                layout.regionHeight.push_back(rect.height);
+                layout.optionCount.push_back(options);
+                layout.firstBubble.push_back(static_cast<int>(layout.bubbleX.size()));
+
+                int radius = 0;
+                BubbleSampler::computeBubbleGeometry(rect, options, centers, radius);
+                if (block.bubbleRadius > 0) {
+                    radius = block.bubbleRadius;
+                }
+
+                for (const auto& center : centers) {
+                    layout.bubbleX.push_back(center.x);
+                    layout.bubbleY.push_back(center.y);
+                    layout.bubbleRadius.push_back(radius);
+                }
+            }
+        }
+    }
+
+    // Answers are keyed by question number; overlapping blocks would overwrite each other
+    std::set<int> seen;
+    for (int questionNumber : layout.questionNumber) {
+        if (!seen.insert(questionNumber).second) {
+            std::cerr << "Uyarı: şablonda soru " << questionNumber
+                      << " birden fazla bölgede; blokların firstQuestion değerlerini kontrol edin" << std::endl;
+        }
+    }
+}
+
+std::vector<QuestionRegion> SheetTemplate::buildRegions(const cv::Size& imageSize) const {
+    std::vector<QuestionRegion> regions;
+    regions.reserve(layout.regionCount());
+
+    for (size_t i = 0; i < layout.regionCount(); i++) {
+        // Validate region
+        if (layout.regionY[i] + layout.regionHeight[i] > imageSize.height ||
+            layout.regionX[i] + layout.regionWidth[i] > imageSize.width) {
+            std::cerr << "Uyarı: Soru " << layout.questionNumber[i] << " bölgesi görüntü dışında ("
+                      << imageSize.width << "x" << imageSize.height << "), atlandı" << std::endl;
+            continue;
+        }
+
+        regions.emplace_back(
+            layout.questionNumber[i],
+            layout.regionRect(i),
+            static_cast<QuestionRegion::Type>(layout.type[i]),
+            layout.optionCount[i],
+            static_cast<int>(i)
+        );
+    }
+
+    return regions;
+}
+
+const std::string& SheetTemplate::getName() const {
+    return name;
+}
+
+void SheetTemplate::setName(const std::string& name) {
+    this->name = name;
+}
+
+int SheetTemplate::getSheetWidth() const {
+    return sheetWidth;
+}
+
+int SheetTemplate::getSheetHeight() const {
+    return sheetHeight;
+}
+
+bool SheetTemplate::hasMarkers() const {
+    return markers;
+}
+
+int SheetTemplate::getMarkerInset() const {
+    return markerInset;
+}
+
+void SheetTemplate::setMarkers(bool markers, int markerInset) {
+    this->markers = markers;
+    this->markerInset = markerInset;
+}
+
+void SheetTemplate::setSheetDimensions(int sheetHeight, int sheetWidth) {
+    this->sheetHeight = sheetHeight;
+    this->sheetWidth = sheetWidth;
+    // Blocks with width <= 0 follow the sheet width
+    compile();
+}
+
+const std::vector<TemplateBlock>& SheetTemplate::getBlocks() const {
+    return blocks;
+}
+
+const CompiledSheetLayout& SheetTemplate::getLayout() const {
+    return layout;
+}
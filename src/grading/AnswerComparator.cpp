@@ -77,6 +77,10 @@ void AnswerComparator::setCaseSensitive(bool sensitive) {
     caseSensitive = sensitive;
 }
 
+bool AnswerComparator::isCaseSensitive() const {
+    return caseSensitive;
+}
+
 double AnswerComparator::calculateTextSimilarity(const std::string& text1,
                                                  const std::string& text2) const {
     std::string norm1 = normalizeText(text1);
@@ -1,8 +1,30 @@
 #include "AnswerKey.h"
+#include <atomic>
 #include <fstream>
 #include <iostream>
 
-AnswerKey::AnswerKey() {
+namespace {
+
+// Process-wide, so two keys never share a revision and a compiled key cannot match another key
+uint64_t nextRevision() {
+    static std::atomic<uint64_t> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace
+
+AnswerKey::AnswerKey() : revision(nextRevision()) {
+}
+
+AnswerKey::AnswerKey(const AnswerKey& other) : answers(other.answers), revision(nextRevision()) {
+}
+
+AnswerKey& AnswerKey::operator=(const AnswerKey& other) {
+    if (this != &other) {
+        answers = other.answers;
+        revision = nextRevision();
+    }
+    return *this;
 }
 
 void AnswerKey::addMultipleChoiceAnswer(int questionNum, int correctOption) {
@@ -13,6 +35,7 @@ void AnswerKey::addMultipleChoiceAnswer(int questionNum, int correctOption) {
     ans.textAnswer = "";
     
     answers[questionNum] = ans;
+    revision = nextRevision();
 }
 
 void AnswerKey::addFillInBlankAnswer(int questionNum, const std::string& correctText) {
@@ -23,6 +46,7 @@ void AnswerKey::addFillInBlankAnswer(int questionNum, const std::string& correct
     ans.textAnswer = correctText;
     
     answers[questionNum] = ans;
+    revision = nextRevision();
 }
 
 void AnswerKey::addTrueFalseAnswer(int questionNum, bool isTrue) {
@@ -33,6 +57,7 @@ void AnswerKey::addTrueFalseAnswer(int questionNum, bool isTrue) {
     ans.textAnswer = "";
     
     answers[questionNum] = ans;
+    revision = nextRevision();
 }
 
 Answer AnswerKey::getAnswer(int questionNum) const {
@@ -129,4 +154,13 @@ bool AnswerKey::saveToFile(const std::string& filename) const {
 
 void AnswerKey::clear() {
     answers.clear();
+    revision = nextRevision();
+}
+
+const std::map<int, Answer>& AnswerKey::getAnswers() const {
+    return answers;
+}
+
+uint64_t AnswerKey::getRevision() const {
+    return revision;
 }
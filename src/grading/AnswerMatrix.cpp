@@ -0,0 +1,60 @@
+#include "AnswerMatrix.h"
+
+AnswerMatrix::AnswerMatrix() : studentCount(0), questionCount(0), keyRevision(0) {
+}
+
+AnswerMatrix::AnswerMatrix(size_t studentCount, size_t questionCount)
+    : studentCount(0), questionCount(0), keyRevision(0) {
+    resize(studentCount, questionCount);
+}
+
+AnswerMatrix::AnswerMatrix(const AnswerMatrix& other)
+    : studentCount(other.studentCount), questionCount(other.questionCount),
+      codes(other.codes), keyRevision(other.getKeyRevision()) {
+}
+
+AnswerMatrix& AnswerMatrix::operator=(const AnswerMatrix& other) {
+    studentCount = other.studentCount;
+    questionCount = other.questionCount;
+    codes = other.codes;
+    keyRevision.store(other.getKeyRevision(), std::memory_order_relaxed);
+    return *this;
+}
+
+void AnswerMatrix::resize(size_t studentCount, size_t questionCount) {
+    this->studentCount = studentCount;
+    this->questionCount = questionCount;
+    codes.assign(studentCount * questionCount, BLANK);
+    keyRevision.store(0, std::memory_order_relaxed);
+}
+
+bool AnswerMatrix::claimKeyRevision(uint64_t revision) {
+    uint64_t expected = 0;
+    if (keyRevision.compare_exchange_strong(expected, revision, std::memory_order_relaxed)) {
+        return true;
+    }
+    return expected == revision;
+}
+
+uint8_t AnswerMatrix::optionCode(int option) {
+    if (option < 0 || option >= MAX_OPTIONS) {
+        return BLANK;
+    }
+    return static_cast<uint8_t>(1u << option);
+}
+
+uint8_t AnswerMatrix::markCode(const std::vector<int>& markedOptions) {
+    uint8_t code = BLANK;
+    for (int option : markedOptions) {
+        code |= optionCode(option);
+    }
+    return code;
+}
+
+size_t AnswerMatrix::getStudentCount() const {
+    return studentCount;
+}
+
+size_t AnswerMatrix::getQuestionCount() const {
+    return questionCount;
+}
@@ -0,0 +1,336 @@
+#include "BatchGrader.h"
+#include "SheetGrader.h"
+#include "AnswerComparator.h"
+#include "MetricsRegistry.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool isImageFile(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    return ext == ".jpg" || ext == ".jpeg" || ext == ".png" ||
+           ext == ".bmp" || ext == ".tif" || ext == ".tiff";
+}
+
+struct BatchMetrics {
+    Histogram& load;
+    Histogram& scoring;
+    Histogram& sheet;
+    Counter& gradedSheets;
+    Counter& failedSheets;
+    Gauge& sheetsPerSecond;
+    Gauge& queueDepth;
+
+    static BatchMetrics& instance() {
+        static BatchMetrics metrics(MetricsRegistry::instance());
+        return metrics;
+    }
+
+    explicit BatchMetrics(MetricsRegistry& registry)
+        : load(registry.stageLatency("load")),
+          scoring(registry.stageLatency("scoring")),
+          sheet(registry.stageLatency("sheet")),
+          gradedSheets(registry.counter("omr_sheets_total", "Sheets processed, by outcome", "result=\"ok\"")),
+          failedSheets(registry.counter("omr_sheets_total", "Sheets processed, by outcome", "result=\"failed\"")),
+          sheetsPerSecond(registry.gauge("omr_sheets_per_second", "Sheets completed per second since the batch started")),
+          queueDepth(registry.gauge("omr_queue_depth", "Sheets waiting for a worker")) {
+    }
+};
+
+} // namespace
+
+BatchGrader::BatchGrader(const AnswerKey& answerKey, const BatchOptions& options)
+    : answerKey(answerKey), options(options), submittedCount(0), stopping(false) {
+
+    if (this->options.numWorkers <= 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        this->options.numWorkers = hardwareThreads > 0 ? static_cast<int>(hardwareThreads) : 1;
+    }
+}
+
+BatchGrader::~BatchGrader() {
+    stopWorkers();
+}
+
+std::vector<std::string> BatchGrader::collectImagePaths(const std::string& directoryOrManifest) {
+    std::vector<std::string> paths;
+    fs::path input(directoryOrManifest);
+
+    std::error_code ec;
+    if (fs::is_directory(input, ec)) {
+        for (const auto& entry : fs::directory_iterator(input, ec)) {
+            if (entry.is_regular_file() && isImageFile(entry.path())) {
+                paths.push_back(entry.path().string());
+            }
+        }
+
+        // Deterministic order regardless of filesystem
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+
+    // Manifest: one image path per line, '#' comments, paths relative to the manifest
+    std::ifstream manifest(directoryOrManifest);
+    if (!manifest.is_open()) {
+        std::cerr << "Toplu giriş açılamadı: " << directoryOrManifest << std::endl;
+        return paths;
+    }
+
+    fs::path baseDir = input.parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        // Trim whitespace (and CR of Windows line endings)
+        line.erase(0, line.find_first_not_of(" \t\r\n"));
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        fs::path imagePath(line);
+        if (imagePath.is_relative()) {
+            imagePath = baseDir / imagePath;
+        }
+        paths.push_back(imagePath.string());
+    }
+
+    return paths;
+}
+
+void BatchGrader::setResultCallback(ResultCallback callback) {
+    resultCallback = std::move(callback);
+}
+
+int BatchGrader::getWorkerCount() const {
+    return options.numWorkers;
+}
+
+OCRPoolStats BatchGrader::getOCRPoolStats() const {
+    return enginePool ? enginePool->getStats() : OCRPoolStats();
+}
+
+bool BatchGrader::start() {
+    if (!workers.empty()) {
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = false;
+        submittedCount = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        completedResults.clear();
+        batchStartTime = std::chrono::steady_clock::now();
+    }
+
+    // The template is parsed and compiled once; workers copy the finished tables
+    if (!enginePool && !options.templatePath.empty()) {
+        if (!sheetTemplate.loadFromFile(options.templatePath)) {
+            std::cerr << "HATA: Kağıt şablonu yüklenemedi: " << options.templatePath << std::endl;
+            return false;
+        }
+    }
+
+    // One compiled key for every worker; recompiled per start() so key edits between runs apply
+    compiledKey = CompiledAnswerKey::compile(answerKey);
+
+    // Engines are created once and reused by every start()/finish() cycle
+    if (!enginePool) {
+        OCREngineConfig config;
+        config.language = options.language;
+        enginePool = std::make_unique<OCREnginePool>(static_cast<size_t>(options.numWorkers), config);
+    }
+
+    if (!enginePool->isInitialized()) {
+        std::cerr << "HATA: Hiçbir worker için OCR başlatılamadı!" << std::endl;
+        return false;
+    }
+
+    int engineCount = static_cast<int>(enginePool->size());
+    if (engineCount < options.numWorkers) {
+        std::cerr << "Uyarı: " << (options.numWorkers - engineCount) << " worker OCR başlatamadı, "
+                  << engineCount << " worker ile devam ediliyor" << std::endl;
+        options.numWorkers = engineCount;
+    }
+
+    // Each worker holds its engine for its whole lifetime (TessBaseAPI is not thread-safe)
+    for (int i = 0; i < options.numWorkers; i++) {
+        workers.emplace_back(&BatchGrader::workerLoop, this, enginePool->checkout());
+    }
+
+    return true;
+}
+
+void BatchGrader::enqueue(SheetJob job) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        job.index = submittedCount++;
+        pendingJobs.push_back(std::move(job));
+        BatchMetrics::instance().queueDepth.set(static_cast<double>(pendingJobs.size()));
+    }
+    queueCondition.notify_one();
+}
+
+void BatchGrader::submitFile(const std::string& imagePath) {
+    SheetJob job;
+    job.sheetId = imagePath;
+    job.imagePath = imagePath;
+    enqueue(std::move(job));
+}
+
+void BatchGrader::submitImage(const std::string& sheetId, const cv::Mat& image) {
+    SheetJob job;
+    job.sheetId = sheetId;
+    job.image = image;
+    enqueue(std::move(job));
+}
+
+void BatchGrader::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers.clear();
+}
+
+std::vector<SheetResult> BatchGrader::finish() {
+    // Workers drain the queue before exiting
+    stopWorkers();
+
+    std::vector<std::pair<size_t, SheetResult>> collected;
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        collected.swap(completedResults);
+    }
+
+    // Return results in submission order
+    std::sort(collected.begin(), collected.end(),
+              [](const std::pair<size_t, SheetResult>& a, const std::pair<size_t, SheetResult>& b) {
+                  return a.first < b.first;
+              });
+
+    std::vector<SheetResult> results;
+    results.reserve(collected.size());
+    for (auto& entry : collected) {
+        results.push_back(std::move(entry.second));
+    }
+
+    return results;
+}
+
+std::vector<SheetResult> BatchGrader::gradeFiles(const std::vector<std::string>& imagePaths) {
+    if (!start()) {
+        return {};
+    }
+
+    for (const auto& path : imagePaths) {
+        submitFile(path);
+    }
+
+    return finish();
+}
+
+void BatchGrader::workerLoop(OCREnginePool::Lease engine) {
+    OMR_TRACE_THREAD_NAME("batch-worker");
+    BatchMetrics& metrics = BatchMetrics::instance();
+
+    SheetGrader sheetGrader(*engine);
+    sheetGrader.setVerbose(false);
+    sheetGrader.setWarpMode(options.grayWarp ? PerspectiveCorrector::WARP_GRAY : PerspectiveCorrector::WARP_COLOR);
+    sheetGrader.setRegionWarp(options.regionWarp);
+    if (!options.templatePath.empty()) {
+        sheetGrader.setTemplate(sheetTemplate);
+    }
+
+    AnswerComparator comparator(false);
+    ScoreCalculator scoreCalculator(answerKey, comparator);
+    scoreCalculator.setCompiledKey(compiledKey);
+    scoreCalculator.setPartialCreditEnabled(options.partialCreditEnabled);
+    scoreCalculator.setPartialCreditThreshold(options.partialCreditThreshold);
+
+    while (true) {
+        SheetJob job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() {
+                return stopping || !pendingJobs.empty();
+            });
+
+            if (pendingJobs.empty()) {
+                return; // stopping and fully drained
+            }
+
+            job = std::move(pendingJobs.front());
+            pendingJobs.pop_front();
+            metrics.queueDepth.set(static_cast<double>(pendingJobs.size()));
+        }
+
+        SheetResult result;
+        result.sheetId = job.sheetId;
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        try {
+            OMR_TRACE_SCOPE_ARG("BatchGrader::sheet", "index", job.index);
+            
+            cv::Mat image = job.image;
+            if (image.empty()) {
+                OMR_TRACE_SCOPE("cv::imread");
+                ScopedLatency timer(metrics.load);
+                image = cv::imread(job.imagePath);
+            }
+
+            if (image.empty()) {
+                result.errorMessage = "Görüntü yüklenemedi";
+            } else {
+                result.studentAnswers = sheetGrader.processSheet(image);
+                {
+                    ScopedLatency timer(metrics.scoring);
+                    result.score = scoreCalculator.calculateScore(result.studentAnswers);
+                }
+                result.success = true;
+            }
+        } catch (const std::exception& e) {
+            result.errorMessage = e.what();
+        }
+
+        auto endTime = std::chrono::steady_clock::now();
+        result.processingMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        metrics.sheet.observe(result.processingMs / 1000.0);
+        (result.success ? metrics.gradedSheets : metrics.failedSheets).increment();
+
+        // Streaming consumers (camera session) see each result without waiting for finish()
+        if (resultCallback) {
+            resultCallback(job.index, result);
+        }
+
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        completedResults.emplace_back(job.index, std::move(result));
+
+        double elapsedSeconds = std::chrono::duration<double>(endTime - batchStartTime).count();
+        if (elapsedSeconds > 0.0) {
+            metrics.sheetsPerSecond.set(completedResults.size() / elapsedSeconds);
+        }
+    }
+}
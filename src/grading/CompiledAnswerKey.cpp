@@ -0,0 +1,118 @@
+#include "CompiledAnswerKey.h"
+#include "AnswerMatrix.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+// Trim and lower-case exactly like AnswerComparator::normalizeText
+std::string trimText(const std::string& text) {
+    auto start = std::find_if_not(text.begin(), text.end(), isSpace);
+    auto end = std::find_if_not(text.rbegin(), text.rend(), isSpace).base();
+    return (start < end) ? std::string(start, end) : std::string();
+}
+
+std::string foldText(const std::string& text) {
+    std::string folded = text;
+    std::transform(folded.begin(), folded.end(), folded.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return folded;
+}
+
+} // namespace
+
+CompiledAnswerKey::CompiledAnswerKey(const AnswerKey& answerKey)
+    : revision(answerKey.getRevision()), answerCount(answerKey.getTotalQuestions()) {
+
+    const std::map<int, Answer>& answers = answerKey.getAnswers();
+
+    // Dense up to the highest question number; gaps are tagged NO_ANSWER
+    int highest = answers.empty() ? 0 : std::max(0, answers.rbegin()->first);
+    size_t count = static_cast<size_t>(highest);
+    types.assign(count, NO_ANSWER);
+    selectedOptions.assign(count, -1);
+    optionCodes.assign(count, AnswerMatrix::BLANK);
+    texts.resize(count);
+    trimmedTexts.resize(count);
+    foldedTexts.resize(count);
+
+    for (const auto& pair : answers) {
+        if (pair.first < 1) {
+            continue;   // not addressable by index
+        }
+        size_t index = static_cast<size_t>(pair.first - 1);
+        const Answer& answer = pair.second;
+
+        types[index] = static_cast<uint8_t>(answer.type);
+        selectedOptions[index] = answer.selectedOption;
+
+        if (answer.type == Answer::FILL_IN_BLANK) {
+            optionCodes[index] = AnswerMatrix::TEXT_MATCH;
+            texts[index] = answer.textAnswer;
+            trimmedTexts[index] = trimText(answer.textAnswer);
+            foldedTexts[index] = foldText(trimmedTexts[index]);
+        } else {
+            optionCodes[index] = AnswerMatrix::optionCode(answer.selectedOption);
+        }
+    }
+}
+
+std::shared_ptr<const CompiledAnswerKey> CompiledAnswerKey::compile(const AnswerKey& answerKey) {
+    return std::make_shared<const CompiledAnswerKey>(answerKey);
+}
+
+bool CompiledAnswerKey::matches(size_t index, const Answer& studentAnswer, bool caseSensitive) const {
+    if (!hasAnswer(index) || studentAnswer.type != getType(index) ||
+        studentAnswer.questionNumber != static_cast<int>(index) + 1) {
+        return false;
+    }
+
+    if (studentAnswer.type == Answer::FILL_IN_BLANK) {
+        return matchesText(index, studentAnswer.textAnswer, caseSensitive);
+    }
+    return studentAnswer.selectedOption == selectedOptions[index];
+}
+
+bool CompiledAnswerKey::matchesText(size_t index, const std::string& studentText, bool caseSensitive) const {
+    // Trim the student text by bounds instead of copying it
+    size_t begin = 0;
+    size_t end = studentText.size();
+    while (begin < end && isSpace(studentText[begin])) {
+        begin++;
+    }
+    while (end > begin && isSpace(studentText[end - 1])) {
+        end--;
+    }
+
+    const std::string& expected = caseSensitive ? trimmedTexts[index] : foldedTexts[index];
+    if (end - begin != expected.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < expected.size(); i++) {
+        char c = studentText[begin + i];
+        if (!caseSensitive) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        if (c != expected[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Answer CompiledAnswerKey::toAnswer(size_t index) const {
+    Answer answer;
+    if (!hasAnswer(index)) {
+        return answer;
+    }
+    answer.questionNumber = static_cast<int>(index) + 1;
+    answer.type = getType(index);
+    answer.selectedOption = selectedOptions[index];
+    answer.textAnswer = texts[index];
+    return answer;
+}
@@ -0,0 +1,194 @@
+#include "GroundTruth.h"
+#include "SheetResult.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+double AccuracyStats::bubbleAccuracy() const {
+    return bubbleQuestions > 0 ? static_cast<double>(bubbleCorrect) / bubbleQuestions : 0.0;
+}
+
+double AccuracyStats::textAccuracy() const {
+    return textQuestions > 0 ? static_cast<double>(textExact) / textQuestions : 0.0;
+}
+
+double AccuracyStats::meanTextSimilarity() const {
+    return textQuestions > 0 ? textSimilaritySum / textQuestions : 0.0;
+}
+
+GroundTruth::GroundTruth() {
+}
+
+std::string GroundTruth::sheetKey(const std::string& sheetId) {
+    return std::filesystem::path(sheetId).filename().string();
+}
+
+void GroundTruth::writeHeader(std::ostream& out) {
+    out << "# Gerçek cevaplar (sentetik kağıtlar)\n";
+    out << "# Format: sheet,questionNum,type,answer (boş cevap = işaretlenmemiş)\n";
+}
+
+void GroundTruth::writeSheet(std::ostream& out, const std::string& sheetId, const std::vector<Answer>& answers) {
+    for (const auto& answer : answers) {
+        out << sheetId << "," << answer.questionNumber << ",";
+
+        switch (answer.type) {
+            case Answer::MULTIPLE_CHOICE:
+                out << "MC,";
+                if (answer.selectedOption >= 0) {
+                    out << answer.selectedOption;
+                }
+                break;
+            case Answer::FILL_IN_BLANK:
+                out << "FILL," << answer.textAnswer;
+                break;
+            case Answer::TRUE_FALSE:
+                out << "TF,";
+                if (answer.selectedOption >= 0) {
+                    out << (answer.selectedOption == 0 ? "T" : "F");
+                }
+                break;
+        }
+
+        out << "\n";
+    }
+}
+
+bool GroundTruth::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Gerçek cevap dosyası açılamadı: " << filename << std::endl;
+        return false;
+    }
+
+    sheets.clear();
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        // "sheet,questionNum,type,answer"; the answer may be empty
+        size_t first = line.find(',');
+        size_t second = (first == std::string::npos) ? first : line.find(',', first + 1);
+        size_t third = (second == std::string::npos) ? second : line.find(',', second + 1);
+        if (third == std::string::npos) {
+            continue;
+        }
+
+        Answer answer;
+        std::string type = line.substr(second + 1, third - second - 1);
+        std::string value = line.substr(third + 1);
+        try {
+            answer.questionNumber = std::stoi(line.substr(first + 1, second - first - 1));
+            if (type == "MC") {
+                answer.selectedOption = value.empty() ? -1 : std::stoi(value);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "HATA: " << filename << ":" << lineNumber
+                      << ": soru numarası veya seçenek sayı değil: " << line << std::endl;
+            sheets.clear();
+            return false;
+        }
+
+        if (type == "MC") {
+            answer.type = Answer::MULTIPLE_CHOICE;
+        } else if (type == "FILL") {
+            answer.type = Answer::FILL_IN_BLANK;
+            answer.textAnswer = value;
+        } else if (type == "TF") {
+            answer.type = Answer::TRUE_FALSE;
+            answer.selectedOption = value.empty() ? -1 : ((value == "T" || value == "1") ? 0 : 1);
+        } else {
+            continue;
+        }
+
+        sheets[sheetKey(line.substr(0, first))].push_back(answer);
+    }
+
+    std::cout << sheets.size() << " kağıdın gerçek cevapları yüklendi" << std::endl;
+    return true;
+}
+
+const std::vector<Answer>* GroundTruth::find(const std::string& sheetId) const {
+    auto it = sheets.find(sheetKey(sheetId));
+    return it != sheets.end() ? &it->second : nullptr;
+}
+
+size_t GroundTruth::getSheetCount() const {
+    return sheets.size();
+}
+
+AccuracyStats GroundTruth::evaluate(const std::vector<SheetResult>& results,
+                                    const AnswerComparator& comparator) const {
+    AccuracyStats stats;
+
+    for (const auto& result : results) {
+        if (find(result.sheetId) == nullptr) {
+            stats.sheetsWithoutTruth++;
+        } else if (!result.success) {
+            stats.sheetsFailed++;
+        } else {
+            evaluateSheet(result.sheetId, result.studentAnswers, comparator, stats);
+        }
+    }
+
+    return stats;
+}
+
+void GroundTruth::evaluateSheet(const std::string& sheetId, const std::vector<Answer>& readAnswers,
+                                const AnswerComparator& comparator, AccuracyStats& stats) const {
+    const std::vector<Answer>* truth = find(sheetId);
+    if (truth == nullptr) {
+        stats.sheetsWithoutTruth++;
+        return;
+    }
+    stats.sheetsEvaluated++;
+
+    std::map<std::pair<int, int>, const Answer*> detected;
+    for (const auto& answer : readAnswers) {
+        detected[std::make_pair(static_cast<int>(answer.type), answer.questionNumber)] = &answer;
+    }
+
+    bool perfect = true;
+    for (const auto& expected : *truth) {
+        auto it = detected.find(std::make_pair(static_cast<int>(expected.type), expected.questionNumber));
+        const Answer* read = (it != detected.end()) ? it->second : nullptr;
+
+        if (expected.type == Answer::FILL_IN_BLANK) {
+            std::string text = read ? read->textAnswer : "";
+            stats.textQuestions++;
+            stats.textSimilaritySum += comparator.calculateTextSimilarity(text, expected.textAnswer);
+            if (comparator.compareFillInBlank(text, expected.textAnswer)) {
+                stats.textExact++;
+            } else {
+                perfect = false;
+            }
+            continue;
+        }
+
+        int option = read ? read->selectedOption : -1;
+        stats.bubbleQuestions++;
+        if (option == expected.selectedOption) {
+            stats.bubbleCorrect++;
+            continue;
+        }
+
+        perfect = false;
+        if (option < 0) {
+            stats.missedMarks++;
+        } else if (expected.selectedOption < 0) {
+            stats.falseMarks++;
+        }
+    }
+
+    if (perfect) {
+        stats.perfectSheets++;
+    }
+}
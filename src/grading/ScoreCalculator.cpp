@@ -1,6 +1,26 @@
 #include "ScoreCalculator.h"
+#include "Tracer.h"
+#include <algorithm>
 #include <iostream>
 
+namespace {
+
+// Students per block: the three accumulator rows stay in L1 while every question column streams past
+const size_t SCORE_BLOCK_SIZE = 2048;
+
+inline void accumulateColumn(const uint8_t* __restrict codes, uint8_t expected, float points,
+                             uint16_t* __restrict correct, uint16_t* __restrict blank,
+                             float* __restrict raw, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint16_t hit = codes[i] == expected;
+        correct[i] += hit;
+        blank[i] += codes[i] == AnswerMatrix::BLANK;
+        raw[i] += points * hit;
+    }
+}
+
+} // namespace
+
 ScoreCalculator::ScoreCalculator(const AnswerKey& answerKey, const AnswerComparator& comparator)
     : answerKey(answerKey), comparator(comparator), pointsPerQuestion(1.0),
       partialCreditEnabled(true), partialCreditThreshold(0.7) {
@@ -54,43 +74,65 @@ double ScoreCalculator::calculatePartialCredit(const Answer& studentAns,
     return 0.0;
 }
 
+void ScoreCalculator::setCompiledKey(std::shared_ptr<const CompiledAnswerKey> compiledKey) {
+    std::atomic_store(&this->compiledKey, std::move(compiledKey));
+}
+
+std::shared_ptr<const CompiledAnswerKey> ScoreCalculator::currentKey() const {
+    // Const methods may run on several threads; the caller's copy keeps the key alive even if
+    // another thread swaps in a newer one
+    std::shared_ptr<const CompiledAnswerKey> key = std::atomic_load(&compiledKey);
+    if (!key || !key->isCurrent(answerKey)) {
+        key = CompiledAnswerKey::compile(answerKey);
+        std::atomic_store(&compiledKey, key);
+    }
+    return key;
+}
+
 ExamScore ScoreCalculator::calculateScore(const std::vector<Answer>& studentAnswers) {
+    OMR_TRACE_SCOPE("ScoreCalculator::calculateScore");
+    std::shared_ptr<const CompiledAnswerKey> compiled = currentKey();
+    const CompiledAnswerKey& key = *compiled;
+    bool caseSensitive = comparator.isCaseSensitive();
+
     ExamScore score;
-    score.totalQuestions = answerKey.getTotalQuestions();
+    score.totalQuestions = key.getAnswerCount();
     
-    // Create a map of student answers for quick lookup
-    std::map<int, Answer> studentAnswerMap;
+    // Index student answers by question; the last answer for a question wins
+    studentSlots.assign(key.size(), nullptr);
     for (const auto& ans : studentAnswers) {
-        studentAnswerMap[ans.questionNumber] = ans;
+        if (ans.questionNumber >= 1 && static_cast<size_t>(ans.questionNumber) <= key.size()) {
+            studentSlots[ans.questionNumber - 1] = &ans;
+        }
     }
     
     // Evaluate each question
     for (int qNum = 1; qNum <= score.totalQuestions; qNum++) {
-        if (!answerKey.hasAnswer(qNum)) {
+        size_t index = static_cast<size_t>(qNum - 1);
+        if (!key.hasAnswer(index)) {
             continue;
         }
         
-        Answer correctAns = answerKey.getAnswer(qNum);
         QuestionResult result;
         result.questionNumber = qNum;
-        result.correctAnswer = correctAns;
+        result.correctAnswer = key.toAnswer(index);
         
-        auto it = studentAnswerMap.find(qNum);
-        if (it == studentAnswerMap.end()) {
+        const Answer* studentAns = studentSlots[index];
+        if (studentAns == nullptr) {
             // Unanswered
             result.isCorrect = false;
             result.partialCredit = 0.0;
             score.unanswered++;
         } else {
-            result.studentAnswer = it->second;
-            result.isCorrect = comparator.compareAnswer(result.studentAnswer, correctAns);
+            result.studentAnswer = *studentAns;
+            result.isCorrect = key.matches(index, *studentAns, caseSensitive);
             
             if (result.isCorrect) {
                 result.partialCredit = 1.0;
                 score.correctAnswers++;
             } else {
                 // Check for partial credit
-                result.partialCredit = calculatePartialCredit(result.studentAnswer, correctAns);
+                result.partialCredit = calculatePartialCredit(result.studentAnswer, result.correctAnswer);
                 if (result.partialCredit == 0.0) {
                     score.incorrectAnswers++;
                 }
@@ -139,3 +181,129 @@ std::map<std::string, double> ScoreCalculator::getStatistics(const ExamScore& sc
     
     return stats;
 }
+
+void ScoreCalculator::encodeAnswers(const std::vector<Answer>& studentAnswers,
+                                    AnswerMatrix& matrix, size_t student) const {
+    std::shared_ptr<const CompiledAnswerKey> compiled = currentKey();
+    const CompiledAnswerKey& key = *compiled;
+    bool caseSensitive = comparator.isCaseSensitive();
+
+    // Rows already in the matrix carry verdicts against an older key
+    if (!matrix.claimKeyRevision(key.getRevision())) {
+        std::cerr << "HATA: Cevap matrisi cevap anahtarının eski bir sürümüyle kodlanmış; "
+                  << "matrisi resize ile sıfırlayıp tüm kağıtları yeniden kodlayın" << std::endl;
+        return;
+    }
+
+    for (const auto& answer : studentAnswers) {
+        if (answer.questionNumber < 1 ||
+            static_cast<size_t>(answer.questionNumber) > matrix.getQuestionCount()) {
+            continue;
+        }
+        size_t question = static_cast<size_t>(answer.questionNumber - 1);
+
+        // Same verdict as calculateScore: an answer of another type is answered and wrong
+        if (key.hasAnswer(question) && answer.type != key.getType(question)) {
+            matrix.set(student, question, AnswerMatrix::TYPE_MISMATCH);
+        } else if (answer.type != Answer::FILL_IN_BLANK) {
+            matrix.set(student, question, AnswerMatrix::optionCode(answer.selectedOption));
+        } else if (answer.textAnswer.empty()) {
+            matrix.set(student, question, AnswerMatrix::BLANK);
+        } else {
+            bool match = key.matches(question, answer, caseSensitive);
+            matrix.set(student, question, match ? AnswerMatrix::TEXT_MATCH : AnswerMatrix::TEXT_MISMATCH);
+        }
+    }
+}
+
+BatchScores ScoreCalculator::calculateScores(const AnswerMatrix& answers) const {
+    OMR_TRACE_SCOPE("ScoreCalculator::calculateScores");
+
+    // One (column, expected code, points) entry per graded question
+    struct KeyColumn {
+        const uint8_t* codes;
+        uint8_t expected;
+        float points;
+    };
+
+    std::shared_ptr<const CompiledAnswerKey> compiled = currentKey();
+    const CompiledAnswerKey& key = *compiled;
+
+    BatchScores scores;
+    scores.totalQuestions = key.getAnswerCount();
+
+    // Text and type verdicts were decided against the key at encode time
+    uint64_t encodedRevision = answers.getKeyRevision();
+    if (encodedRevision != 0 && encodedRevision != key.getRevision()) {
+        std::cerr << "HATA: Cevap matrisi cevap anahtarı düzenlenmeden önce kodlanmış; "
+                  << "kağıtları encodeAnswers ile yeniden kodlayın" << std::endl;
+        return scores;
+    }
+
+    std::vector<KeyColumn> columns;
+    int missingColumns = 0;     // keyed questions beyond the matrix: unanswered for everyone
+    int invalidColumns = 0;     // keyed without a valid option: no cell can match, incorrect for everyone
+    for (int qNum = 1; qNum <= scores.totalQuestions; qNum++) {
+        scores.maxScore += getQuestionPoints(qNum);
+        size_t index = static_cast<size_t>(qNum - 1);
+        if (!key.hasAnswer(index)) {
+            continue;
+        }
+        if (static_cast<size_t>(qNum) > answers.getQuestionCount()) {
+            missingColumns++;
+            continue;
+        }
+
+        KeyColumn column;
+        column.codes = answers.column(index);
+        column.expected = key.getOptionCode(index);
+        column.points = static_cast<float>(getQuestionPoints(qNum));
+        if (column.expected == AnswerMatrix::BLANK) {
+            // calculateScore would still grade an equal option correct
+            std::cerr << "Uyarı: Soru " << qNum << " anahtarındaki seçenek (" << key.getSelectedOption(index)
+                      << ") matriste kodlanamaz (0-" << AnswerMatrix::MAX_OPTIONS - 1
+                      << "); toplu puanlamada herkes için yanlış sayılıyor" << std::endl;
+            invalidColumns++;   // scanning it would "match" every blank cell
+            continue;
+        }
+        columns.push_back(column);
+    }
+
+    size_t studentCount = answers.getStudentCount();
+    scores.correctAnswers.assign(studentCount, 0);
+    scores.incorrectAnswers.assign(studentCount, 0);
+    scores.unanswered.assign(studentCount, 0);
+    scores.rawScore.assign(studentCount, 0.0f);
+    scores.percentageScore.assign(studentCount, 0.0f);
+
+    // Question-major over a block of students: each column pass is a branch-free sweep over
+    // contiguous bytes into independent per-student accumulators, which compilers vectorize
+    for (size_t begin = 0; begin < studentCount; begin += SCORE_BLOCK_SIZE) {
+        size_t count = std::min(SCORE_BLOCK_SIZE, studentCount - begin);
+        uint16_t* correct = scores.correctAnswers.data() + begin;
+        uint16_t* blank = scores.unanswered.data() + begin;
+        float* raw = scores.rawScore.data() + begin;
+
+        for (const KeyColumn& column : columns) {
+            // A constant trip count lets -O2 vectorize full blocks without a runtime epilogue
+            if (count == SCORE_BLOCK_SIZE) {
+                accumulateColumn(column.codes + begin, column.expected, column.points,
+                                 correct, blank, raw, SCORE_BLOCK_SIZE);
+            } else {
+                accumulateColumn(column.codes + begin, column.expected, column.points,
+                                 correct, blank, raw, count);
+            }
+        }
+    }
+
+    uint16_t graded = static_cast<uint16_t>(columns.size());
+    float percentScale = scores.maxScore > 0.0 ? static_cast<float>(100.0 / scores.maxScore) : 0.0f;
+    for (size_t i = 0; i < studentCount; i++) {
+        scores.incorrectAnswers[i] = static_cast<uint16_t>(graded - scores.correctAnswers[i] - scores.unanswered[i] +
+                                                           invalidColumns);
+        scores.unanswered[i] = static_cast<uint16_t>(scores.unanswered[i] + missingColumns);
+        scores.percentageScore[i] = scores.rawScore[i] * percentScale;
+    }
+
+    return scores;
+}
@@ -0,0 +1,305 @@
+#include "SheetGrader.h"
+#include "DebugArtifactSink.h"
+#include "MetricsRegistry.h"
+#include "Tracer.h"
+#include <iostream>
+
+namespace {
+
+// Blur and adaptive-threshold windows reach a few pixels past a region
+const int REGION_WARP_PADDING = 4;
+
+// Registered on first use; the references are then updated without locking
+struct GradingMetrics {
+    Histogram& registration;
+    Histogram& structure;
+    Histogram& bubbles;
+    Histogram& handwriting;
+    Histogram& ocr;
+    Counter& perspectiveFallbacks;
+    Histogram& ocrConfidence;
+    Counter& answered;
+    Counter& unanswered;
+    Counter& multiMark;
+    Counter& textAnswered;
+    Counter& textBlank;
+
+    static GradingMetrics& instance() {
+        static GradingMetrics metrics(MetricsRegistry::instance());
+        return metrics;
+    }
+
+    explicit GradingMetrics(MetricsRegistry& registry)
+        : registration(registry.stageLatency("registration")),
+          structure(registry.stageLatency("structure")),
+          bubbles(registry.stageLatency("bubbles")),
+          handwriting(registry.stageLatency("handwriting")),
+          ocr(registry.stageLatency("ocr")),
+          perspectiveFallbacks(registry.counter("omr_perspective_fallbacks_total",
+              "Sheets graded from the resized photo because registration failed")),
+          ocrConfidence(registry.histogram("omr_ocr_confidence",
+              "Tesseract mean word confidence (0-100) per recognized answer",
+              Histogram::linearBuckets(10.0, 10.0, 10))),
+          answered(registry.counter("omr_bubble_questions_total",
+              "Bubble questions read, by outcome", "result=\"answered\"")),
+          unanswered(registry.counter("omr_bubble_questions_total",
+              "Bubble questions read, by outcome", "result=\"unanswered\"")),
+          multiMark(registry.counter("omr_bubble_questions_total",
+              "Bubble questions read, by outcome", "result=\"multi_mark\"")),
+          textAnswered(registry.counter("omr_text_questions_total",
+              "Fill-in questions read, by outcome", "result=\"answered\"")),
+          textBlank(registry.counter("omr_text_questions_total",
+              "Fill-in questions read, by outcome", "result=\"blank\"")) {
+    }
+
+    void recordBubble(const BubbleSampler& sampler, size_t regionIndex, int markedOption) {
+        if (markedOption >= 0) {
+            answered.increment();
+        } else if (sampler.getMarkCount(regionIndex) > 1) {
+            multiMark.increment();
+        } else {
+            unanswered.increment();
+        }
+    }
+};
+
+} // namespace
+
+SheetGrader::SheetGrader(OCRProcessor& ocrProcessor, double fillThreshold, double minHandwritingDensity)
+    : ocrProcessor(ocrProcessor),
+      bubbleSampler(fillThreshold),
+      handwritingDetector(minHandwritingDensity),
+      regionWarp(false),
+      verbose(true) {
+    applyTemplateRegistration();
+}
+
+void SheetGrader::setVerbose(bool verbose) {
+    this->verbose = verbose;
+}
+
+void SheetGrader::setWarpMode(PerspectiveCorrector::WarpMode mode) {
+    perspectiveCorrector.setWarpMode(mode);
+}
+
+void SheetGrader::setRegionWarp(bool enabled) {
+    regionWarp = enabled;
+}
+
+cv::Mat SheetGrader::correctPerspective(const cv::Mat& image) {
+    GradingMetrics& metrics = GradingMetrics::instance();
+    ScopedLatency timer(metrics.registration);
+
+    // Warp to the template's sheet size so its regions line up
+    const SheetTemplate& sheetTemplate = sheetAnalyzer.getTemplate();
+    cv::Mat corrected = perspectiveCorrector.correctPerspective(image, sheetTemplate.getSheetWidth(),
+                                                                sheetTemplate.getSheetHeight());
+    if (perspectiveCorrector.getLastMethod() == PerspectiveCorrector::NONE) {
+        metrics.perspectiveFallbacks.increment();
+    }
+    return corrected;
+}
+
+bool SheetGrader::loadTemplate(const std::string& filename) {
+    if (!sheetAnalyzer.loadTemplate(filename)) {
+        return false;
+    }
+    // Force the sampler to rebuild from the new tables on the next sheet
+    bubbleSampler.setLayout(std::vector<QuestionRegion>());
+    applyTemplateRegistration();
+    return true;
+}
+
+void SheetGrader::setTemplate(const SheetTemplate& sheetTemplate) {
+    sheetAnalyzer.setTemplate(sheetTemplate);
+    bubbleSampler.setLayout(std::vector<QuestionRegion>());
+    applyTemplateRegistration();
+}
+
+void SheetGrader::applyTemplateRegistration() {
+    // Markerless sheets skip the marker search: filled bubbles near the corners could pass it
+    const SheetTemplate& sheetTemplate = sheetAnalyzer.getTemplate();
+    perspectiveCorrector.setRegistrationMode(sheetTemplate.hasMarkers() ? PerspectiveCorrector::AUTO
+                                                                        : PerspectiveCorrector::CONTOUR_ONLY);
+    perspectiveCorrector.setMarkerInset(static_cast<float>(sheetTemplate.getMarkerInset()));
+}
+
+std::vector<QuestionRegion> SheetGrader::analyzeStructure(const cv::Mat& correctedSheet) {
+    ScopedLatency timer(GradingMetrics::instance().structure);
+    return sheetAnalyzer.analyzeSheet(correctedSheet);
+}
+
+cv::Mat SheetGrader::visualizeRegions(
+    const cv::Mat& correctedSheet,
+    const std::vector<QuestionRegion>& regions) {
+
+    return sheetAnalyzer.visualizeRegions(correctedSheet, regions);
+}
+
+std::vector<Answer> SheetGrader::readAnswers(
+    const cv::Mat& correctedSheet,
+    const std::vector<QuestionRegion>& regions) {
+
+    OMR_TRACE_SCOPE("SheetGrader::readAnswers");
+    GradingMetrics& metrics = GradingMetrics::instance();
+
+    std::vector<Answer> studentAnswers;
+    studentAnswers.reserve(regions.size());
+
+    // Gray/blur/threshold passes are computed at most once for this sheet and shared
+    sheetContext.reset(correctedSheet);
+
+    // Bubble geometry is fixed by the layout: build it once, then only sample pixels
+    if (!bubbleSampler.matchesLayout(regions)) {
+        bubbleSampler.setLayout(regions, &sheetAnalyzer.getTemplate());
+    }
+    {
+        OMR_TRACE_SCOPE("BubbleSampler::sample");
+        ScopedLatency timer(metrics.bubbles);
+        bubbleSampler.sample(sheetContext);
+    }
+
+    for (size_t regionIndex = 0; regionIndex < regions.size(); regionIndex++) {
+        const QuestionRegion& region = regions[regionIndex];
+        OMR_TRACE_SCOPE_ARG("SheetGrader::region", "question", region.questionNumber);
+        Answer answer;
+        answer.questionNumber = region.questionNumber;
+        answer.type = static_cast<Answer::Type>(region.type);
+
+        switch (region.type) {
+            case QuestionRegion::MULTIPLE_CHOICE: {
+                // Detect marked bubble
+                int markedOption = bubbleSampler.getMarkedAnswer(regionIndex);
+                answer.selectedOption = markedOption;
+                metrics.recordBubble(bubbleSampler, regionIndex, markedOption);
+
+                if (!verbose) {
+                    break;
+                }
+
+                if (markedOption >= 0) {
+                    std::cout << "Soru " << region.questionNumber
+                             << ": Seçenek " << static_cast<char>('A' + markedOption)
+                             << std::endl;
+                } else {
+                    std::cout << "Soru " << region.questionNumber
+                             << ": İşaretlenmemiş veya çoklu işaret" << std::endl;
+                }
+                break;
+            }
+
+            case QuestionRegion::FILL_IN_BLANK: {
+                // Check for handwriting
+                bool hasHandwriting;
+                {
+                    ScopedLatency timer(metrics.handwriting);
+                    hasHandwriting = handwritingDetector.hasHandwriting(sheetContext, region.region);
+                }
+
+                if (hasHandwriting) {
+                    // Extract and process with OCR
+                    cv::Mat roi = handwritingDetector.extractHandwritingROI(
+                        sheetContext, region.region
+                    );
+
+                    if (DebugArtifactSink::isEnabled(DebugArtifactSink::BASIC)) {
+                        std::string roiFilename = "debug_roi_q" + std::to_string(region.questionNumber) + ".jpg";
+                        DebugArtifactSink::instance().submit(DebugArtifactSink::BASIC, roiFilename, roi);
+                    }
+
+                    {
+                        ScopedLatency timer(metrics.ocr);
+                        answer.textAnswer = ocrProcessor.recognizeText(roi);
+                    }
+                    metrics.ocrConfidence.observe(ocrProcessor.getConfidence());
+                    metrics.textAnswered.increment();
+
+                    if (verbose) {
+                        std::cout << "Soru " << region.questionNumber
+                                 << ": \"" << answer.textAnswer << "\"" << std::endl;
+                    }
+                } else {
+                    answer.textAnswer = "";
+                    metrics.textBlank.increment();
+
+                    if (verbose) {
+                        std::cout << "Soru " << region.questionNumber
+                                 << ": Boş" << std::endl;
+                    }
+                }
+                break;
+            }
+
+            case QuestionRegion::TRUE_FALSE: {
+                // Similar to multiple choice but with 2 options
+                int markedOption = bubbleSampler.getMarkedAnswer(regionIndex);
+                answer.selectedOption = markedOption;
+                metrics.recordBubble(bubbleSampler, regionIndex, markedOption);
+
+                if (verbose && markedOption >= 0) {
+                    std::cout << "Soru " << region.questionNumber
+                             << ": " << (markedOption == 0 ? "Doğru" : "Yanlış")
+                             << std::endl;
+                }
+                break;
+            }
+        }
+
+        studentAnswers.push_back(answer);
+    }
+
+    return studentAnswers;
+}
+
+std::vector<Answer> SheetGrader::processSheet(const cv::Mat& image) {
+    if (regionWarp) {
+        return processSheetRegions(image);
+    }
+
+    cv::Mat correctedSheet = correctPerspective(image);
+    std::vector<QuestionRegion> regions = analyzeStructure(correctedSheet);
+    return readAnswers(correctedSheet, regions);
+}
+
+std::vector<Answer> SheetGrader::processSheetRegions(const cv::Mat& image) {
+    const SheetTemplate& sheetTemplate = sheetAnalyzer.getTemplate();
+    cv::Size sheetSize(sheetTemplate.getSheetWidth(), sheetTemplate.getSheetHeight());
+
+    GradingMetrics& metrics = GradingMetrics::instance();
+    cv::Mat homography;
+    bool registered;
+    {
+        ScopedLatency timer(metrics.registration);
+        registered = perspectiveCorrector.registerSheet(image, homography, sheetSize.width, sheetSize.height);
+    }
+
+    if (!registered) {
+        metrics.perspectiveFallbacks.increment();
+        // Same fallback as correctPerspective: the whole photo, resized
+        cv::Mat resized;
+        cv::resize(perspectiveCorrector.getRegistrationGray(), resized, sheetSize);
+        return readAnswers(resized, analyzeStructure(resized));
+    }
+
+    // Regions come from the template alone, so they are known before any pixel is warped
+    std::vector<QuestionRegion> regions = sheetTemplate.buildRegions(sheetSize);
+    std::vector<cv::Rect> warpRects;
+    warpRects.reserve(regions.size());
+    for (const auto& region : regions) {
+        cv::Rect padded(region.region.x - REGION_WARP_PADDING, region.region.y - REGION_WARP_PADDING,
+                        region.region.width + 2 * REGION_WARP_PADDING,
+                        region.region.height + 2 * REGION_WARP_PADDING);
+        warpRects.push_back(padded);
+    }
+
+    sheetWarp.setHomography(homography, sheetSize);
+    sheetWarp.setSource(perspectiveCorrector.getRegistrationGray());
+    cv::Mat sparseSheet = sheetWarp.renderRegions(warpRects);
+
+    if (verbose) {
+        std::cout << "Bölge dönüşümü: " << sheetWarp.getWarpedPixelCount() << " / "
+                  << sheetSize.area() << " piksel" << std::endl;
+    }
+
+    return readAnswers(sparseSheet, regions);
+}
@@ -3,9 +3,9 @@
  * Kağıtta nerede yazı varsa buluyor ve okuyor
  */
 
+#include "OCREnginePool.h"
+#include "DebugArtifactSink.h"
 #include <opencv2/opencv.hpp>
-#include <tesseract/baseapi.h>
-#include <allheaders.h>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -107,16 +107,23 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    // Blok kırpıntıları yalnızca OMR_DEBUG_ARTIFACTS ile yazılır
+    DebugArtifactSink::instance().configureFromEnvironment();
+    
     // Tesseract başlat
     std::cout << "2. OCR motoru başlatılıyor..." << std::endl;
-    tesseract::TessBaseAPI* api = new tesseract::TessBaseAPI();
+    OCREngineConfig ocrConfig;
+    ocrConfig.pageSegMode = tesseract::PSM_AUTO;
+    ocrConfig.charWhitelist.clear();
+    
+    OCREnginePool ocrPool(1, ocrConfig);
+    OCREnginePool::Lease ocr = ocrPool.checkout();
     
-    if (api->Init(NULL, "tur", tesseract::OEM_LSTM_ONLY)) {
+    if (!ocr) {
         std::cerr << "   ❌ Tesseract başlatılamadı!" << std::endl;
         return 1;
     }
     
-    api->SetPageSegMode(tesseract::PSM_AUTO);
     std::cout << "   ✅ OCR hazır (Türkçe)\n" << std::endl;
     
     // Her bloğu oku
@@ -130,29 +137,14 @@ int main(int argc, char* argv[]) {
         cv::Rect roi = blocks[i];
         cv::Mat blockImg = image(roi);
         
-        // OCR için temp dosya
-        std::string tempFile = "temp_block_" + std::to_string(i) + ".jpg";
-        cv::imwrite(tempFile, blockImg);
-        
-        Pix* pix = pixRead(tempFile.c_str());
-        if (!pix) {
-            std::cout << "Blok " << (i + 1) << ": ❌ Görüntü okunamadı" << std::endl;
-            std::remove(tempFile.c_str());
-            continue;
+        if (DebugArtifactSink::isEnabled(DebugArtifactSink::BASIC)) {
+            std::string cropFile = "debug_block_" + std::to_string(i + 1) + ".jpg";
+            DebugArtifactSink::instance().submit(DebugArtifactSink::BASIC, cropFile, blockImg);
         }
         
-        api->SetImage(pix);
-        char* rawText = api->GetUTF8Text();
-        int confidence = api->MeanTextConf();
-        
-        std::string text = rawText ? rawText : "";
-        delete[] rawText;
-        pixDestroy(&pix);
-        std::remove(tempFile.c_str());
-        
-        // Temizle
-        text.erase(0, text.find_first_not_of(" \n\r\t"));
-        text.erase(text.find_last_not_of(" \n\r\t") + 1);
+        // Blok doğrudan bellekten OCR'a verilir (geçici dosya yok)
+        std::string text = ocr->recognizeText(blockImg);
+        int confidence = static_cast<int>(ocr->getConfidence());
         
         // Sonuç
         HandwritingBlock result;
@@ -224,9 +216,7 @@ int main(int argc, char* argv[]) {
     std::cout << "\nPencereyi kapatmak için bir tuşa basın..." << std::endl;
     cv::waitKey(0);
     
-    // Temizlik
-    api->End();
-    delete api;
+    DebugArtifactSink::instance().shutdown();
     
     return 0;
 }
@@ -3,10 +3,24 @@
  * Kameradan canlı görüntü al, yazıları otomatik bul ve oku
  */
 
+#include "FrameSource.h"
+#include "OCREnginePool.h"
 #include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include <map>
+#include <memory>
 
 // Cevap anahtarı
 std::map<int, std::string> answerKey = {
@@ -17,6 +31,151 @@ std::map<int, std::string> answerKey = {
     {5, "Cumhuriyet"}
 };
 
+// Canlı önizleme: tespit küçültülmüş karede ve N karede bir çalışır, kutular arada taşınır
+struct PreviewConfig {
+    double scale;           // tespit çözünürlüğü (1.0, 0.5, 0.25)
+    int minInterval;        // en sık kaç karede bir tespit
+    double budgetMs;        // kare başına düşen tespit süresi üst sınırı
+
+    PreviewConfig() : scale(0.5), minInterval(2), budgetMs(4.0) {}
+};
+
+struct RegionResult {
+    int questionNum;
+    cv::Rect region;
+    std::string text;
+    bool cancelled;     // yeni yakalama geldi, sonuç artık geçersiz
+
+    RegionResult() : questionNum(0), cancelled(false) {}
+};
+
+/**
+ * Arka planda OCR yapan worker'lar. Her worker havuzdan bir motor ödünç alır ve tüm ömrü
+ * boyunca tutar; her bölge bir future ile döner. Yeni yakalama (newGeneration) eski
+ * yakalamanın kuyruktaki işlerini hemen iptal eder, o an okunmakta olan bölgenin sonucu da
+ * iptal olarak döner.
+ */
+class AsyncOCRWorkers {
+public:
+    explicit AsyncOCRWorkers(OCREnginePool& pool) : stopping(false), generation(0) {
+        for (size_t i = 0; i < pool.size(); i++) {
+            workers.emplace_back(&AsyncOCRWorkers::workerLoop, this, pool.checkout());
+        }
+    }
+
+    ~AsyncOCRWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            stopping = true;
+        }
+        newGeneration();
+        jobsCondition.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    uint64_t newGeneration() {
+        uint64_t current = ++generation;
+
+        std::deque<Job> stale;
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            stale.swap(jobs);
+        }
+        for (auto& job : stale) {
+            cancel(job);
+        }
+        return current;
+    }
+
+    // roi must own its pixels (or share a frame nobody writes to) until the future is ready
+    std::future<RegionResult> submit(uint64_t jobGeneration, int questionNum, const cv::Mat& roi, const cv::Rect& region) {
+        Job job;
+        job.generation = jobGeneration;
+        job.roi = roi;
+        job.result.questionNum = questionNum;
+        job.result.region = region;
+        std::future<RegionResult> future = job.promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(jobsMutex);
+            jobs.push_back(std::move(job));
+        }
+        jobsCondition.notify_one();
+        return future;
+    }
+
+private:
+    struct Job {
+        uint64_t generation;
+        cv::Mat roi;
+        RegionResult result;
+        std::promise<RegionResult> promise;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable jobsCondition;
+    bool stopping;
+    std::atomic<uint64_t> generation;
+
+    static void cancel(Job& job) {
+        job.result.cancelled = true;
+        job.promise.set_value(job.result);
+    }
+
+    void workerLoop(OCREnginePool::Lease engine) {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(jobsMutex);
+                jobsCondition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                if (jobs.empty()) {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+
+            // Tesseract cannot be interrupted mid-call: check before and after
+            if (job.generation != generation.load() || !engine) {
+                cancel(job);
+                continue;
+            }
+            try {
+                job.result.text = engine->recognizeText(job.roi);
+            } catch (const std::exception& e) {
+                std::cerr << "OCR hatası (Soru " << job.result.questionNum << "): " << e.what() << std::endl;
+            }
+            if (job.generation != generation.load()) {
+                cancel(job);
+                continue;
+            }
+            job.promise.set_value(job.result);
+        }
+    }
+
+    AsyncOCRWorkers(const AsyncOCRWorkers&) = delete;
+    AsyncOCRWorkers& operator=(const AsyncOCRWorkers&) = delete;
+};
+
+// Ekranda ilerleyen okuma: sonuçlar geldikçe çizilir
+struct PendingCapture {
+    bool active;
+    cv::Mat result;
+    std::vector<std::future<RegionResult>> futures;
+    std::vector<bool> done;
+    size_t completed;
+    int correct;
+    int wrong;
+    std::chrono::steady_clock::time_point captureTime;
+
+    PendingCapture() : active(false), completed(0), correct(0), wrong(0) {}
+};
+
+const int MAX_DETECT_INTERVAL = 30;
+
 struct TextBlock {
     cv::Rect region;
     std::string text;
@@ -25,37 +184,56 @@ struct TextBlock {
     std::string expectedAnswer;
 };
 
-std::vector<cv::Rect> findTextRegions(const cv::Mat& image) {
+// scale < 1: tespit küçültülmüş karede yapılır, kutular tam çözünürlüğe geri ölçeklenir
+std::vector<cv::Rect> findTextRegions(const cv::Mat& image, double scale = 1.0) {
     std::vector<cv::Rect> regions;
     
+    // Küçült, sonra griye çevir: dönüşüm de küçük karede yapılır
+    cv::Mat small = image;
+    if (scale < 1.0) {
+        cv::resize(image, small, cv::Size(), scale, scale, cv::INTER_AREA);
+    } else {
+        scale = 1.0;
+    }
+    
     cv::Mat gray;
-    if (image.channels() == 3) {
-        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+    if (small.channels() == 3) {
+        cv::cvtColor(small, gray, cv::COLOR_BGR2GRAY);
     } else {
-        gray = image.clone();
+        gray = small.clone();
     }
     
-    // Adaptive threshold - yazıları bul
+    // Adaptive threshold - yazıları bul (blok boyutu ölçekle küçülür, tek sayı kalır)
+    int blockSize = std::max(3, static_cast<int>(31 * scale) | 1);
     cv::Mat binary;
     cv::adaptiveThreshold(gray, binary, 255,
                          cv::ADAPTIVE_THRESH_GAUSSIAN_C,
-                         cv::THRESH_BINARY_INV, 31, 10);
+                         cv::THRESH_BINARY_INV, blockSize, 10);
     
     // Gürültü temizle
-    cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
-    cv::morphologyEx(binary, binary, cv::MORPH_OPEN, kernel);
+    int openSize = std::max(1, cvRound(3 * scale));
+    if (openSize > 1) {
+        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(openSize, openSize));
+        cv::morphologyEx(binary, binary, cv::MORPH_OPEN, kernel);
+    }
     
     // Kelimeleri birleştir
-    kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(40, 10));
+    cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT,
+        cv::Size(std::max(1, cvRound(40 * scale)), std::max(1, cvRound(10 * scale))));
     cv::dilate(binary, binary, kernel, cv::Point(-1, -1), 1);
     
     // Konturları bul
     std::vector<std::vector<cv::Point>> contours;
     cv::findContours(binary, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
     
-    // Filtrele
+    // Filtrele (eşikler tam çözünürlükte)
     for (const auto& contour : contours) {
-        cv::Rect bbox = cv::boundingRect(contour);
+        cv::Rect box = cv::boundingRect(contour);
+        int x0 = static_cast<int>(std::floor(box.x / scale));
+        int y0 = static_cast<int>(std::floor(box.y / scale));
+        int x1 = std::min(image.cols, static_cast<int>(std::ceil((box.x + box.width) / scale)));
+        int y1 = std::min(image.rows, static_cast<int>(std::ceil((box.y + box.height) / scale)));
+        cv::Rect bbox(x0, y0, x1 - x0, y1 - y0);
         
         // Minimum boyut ve aspect ratio
         if (bbox.width > 80 && bbox.height > 25 && bbox.height < 300) {
@@ -110,23 +288,168 @@ bool compareAnswers(const std::string& student, const std::string& correct) {
     return s1 == s2;
 }
 
-int main() {
+// Hazır olan future'ları toplar, sonucu çizer ve yazdırır; hepsi gelince özeti gösterir
+void collectResults(PendingCapture& pending) {
+    for (size_t i = 0; i < pending.futures.size(); i++) {
+        if (pending.done[i] ||
+            pending.futures[i].wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continue;
+        }
+        
+        RegionResult regionResult = pending.futures[i].get();
+        pending.done[i] = true;
+        pending.completed++;
+        if (regionResult.cancelled) {
+            continue;
+        }
+        
+        int questionNum = regionResult.questionNum;
+        const cv::Rect& region = regionResult.region;
+        const std::string& ocrText = regionResult.text;
+        
+        // Karşılaştır
+        bool isCorrect = false;
+        std::string expected = "";
+        
+        if (answerKey.count(questionNum)) {
+            expected = answerKey[questionNum];
+            isCorrect = !ocrText.empty() && compareAnswers(ocrText, expected);
+        }
+        
+        // Görselleştir
+        cv::Scalar color = ocrText.empty() ? cv::Scalar(128, 128, 128) :
+                          (isCorrect ? cv::Scalar(0, 255, 0) : cv::Scalar(0, 0, 255));
+        
+        cv::rectangle(pending.result, region, color, 3);
+        
+        // Label
+        std::string label = "Q" + std::to_string(questionNum);
+        cv::putText(pending.result, label,
+                   cv::Point(region.x, region.y - 5),
+                   cv::FONT_HERSHEY_SIMPLEX, 0.6, color, 2);
+        
+        // İkon
+        if (!ocrText.empty()) {
+            std::string icon = isCorrect ? "✓" : "✗";
+            cv::putText(pending.result, icon,
+                       cv::Point(region.x + region.width + 10, region.y + 30),
+                       cv::FONT_HERSHEY_SIMPLEX, 1.0, color, 2);
+            
+            if (isCorrect) pending.correct++;
+            else pending.wrong++;
+        }
+        
+        // Konsol çıktısı
+        std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
+        std::cout << "Soru " << questionNum << ":" << std::endl;
+        std::cout << "  Okunan: ";
+        if (ocrText.empty()) {
+            std::cout << "(boş)" << std::endl;
+        } else {
+            std::cout << "\"" << ocrText << "\"" << std::endl;
+        }
+        
+        if (!expected.empty()) {
+            std::cout << "  Beklenen: \"" << expected << "\"" << std::endl;
+            std::cout << "  Sonuç: " << (isCorrect ? "✅ DOĞRU" : "❌ YANLIŞ") << std::endl;
+        }
+        std::cout << std::endl;
+        
+        // Sonuçlar geldikçe gösterilir
+        cv::imshow("SONUC", pending.result);
+    }
+    
+    if (pending.completed < pending.futures.size()) {
+        return;
+    }
+    pending.active = false;
+    
+    // Özet
+    std::cout << "╔══════════════════════════════════════════════╗" << std::endl;
+    std::cout << "║   SONUÇLAR                                   ║" << std::endl;
+    std::cout << "╚══════════════════════════════════════════════╝" << std::endl;
+    std::cout << "Toplam Bölge: " << pending.futures.size() << std::endl;
+    std::cout << "✅ Doğru: " << pending.correct << std::endl;
+    std::cout << "❌ Yanlış: " << pending.wrong << std::endl;
+    
+    if (pending.correct + pending.wrong > 0) {
+        int percentage = (pending.correct * 100) / (pending.correct + pending.wrong);
+        std::cout << "📊 Başarı: %" << percentage << std::endl;
+    }
+    
+    double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - pending.captureTime).count();
+    std::cout << "⏱️  Yakalama → sonuç: " << static_cast<int>(elapsedMs) << " ms" << std::endl;
+    std::cout << "══════════════════════════════════════════════\n" << std::endl;
+    
+    // Sonuç görüntüsünü göster
+    cv::imshow("SONUC", pending.result);
+    cv::imwrite("last_result.jpg", pending.result);
+    std::cout << "💾 Sonuç kaydedildi: last_result.jpg" << std::endl;
+    std::cout << "\nYeni okuma için SPACE, çıkmak için ESC" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    PreviewConfig preview;
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    int ocrWorkers = static_cast<int>(std::max(1u, std::min(4u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u)));
+    std::string sourceSpec = "0";
+    FrameSource::Pacing pacing = FrameSource::REALTIME;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--preview-scale" && i + 1 < argc) {
+            preview.scale = std::min(1.0, std::max(0.1, std::stod(argv[++i])));
+        } else if (arg == "--detect-every" && i + 1 < argc) {
+            preview.minInterval = std::min(MAX_DETECT_INTERVAL, std::max(1, std::stoi(argv[++i])));
+        } else if (arg == "--preview-budget" && i + 1 < argc) {
+            preview.budgetMs = std::max(0.1, std::stod(argv[++i]));
+        } else if (arg == "--ocr-workers" && i + 1 < argc) {
+            ocrWorkers = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--source" && i + 1 < argc) {
+            sourceSpec = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc && FrameSource::parsePacing(argv[i + 1], pacing)) {
+            i++;
+        } else {
+            std::cerr << "Kullanım: " << argv[0]
+                      << " [--preview-scale 0.5] [--detect-every 2] [--preview-budget 4.0]"
+                      << " [--ocr-workers N] [--source kamera_id|video.mp4|kare_klasörü]"
+                      << " [--replay realtime|fast]" << std::endl;
+            return 1;
+        }
+    }
+    
     std::cout << "\n╔══════════════════════════════════════════════╗" << std::endl;
     std::cout << "║   CANLI EL YAZISI OKUYUCU                   ║" << std::endl;
     std::cout << "╚══════════════════════════════════════════════╝\n" << std::endl;
     
-    // Kamerayı aç
-    cv::VideoCapture camera(0);
+    // Kamerayı aç (veya kayıtlı bir video / kare klasörünü oynat)
+    std::unique_ptr<FrameSource> camera = FrameSource::create(sourceSpec, pacing);
     
-    if (!camera.isOpened()) {
-        std::cerr << "❌ Kamera açılamadı!" << std::endl;
+    if (!camera->open()) {
+        std::cerr << "❌ Kamera açılamadı: " << camera->describe() << std::endl;
         return 1;
     }
     
-    camera.set(cv::CAP_PROP_FRAME_WIDTH, 1280);
-    camera.set(cv::CAP_PROP_FRAME_HEIGHT, 720);
+    camera->set(cv::CAP_PROP_FRAME_WIDTH, 1280);
+    camera->set(cv::CAP_PROP_FRAME_HEIGHT, 720);
+    
+    std::cout << "✅ Kamera hazır: " << camera->describe() << std::endl;
+    
+    // OCR motorları bir kez yüklenir; bölgeler arka plan worker'larında paralel okunur
+    OCREngineConfig ocrConfig;
+    ocrConfig.pageSegMode = tesseract::PSM_AUTO;
+    ocrConfig.charWhitelist.clear();
+    
+    OCREnginePool ocrPool(static_cast<size_t>(ocrWorkers), ocrConfig);
+    
+    if (!ocrPool.isInitialized()) {
+        std::cerr << "❌ OCR başlatılamadı!" << std::endl;
+        return 1;
+    }
+    
+    AsyncOCRWorkers ocrWorkerPool(ocrPool);
+    std::cout << "✅ " << ocrPool.size() << " OCR worker hazır" << std::endl;
     
-    std::cout << "✅ Kamera hazır!" << std::endl;
     std::cout << "\n📋 CEVAP ANAHTARI:" << std::endl;
     for (const auto& pair : answerKey) {
         std::cout << "   Soru " << pair.first << ": " << pair.second << std::endl;
@@ -138,34 +461,87 @@ int main() {
     std::cout << "\n──────────────────────────────────────────────\n" << std::endl;
     
     cv::Mat frame;
-    bool processing = false;
+    PendingCapture pending;
+    
+    // Önizleme durumu: son tespit edilen kutular ve ölçülen maliyetler
+    std::vector<cv::Rect> previewRegions;
+    int detectInterval = preview.minInterval;
+    int framesSinceDetection = detectInterval;
+    double detectMs = 0.0;
+    double fps = 0.0;
+    auto lastFrameTime = std::chrono::steady_clock::now();
+    
+    size_t previewFrames = 0;
+    size_t detections = 0;
+    double totalDetectMs = 0.0;
+    auto previewStart = std::chrono::steady_clock::now();
     
     while (true) {
-        camera >> frame;
-        
-        if (frame.empty()) {
+        if (!camera->read(frame)) {
+            if (camera->isFinished()) {
+                std::cout << "\nKayıt sona erdi" << std::endl;
+            }
             break;
         }
+        previewFrames++;
+        
+        auto frameTime = std::chrono::steady_clock::now();
+        double frameMs = std::chrono::duration<double, std::milli>(frameTime - lastFrameTime).count();
+        lastFrameTime = frameTime;
+        if (frameMs > 0.0) {
+            fps = fps == 0.0 ? 1000.0 / frameMs : 0.9 * fps + 0.1 * (1000.0 / frameMs);
+        }
         
         cv::Mat display = frame.clone();
         
-        if (!processing) {
-            // Canlı görüntü - yazı bölgelerini göster
-            auto regions = findTextRegions(frame);
-            
-            for (size_t i = 0; i < regions.size(); i++) {
-                cv::rectangle(display, regions[i], cv::Scalar(0, 255, 0), 2);
-                std::string label = "Bölge " + std::to_string(i + 1);
-                cv::putText(display, label,
-                           cv::Point(regions[i].x, regions[i].y - 5),
-                           cv::FONT_HERSHEY_SIMPLEX, 0.5,
-                           cv::Scalar(0, 255, 0), 1);
-            }
+        // Gelen OCR sonuçlarını çiz; önizleme okumayı beklemez
+        if (pending.active) {
+            collectResults(pending);
+        }
+        
+        // Canlı görüntü - yazı bölgeleri yalnızca her detectInterval karede yeniden aranır
+        if (framesSinceDetection >= detectInterval) {
+            auto detectStart = std::chrono::steady_clock::now();
+            previewRegions = findTextRegions(frame, preview.scale);
+            double ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - detectStart).count();
+            detectMs = detectMs == 0.0 ? ms : 0.8 * detectMs + 0.2 * ms;
+            totalDetectMs += ms;
+            detections++;
+            framesSinceDetection = 0;
             
-            // Bilgi
-            cv::putText(display, "SPACE: Yakala ve Oku | ESC: Cikis",
-                       cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX,
-                       0.7, cv::Scalar(0, 255, 0), 2);
+            // Kare başına düşen maliyet bütçeyi aşmasın
+            int needed = static_cast<int>(std::ceil(detectMs / preview.budgetMs));
+            detectInterval = std::min(MAX_DETECT_INTERVAL, std::max(preview.minInterval, needed));
+        }
+        framesSinceDetection++;
+        
+        const auto& regions = previewRegions;
+        for (size_t i = 0; i < regions.size(); i++) {
+            cv::rectangle(display, regions[i], cv::Scalar(0, 255, 0), 2);
+            std::string label = "Bölge " + std::to_string(i + 1);
+            cv::putText(display, label,
+                       cv::Point(regions[i].x, regions[i].y - 5),
+                       cv::FONT_HERSHEY_SIMPLEX, 0.5,
+                       cv::Scalar(0, 255, 0), 1);
+        }
+        
+        // Bilgi
+        cv::putText(display, "SPACE: Yakala ve Oku | ESC: Cikis",
+                   cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX,
+                   0.7, cv::Scalar(0, 255, 0), 2);
+        
+        char stats[96];
+        std::snprintf(stats, sizeof(stats), "FPS %.1f | tespit %.1f ms, %d karede bir, x%.2f",
+                      fps, detectMs, detectInterval, preview.scale);
+        cv::putText(display, stats, cv::Point(10, 60), cv::FONT_HERSHEY_SIMPLEX,
+                   0.6, cv::Scalar(255, 255, 255), 1);
+        
+        if (pending.active) {
+            std::string progress = "OKUNUYOR " + std::to_string(pending.completed) + "/" +
+                                   std::to_string(pending.futures.size());
+            cv::putText(display, progress, cv::Point(10, 90), cv::FONT_HERSHEY_SIMPLEX,
+                       0.7, cv::Scalar(0, 255, 255), 2);
         }
         
         cv::imshow("El Yazisi Okuyucu", display);
@@ -175,126 +551,50 @@ int main() {
         if (key == 27) { // ESC
             break;
         }
-        else if (key == 32 && !processing) { // SPACE
-            processing = true;
+        else if (key == 32) { // SPACE
+            // Yeni yakalama eski okumanın kalan işlerini geçersiz kılar
+            uint64_t generation = ocrWorkerPool.newGeneration();
+            if (pending.active) {
+                std::cout << "\n⏭️  Önceki okuma iptal edildi (" << pending.completed << "/"
+                          << pending.futures.size() << " bölge okunmuştu)" << std::endl;
+            }
+            pending = PendingCapture();
+            pending.captureTime = std::chrono::steady_clock::now();
             
             std::cout << "\n📸 Görüntü yakalandı!" << std::endl;
             std::cout << "🔍 Yazı bölgeleri aranıyor..." << std::endl;
             
-            auto regions = findTextRegions(frame);
+            // Worker'lar bu kopyadan okur; kamera tamponu bir sonraki karede değişir
+            cv::Mat captured = frame.clone();
+            auto regions = findTextRegions(captured);
             std::cout << "   Bulunan bölge: " << regions.size() << "\n" << std::endl;
             
             if (regions.empty()) {
                 std::cout << "⚠️  Hiç yazı bulunamadı!\n" << std::endl;
-                processing = false;
                 continue;
             }
             
-            // Her bölgeyi işle
-            cv::Mat result = frame.clone();
+            pending.active = true;
+            pending.result = captured.clone();
+            pending.done.assign(regions.size(), false);
             int questionNum = 1;
-            int correct = 0;
-            int wrong = 0;
-            
             for (const auto& region : regions) {
-                // ROI kaydet
-                cv::Mat roi = frame(region);
-                std::string filename = "temp_region.jpg";
-                cv::imwrite(filename, roi);
-                
-                // Tesseract ile oku
-                std::string cmd = "tesseract " + filename + " stdout -l tur --psm 3 2>/dev/null";
-                FILE* pipe = popen(cmd.c_str(), "r");
-                
-                std::string ocrText = "";
-                if (pipe) {
-                    char buffer[256];
-                    while (fgets(buffer, sizeof(buffer), pipe) != NULL) {
-                        ocrText += buffer;
-                    }
-                    pclose(pipe);
-                }
-                
-                // Temizle
-                ocrText.erase(0, ocrText.find_first_not_of(" \n\r\t"));
-                ocrText.erase(ocrText.find_last_not_of(" \n\r\t") + 1);
-                
-                // Karşılaştır
-                bool isCorrect = false;
-                std::string expected = "";
-                
-                if (answerKey.count(questionNum)) {
-                    expected = answerKey[questionNum];
-                    isCorrect = !ocrText.empty() && compareAnswers(ocrText, expected);
-                }
-                
-                // Görselleştir
-                cv::Scalar color = ocrText.empty() ? cv::Scalar(128, 128, 128) :
-                                  (isCorrect ? cv::Scalar(0, 255, 0) : cv::Scalar(0, 0, 255));
-                
-                cv::rectangle(result, region, color, 3);
-                
-                // Label
-                std::string label = "Q" + std::to_string(questionNum);
-                cv::putText(result, label,
-                           cv::Point(region.x, region.y - 5),
-                           cv::FONT_HERSHEY_SIMPLEX, 0.6, color, 2);
-                
-                // İkon
-                if (!ocrText.empty()) {
-                    std::string icon = isCorrect ? "✓" : "✗";
-                    cv::putText(result, icon,
-                               cv::Point(region.x + region.width + 10, region.y + 30),
-                               cv::FONT_HERSHEY_SIMPLEX, 1.0, color, 2);
-                    
-                    if (isCorrect) correct++;
-                    else wrong++;
-                }
-                
-                // Konsol çıktısı
-                std::cout << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
-                std::cout << "Soru " << questionNum << ":" << std::endl;
-                std::cout << "  Okunan: ";
-                if (ocrText.empty()) {
-                    std::cout << "(boş)" << std::endl;
-                } else {
-                    std::cout << "\"" << ocrText << "\"" << std::endl;
-                }
-                
-                if (!expected.empty()) {
-                    std::cout << "  Beklenen: \"" << expected << "\"" << std::endl;
-                    std::cout << "  Sonuç: " << (isCorrect ? "✅ DOĞRU" : "❌ YANLIŞ") << std::endl;
-                }
-                std::cout << std::endl;
-                
+                // ROI doğrudan bellekten okunur (geçici dosya / süreç yok)
+                pending.futures.push_back(ocrWorkerPool.submit(generation, questionNum, captured(region), region));
                 questionNum++;
             }
-            
-            // Özet
-            std::cout << "╔══════════════════════════════════════════════╗" << std::endl;
-            std::cout << "║   SONUÇLAR                                   ║" << std::endl;
-            std::cout << "╚══════════════════════════════════════════════╝" << std::endl;
-            std::cout << "Toplam Bölge: " << regions.size() << std::endl;
-            std::cout << "✅ Doğru: " << correct << std::endl;
-            std::cout << "❌ Yanlış: " << wrong << std::endl;
-            
-            if (correct + wrong > 0) {
-                int percentage = (correct * 100) / (correct + wrong);
-                std::cout << "📊 Başarı: %" << percentage << std::endl;
-            }
-            std::cout << "══════════════════════════════════════════════\n" << std::endl;
-            
-            // Sonuç görüntüsünü göster
-            cv::imshow("SONUC", result);
-            cv::imwrite("last_result.jpg", result);
-            std::cout << "💾 Sonuç kaydedildi: last_result.jpg" << std::endl;
-            std::cout << "\nYeni okuma için SPACE, çıkmak için ESC" << std::endl;
-            
-            processing = false;
         }
     }
     
-    camera.release();
+    // Önizleme özeti: kayıtlı kaynakla tekrarlanabilir bir ölçüm
+    double previewSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - previewStart).count();
+    if (previewFrames > 0 && previewSec > 0.0) {
+        std::cout << "Önizleme: " << previewFrames << " kare, " << (previewFrames / previewSec) << " FPS, "
+                  << detections << " tespit (ort. "
+                  << (detections > 0 ? totalDetectMs / detections : 0.0) << " ms)" << std::endl;
+    }
+    
+    camera->release();
     cv::destroyAllWindows();
     
     return 0;
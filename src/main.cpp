@@ -4,33 +4,7 @@
  * 
  * Features:
  * - Real-time camera capture
-            case QuestionRegion::FILL_IN_BLANK: {
-                // Check for handwriting
-                if (handwritingDetector.hasHandwriting(correctedSheet, region.region)) {
-                    // Extract and process with OCR
-                    cv::Mat roi = handwritingDetector.extractHandwritingROI(
-                        correctedSheet, region.region
-                    );
-                    
-                    std::cout << "[DEBUG] ROI boyutu: " << roi.cols << "x" << roi.rows << std::endl;
-                    
-                    // Save ROI for debugging
-                    std::string roiFilename = "debug_roi_q" + std::to_string(region.questionNumber) + ".jpg";
-                    cv::imwrite(roiFilename, roi);
-                    std::cout << "[DEBUG] ROI kaydedildi: " << roiFilename << std::endl;
-                    
-                    std::string text = ocrProcessor.recognizeText(roi);
-                    answer.textAnswer = text;
-                    
-                    std::cout << "Soru " << region.questionNumber 
-                             << ": \"" << text << "\"" << std::endl;
-                } else {
-                    answer.textAnswer = "";
-                    std::cout << "Soru " << region.questionNumber 
-                             << ": Boş" << std::endl;
-                }
-                break;
-            }rection
+ * - Perspective correction
  * - Multiple choice bubble detection
  * - Fill-in-the-blank handwriting recognition (OCR)
  * - True/False question support
@@ -38,28 +12,42 @@
  */
 
 #include "CameraManager.h"
-#include "PerspectiveCorrector.h"
-#include "ImageEnhancer.h"
-#include "BubbleDetector.h"
-#include "HandwritingDetector.h"
+#include "FrameSource.h"
 #include "OCRProcessor.h"
+#include "SheetGrader.h"
+#include "SheetTracker.h"
+#include "DocumentSession.h"
+#include "BatchGrader.h"
+#include "DebugArtifactSink.h"
 #include "SheetStructureAnalyzer.h"
 #include "AnswerKey.h"
 #include "AnswerComparator.h"
 #include "ScoreCalculator.h"
 #include "ResultDisplayer.h"
 #include "FileWriter.h"
+#include "GroundTruth.h"
+#include "MetricsExporter.h"
+#include "Tracer.h"
 
 #include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
 
 // Configuration
 constexpr int CAMERA_ID = 0;
 constexpr bool USE_CAMERA = true;  // Set to false to use test image
+constexpr int AUTO_CAPTURE_FRAMES = 15;  // kağıt bu kadar kare sabit kalınca otomatik çek (0 = kapalı)
 const std::string TEST_IMAGE_PATH = "test_exam.jpg";
 const std::string ANSWER_KEY_PATH = "answer_key.txt";
+const std::string SHEET_TEMPLATE_PATH = "sheet_template.yml";  // yoksa varsayılan yerleşim
 
 /**
  * @brief Create example answer key
@@ -98,116 +86,455 @@ void createExampleAnswerKey(AnswerKey& answerKey) {
 }
 
 /**
- * @brief Process exam sheet and extract answers
+ * @brief Load answer key from file, or create and save the example key
  */
-std::vector<Answer> processExamSheet(
-    const cv::Mat& examSheet,
-    const std::vector<QuestionRegion>& regions,
-    BubbleDetector& bubbleDetector,
-    HandwritingDetector& handwritingDetector,
-    OCRProcessor& ocrProcessor,
-    ImageEnhancer& imageEnhancer) {
-    
-    std::vector<Answer> studentAnswers;
-    
-    for (const auto& region : regions) {
-        Answer answer;
-        answer.questionNumber = region.questionNumber;
-        answer.type = static_cast<Answer::Type>(region.type);
-        
-        switch (region.type) {
-            case QuestionRegion::MULTIPLE_CHOICE: {
-                // Detect marked bubble
-                int markedOption = bubbleDetector.detectMarkedAnswer(
-                    examSheet,
-                    region.region,
-                    region.numOptions
-                );
-                answer.selectedOption = markedOption;
-                
-                if (markedOption >= 0) {
-                    std::cout << "Soru " << region.questionNumber 
-                             << ": Seçenek " << static_cast<char>('A' + markedOption) 
-                             << std::endl;
-                } else {
-                    std::cout << "Soru " << region.questionNumber 
-                             << ": İşaretlenmemiş veya çoklu işaret" << std::endl;
-                }
-                break;
+void loadAnswerKey(AnswerKey& answerKey) {
+    if (!answerKey.loadFromFile(ANSWER_KEY_PATH)) {
+        std::cout << "Cevap anahtarı bulunamadı, örnek oluşturuluyor..." << std::endl;
+        createExampleAnswerKey(answerKey);
+        answerKey.saveToFile(ANSWER_KEY_PATH);
+    }
+}
+
+/**
+ * @brief Metric export flags shared by batch and session modes
+ */
+struct MetricsOptions {
+    int port = 0;                   // 0 = uç nokta kapalı
+    std::string file;               // boş = dosyaya döküm yok
+    double intervalSeconds = 10.0;
+};
+
+// Consumes one --metrics-* flag at argv[i]; false if argv[i] is not one
+bool parseMetricsArg(int argc, char** argv, int& i, MetricsOptions& metrics) {
+    std::string arg = argv[i];
+    if (arg == "--metrics-port" && i + 1 < argc) {
+        metrics.port = std::stoi(argv[++i]);
+    } else if (arg == "--metrics-file" && i + 1 < argc) {
+        metrics.file = argv[++i];
+    } else if (arg == "--metrics-interval" && i + 1 < argc) {
+        metrics.intervalSeconds = std::stod(argv[++i]);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool startMetrics(MetricsExporter& exporter, const MetricsOptions& metrics) {
+    if (metrics.port > 0 && !exporter.startHttp(metrics.port)) {
+        return false;
+    }
+    if (!metrics.file.empty() && !exporter.startFileDump(metrics.file, metrics.intervalSeconds)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Headless batch mode: grade a directory or manifest of scans with a worker pool
+ *
+ * Kullanım: OMR_System --batch <klasör|manifest.txt> [--threads N] [--output sonuc.csv]
+ *                       [--template sablon.yml] [--debug-artifacts off|basic|verbose]
+ *                       [--debug-dir klasör] [--warp color|gray|regions] [--ground-truth gt.csv]
+ *                       [--metrics-port N] [--metrics-file metrics.prom] [--metrics-interval sn]
+ *
+ * --ground-truth ile (sheet_generator çıktısı) okunan cevaplar gerçek cevaplarla karşılaştırılır
+ * ve balon / yazı doğruluğu raporlanır. --metrics-* ile aşama süreleri, OCR güveni ve sayaçlar
+ * Prometheus metni olarak 127.0.0.1:N/metrics üzerinden ve/veya aralıklı dosya dökümüyle açılır.
+ */
+int runBatchMode(int argc, char** argv, const AnswerKey& answerKey) {
+    if (argc < 3) {
+        std::cerr << "Kullanım: " << argv[0]
+                  << " --batch <klasör|manifest.txt> [--threads N] [--output sonuc.csv]"
+                  << " [--template sablon.yml] [--debug-artifacts off|basic|verbose]"
+                  << " [--debug-dir klasör] [--warp color|gray|regions] [--ground-truth gt.csv]"
+                  << " [--metrics-port N] [--metrics-file metrics.prom] [--metrics-interval sn]" << std::endl;
+        return -1;
+    }
+
+    std::string input = argv[2];
+    std::string outputPath;
+    std::string groundTruthPath;
+    MetricsOptions metrics;
+    BatchOptions options;
+    bool debugRequested = false;
+    DebugArtifactSink::Level debugLevel = DebugArtifactSink::OFF;
+    std::string debugDir = ".";
+
+    for (int i = 3; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            options.numWorkers = std::stoi(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--template" && i + 1 < argc) {
+            options.templatePath = argv[++i];
+        } else if (arg == "--debug-artifacts" && i + 1 < argc) {
+            if (!DebugArtifactSink::parseLevel(argv[++i], debugLevel)) {
+                std::cerr << "HATA: Geçersiz debug seviyesi: " << argv[i] << std::endl;
+                return -1;
             }
-            
-            case QuestionRegion::FILL_IN_BLANK: {
-                // Check for handwriting
-                if (handwritingDetector.hasHandwriting(examSheet, region.region)) {
-                    // Extract and process with OCR
-                    cv::Mat roi = handwritingDetector.extractHandwritingROI(
-                        examSheet, region.region
-                    );
-                    
-                    std::string text = ocrProcessor.recognizeText(roi);
-                    answer.textAnswer = text;
-                    
-                    std::cout << "Soru " << region.questionNumber 
-                             << ": \"" << text << "\"" << std::endl;
-                } else {
-                    answer.textAnswer = "";
-                    std::cout << "Soru " << region.questionNumber 
-                             << ": Boş" << std::endl;
-                }
-                break;
+            debugRequested = true;
+        } else if (arg == "--debug-dir" && i + 1 < argc) {
+            debugDir = argv[++i];
+        } else if (arg == "--warp" && i + 1 < argc) {
+            std::string warp = argv[++i];
+            if (warp != "color" && warp != "gray" && warp != "regions") {
+                std::cerr << "HATA: Geçersiz warp modu: " << warp << std::endl;
+                return -1;
             }
-            
-            case QuestionRegion::TRUE_FALSE: {
-                // Similar to multiple choice but with 2 options
-                int markedOption = bubbleDetector.detectMarkedAnswer(
-                    examSheet,
-                    region.region,
-                    2
-                );
-                answer.selectedOption = markedOption;
-                
-                if (markedOption >= 0) {
-                    std::cout << "Soru " << region.questionNumber 
-                             << ": " << (markedOption == 0 ? "Doğru" : "Yanlış") 
-                             << std::endl;
+            options.grayWarp = warp != "color";
+            options.regionWarp = warp == "regions";
+        } else if (arg == "--ground-truth" && i + 1 < argc) {
+            groundTruthPath = argv[++i];
+        } else if (!parseMetricsArg(argc, argv, i, metrics)) {
+            std::cerr << "HATA: Bilinmeyen argüman: " << arg << std::endl;
+            return -1;
+        }
+    }
+
+    GroundTruth groundTruth;
+    if (!groundTruthPath.empty() && !groundTruth.loadFromFile(groundTruthPath)) {
+        return -1;
+    }
+
+    std::vector<std::string> imagePaths = BatchGrader::collectImagePaths(input);
+    if (imagePaths.empty()) {
+        std::cerr << "HATA: İşlenecek görüntü bulunamadı: " << input << std::endl;
+        return -1;
+    }
+
+    // Parallelism comes from the sheet workers; keep OpenCV from oversubscribing cores
+    cv::setNumThreads(1);
+
+    // Command line overrides OMR_DEBUG_ARTIFACTS
+    if (debugRequested) {
+        DebugArtifactSink::instance().configure(debugLevel, debugDir);
+    }
+
+    MetricsExporter metricsExporter;
+    if (!startMetrics(metricsExporter, metrics)) {
+        return -1;
+    }
+
+    BatchGrader batchGrader(answerKey, options);
+    std::cout << "\nToplu mod: " << imagePaths.size() << " kağıt, "
+              << batchGrader.getWorkerCount() << " worker" << std::endl;
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<SheetResult> results = batchGrader.gradeFiles(imagePaths);
+    auto endTime = std::chrono::steady_clock::now();
+
+    // Debug writes happen off the grading path; make sure they land before exit
+    DebugArtifactSink::instance().shutdown();
+    metricsExporter.stop();
+
+    if (results.empty()) {
+        std::cerr << "HATA: Toplu değerlendirme başlatılamadı!" << std::endl;
+        return -1;
+    }
+
+    double elapsedSec = std::chrono::duration<double>(endTime - startTime).count();
+
+    size_t failed = 0;
+    for (const auto& result : results) {
+        if (!result.success) {
+            failed++;
+            std::cerr << "Başarısız: " << result.sheetId << " (" << result.errorMessage << ")" << std::endl;
+        }
+    }
+
+    FileWriter fileWriter;
+    if (outputPath.empty()) {
+        outputPath = fileWriter.createTimestampedFilename("batch", "_results.csv");
+    }
+    fileWriter.saveBatchResultsToCSV(outputPath, results);
+
+    std::cout << "\n" << std::string(50, '=') << std::endl;
+    std::cout << "İşlenen kağıt:  " << results.size() << std::endl;
+    std::cout << "Başarısız:      " << failed << std::endl;
+    std::cout << "Toplam süre:    " << elapsedSec << " s" << std::endl;
+    if (elapsedSec > 0.0) {
+        std::cout << "Hız:            " << (results.size() / elapsedSec) << " kağıt/s" << std::endl;
+    }
+
+    OCRPoolStats poolStats = batchGrader.getOCRPoolStats();
+    std::cout << "OCR ısınma:     " << poolStats.warmupMs << " ms ("
+              << poolStats.poolSize << " motor)" << std::endl;
+    std::cout << "OCR bekleme:    ort. " << poolStats.averageWaitMs << " ms, maks. "
+              << poolStats.maxWaitMs << " ms" << std::endl;
+
+    if (groundTruth.getSheetCount() > 0) {
+        AccuracyStats accuracy = groundTruth.evaluate(results, AnswerComparator(false));
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "\nDoğruluk (" << accuracy.sheetsEvaluated << " kağıt";
+        if (accuracy.sheetsFailed > 0) {
+            std::cout << ", " << accuracy.sheetsFailed << " okunamadı";
+        }
+        if (accuracy.sheetsWithoutTruth > 0) {
+            std::cout << ", " << accuracy.sheetsWithoutTruth << " gerçek cevapsız";
+        }
+        std::cout << ")" << std::endl;
+        std::cout << "Balon:          %" << (100.0 * accuracy.bubbleAccuracy()) << " ("
+                  << accuracy.bubbleCorrect << "/" << accuracy.bubbleQuestions << "), kaçırılan "
+                  << accuracy.missedMarks << ", yanlış işaret " << accuracy.falseMarks << std::endl;
+        std::cout << "Yazı:           %" << (100.0 * accuracy.textAccuracy()) << " tam eşleşme, ort. benzerlik "
+                  << accuracy.meanTextSimilarity() << std::endl;
+        std::cout << "Hatasız kağıt:  " << accuracy.perfectSheets << "/" << accuracy.sheetsEvaluated << std::endl;
+    }
+    std::cout << std::string(50, '=') << std::endl;
+
+    return failed == results.size() ? -1 : 0;
+}
+
+/**
+ * @brief Document-camera session: sheets flipped under the camera are captured and graded unattended
+ *
+ * Kullanım: OMR_System --session [--threads N] [--output sonuc.csv] [--template sablon.yml]
+ *                       [--warp color|gray|regions] [--source kamera_id|video.mp4|kare_klasörü]
+ *                       [--replay realtime|fast] [--headless]
+ *                       [--metrics-port N] [--metrics-file metrics.prom] [--metrics-interval sn]
+ *
+ * Kayıtlı bir kaynak ve --headless ile oturum, webcam olmadan tekrarlanabilir bir kare hızı
+ * ve yakalama → sonuç gecikmesi ölçümüne dönüşür.
+ */
+int runSessionMode(int argc, char** argv, const AnswerKey& answerKey) {
+    std::string outputPath;
+    std::string sourceSpec = std::to_string(CAMERA_ID);
+    FrameSource::Pacing pacing = FrameSource::REALTIME;
+    bool headless = false;
+    MetricsOptions metrics;
+    BatchOptions options;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            options.numWorkers = std::stoi(argv[++i]);
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--template" && i + 1 < argc) {
+            options.templatePath = argv[++i];
+        } else if (arg == "--warp" && i + 1 < argc) {
+            std::string warp = argv[++i];
+            if (warp != "color" && warp != "gray" && warp != "regions") {
+                std::cerr << "HATA: Geçersiz warp modu: " << warp << std::endl;
+                return -1;
+            }
+            options.grayWarp = warp != "color";
+            options.regionWarp = warp == "regions";
+        } else if (arg == "--source" && i + 1 < argc) {
+            sourceSpec = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            if (!FrameSource::parsePacing(argv[++i], pacing)) {
+                std::cerr << "HATA: Geçersiz oynatma modu: " << argv[i] << std::endl;
+                return -1;
+            }
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (!parseMetricsArg(argc, argv, i, metrics)) {
+            std::cerr << "HATA: Bilinmeyen argüman: " << arg << std::endl;
+            return -1;
+        }
+    }
+
+    // One core stays with the camera and the preview loop
+    if (options.numWorkers <= 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        options.numWorkers = hardwareThreads > 1 ? static_cast<int>(hardwareThreads) - 1 : 1;
+    }
+    cv::setNumThreads(1);
+
+    MetricsExporter metricsExporter;
+    if (!startMetrics(metricsExporter, metrics)) {
+        return -1;
+    }
+
+    // Capture → result latency per sheet, measured in the result callback
+    std::mutex printMutex;
+    std::map<std::string, std::chrono::steady_clock::time_point> submitTimes;
+    std::vector<double> latenciesMs;
+
+    BatchGrader batchGrader(answerKey, options);
+    batchGrader.setResultCallback([&](size_t, const SheetResult& result) {
+        std::lock_guard<std::mutex> lock(printMutex);
+        auto submitted = submitTimes.find(result.sheetId);
+        if (submitted != submitTimes.end()) {
+            latenciesMs.push_back(std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - submitted->second).count());
+        }
+        if (result.success) {
+            std::cout << result.sheetId << ": " << result.score.correctAnswers << "/"
+                      << result.score.totalQuestions << " doğru, %" << result.score.percentageScore
+                      << " (" << result.processingMs << " ms)" << std::endl;
+        } else {
+            std::cerr << result.sheetId << ": başarısız (" << result.errorMessage << ")" << std::endl;
+        }
+    });
+
+    if (!batchGrader.start()) {
+        std::cerr << "HATA: Değerlendirme başlatılamadı!" << std::endl;
+        return -1;
+    }
+
+    CameraManager camera;
+    std::unique_ptr<FrameSource> source = FrameSource::create(sourceSpec, pacing);
+    bool opened = source->isLive() ? camera.initCamera(std::stoi(sourceSpec)) : camera.openSource(std::move(source));
+    if (!opened) {
+        std::cerr << "HATA: Kare kaynağı açılamadı: " << sourceSpec << std::endl;
+        batchGrader.finish();
+        return -1;
+    }
+
+    // Fast replay reads every frame in order; live and real-time sources go through the grabber
+    bool sequential = !camera.getSource()->isLive() && pacing == FrameSource::AS_FAST_AS_POSSIBLE;
+    if (!sequential && !camera.startGrabber()) {
+        std::cerr << "HATA: Kare yakalayıcı başlatılamadı!" << std::endl;
+        batchGrader.finish();
+        return -1;
+    }
+
+    std::cout << "\nOturum modu: kağıtları kameranın altında çevirin, her yeni kağıt sabitlenince "
+              << "otomatik çekilir. " << (headless ? "Kaynak bitince" : "ESC:") << " Bitir" << std::endl;
+
+    DocumentSession session;
+    DocumentSession::Event event = DocumentSession::MOVING;
+    cv::Mat frame;
+    size_t processedFrames = 0;
+    double updateMs = 0.0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    while (true) {
+        bool fresh = sequential ? camera.readNextFrame(frame) : camera.getLatestFrame(frame);
+        if (fresh) {
+            auto updateStart = std::chrono::steady_clock::now();
+            event = session.update(frame);
+            updateMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
+            processedFrames++;
+
+            if (event == DocumentSession::CAPTURED) {
+                char sheetId[32];
+                std::snprintf(sheetId, sizeof(sheetId), "kagit_%04zu", session.getStats().captured);
+                {
+                    std::lock_guard<std::mutex> lock(printMutex);
+                    submitTimes[sheetId] = std::chrono::steady_clock::now();
+                }
+                // The frame is a view into the camera buffer; the worker gets its own copy
+                batchGrader.submitImage(sheetId, frame.clone());
+                if (session.isSuspectedDuplicate()) {
+                    std::lock_guard<std::mutex> lock(printMutex);
+                    std::cout << "Uyarı: " << sheetId << " önceki kağıda çok benziyor; "
+                              << "aynı sayfa tekrar çekilmiş olabilir" << std::endl;
                 }
-                break;
             }
+
+            if (!headless) {
+                cv::Mat preview = frame.clone();
+                session.drawOverlay(preview, event);
+                cv::imshow("Oturum - ESC ile bitir", preview);
+            }
+        } else if (camera.isFinished()) {
+            std::cout << "Kaynak sona erdi" << std::endl;
+            break;
+        } else if (headless && !sequential) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if (!headless && cv::waitKey(1) == 27) { // ESC
+            break;
         }
-        
-        studentAnswers.push_back(answer);
     }
-    
-    return studentAnswers;
+
+    double captureSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    CameraStats cameraStats = camera.getStats();
+    camera.releaseCamera();
+    if (!headless) {
+        cv::destroyAllWindows();
+    }
+
+    std::cout << "Kuyruktaki kağıtlar bekleniyor..." << std::endl;
+    std::vector<SheetResult> results = batchGrader.finish();
+    metricsExporter.stop();
+    double elapsedMin = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() / 60.0;
+
+    if (!results.empty()) {
+        FileWriter fileWriter;
+        if (outputPath.empty()) {
+            outputPath = fileWriter.createTimestampedFilename("session", "_results.csv");
+        }
+        fileWriter.saveBatchResultsToCSV(outputPath, results);
+    }
+
+    const SessionStats& stats = session.getStats();
+    std::cout << "\n" << std::string(50, '=') << std::endl;
+    std::cout << "Çekilen kağıt:  " << stats.captured << std::endl;
+    std::cout << "Olası tekrar:   " << stats.suspectedDuplicates << " (değerlendirildi)" << std::endl;
+    std::cout << "Bulanık kare:   " << stats.blurryFrames << " / " << stats.frames << std::endl;
+    std::cout << "Kare:           " << processedFrames << " işlendi, " << cameraStats.droppedFrames
+              << " düşürüldü";
+    if (captureSec > 0.0) {
+        std::cout << ", " << (processedFrames / captureSec) << " kare/s";
+    }
+    if (processedFrames > 0) {
+        std::cout << ", update ort. " << (updateMs / processedFrames) << " ms";
+    }
+    std::cout << std::endl;
+    if (!latenciesMs.empty()) {
+        std::sort(latenciesMs.begin(), latenciesMs.end());
+        std::cout << "Gecikme:        medyan " << latenciesMs[latenciesMs.size() / 2] << " ms, maks. "
+                  << latenciesMs.back() << " ms (yakalama → sonuç)" << std::endl;
+    }
+    if (elapsedMin > 0.0) {
+        std::cout << "Hız:            " << (stats.captured / elapsedMin) << " kağıt/dk" << std::endl;
+    }
+    std::cout << std::string(50, '=') << std::endl;
+
+    return 0;
 }
 
 /**
  * @brief Main application entry point
  */
 int main(int argc, char** argv) {
+    // With -DOMR_ENABLE_TRACING=ON the spans of every mode are written to OMR_TRACE_FILE on exit
+    OMR_TRACE_SESSION();
+    
     std::cout << "OMR Sistemi Başlatılıyor..." << std::endl;
     std::cout << std::string(50, '=') << std::endl;
     
     try {
+        // Create or load answer key
+        AnswerKey answerKey;
+        loadAnswerKey(answerKey);
+        
+        // Debug images stay off unless OMR_DEBUG_ARTIFACTS asks for them
+        DebugArtifactSink::instance().configureFromEnvironment();
+        
+        // Headless batch mode never opens a window
+        if (argc > 1 && std::string(argv[1]) == "--batch") {
+            return runBatchMode(argc, argv, answerKey);
+        }
+        if (argc > 1 && std::string(argv[1]) == "--session") {
+            return runSessionMode(argc, argv, answerKey);
+        }
+        
         // Initialize modules
         std::unique_ptr<CameraManager> camera;
-        std::unique_ptr<PerspectiveCorrector> perspectiveCorrector = 
-            std::make_unique<PerspectiveCorrector>();
-        std::unique_ptr<ImageEnhancer> imageEnhancer = 
-            std::make_unique<ImageEnhancer>();
-        std::unique_ptr<BubbleDetector> bubbleDetector = 
-            std::make_unique<BubbleDetector>(0.6);
-        std::unique_ptr<HandwritingDetector> handwritingDetector = 
-            std::make_unique<HandwritingDetector>(0.02);  // %5 -> %2'ye düşürdük
         std::unique_ptr<OCRProcessor> ocrProcessor = 
             std::make_unique<OCRProcessor>("tur");
-        std::unique_ptr<SheetStructureAnalyzer> sheetAnalyzer = 
-            std::make_unique<SheetStructureAnalyzer>();
+        std::unique_ptr<SheetGrader> sheetGrader = 
+            std::make_unique<SheetGrader>(*ocrProcessor, 0.6, 0.02);  // %5 -> %2'ye düşürdük
         std::unique_ptr<ResultDisplayer> resultDisplayer = 
             std::make_unique<ResultDisplayer>();
         std::unique_ptr<FileWriter> fileWriter = 
             std::make_unique<FileWriter>();
         
+        // Optional data-driven layout next to the answer key
+        std::ifstream templateFile(SHEET_TEMPLATE_PATH);
+        if (templateFile.good() && !sheetGrader->loadTemplate(SHEET_TEMPLATE_PATH)) {
+            std::cerr << "Uyarı: " << SHEET_TEMPLATE_PATH << " okunamadı, varsayılan yerleşim kullanılıyor"
+                      << std::endl;
+        }
+        
         // Check OCR initialization
         if (!ocrProcessor->isInitialized()) {
             std::cerr << "HATA: OCR başlatılamadı! Tesseract kurulu olduğundan emin olun." 
@@ -215,14 +542,6 @@ int main(int argc, char** argv) {
             return -1;
         }
         
-        // Create or load answer key
-        AnswerKey answerKey;
-        if (!answerKey.loadFromFile(ANSWER_KEY_PATH)) {
-            std::cout << "Cevap anahtarı bulunamadı, örnek oluşturuluyor..." << std::endl;
-            createExampleAnswerKey(answerKey);
-            answerKey.saveToFile(ANSWER_KEY_PATH);
-        }
-        
         // Initialize grading
         AnswerComparator comparator(false); // Case-insensitive
         ScoreCalculator scoreCalculator(answerKey, comparator);
@@ -242,25 +561,51 @@ int main(int argc, char** argv) {
             
             std::cout << "\nKamera hazır. Sınav kağıdını görüntüye alın..." << std::endl;
             std::cout << "SPACE tuşu: Fotoğraf çek | ESC: Çıkış" << std::endl;
+            if (AUTO_CAPTURE_FRAMES > 0) {
+                std::cout << "Kağıt " << AUTO_CAPTURE_FRAMES
+                          << " kare sabit kalınca otomatik çekilir" << std::endl;
+            }
+            
+            // Full detection only until the sheet is found, then corners are tracked
+            SheetTracker tracker;
+            
+            // Capture runs on its own thread; the loop always works on the newest frame
+            if (!camera->startGrabber()) {
+                std::cerr << "HATA: Kare yakalayıcı başlatılamadı!" << std::endl;
+                return -1;
+            }
             
             // Live camera feed
+            cv::Mat frame;      // view into the camera's triple buffer, valid until the next fetch
             while (true) {
-                cv::Mat frame = camera->captureFrame();
-                
-                // Show live feed
-                cv::imshow("Kamera - SPACE ile çek, ESC ile çık", frame);
+                if (camera->getLatestFrame(frame)) {
+                    tracker.update(frame);
+                    
+                    if (AUTO_CAPTURE_FRAMES > 0 && tracker.getStableFrames() >= AUTO_CAPTURE_FRAMES) {
+                        examSheet = frame.clone();
+                        std::cout << "Fotoğraf otomatik çekildi!" << std::endl;
+                        break;
+                    }
+                    
+                    // Show live feed with the tracked outline; the frame itself stays clean
+                    cv::Mat preview = frame.clone();
+                    tracker.drawOverlay(preview, AUTO_CAPTURE_FRAMES);
+                    cv::imshow("Kamera - SPACE ile çek, ESC ile çık", preview);
+                }
                 
-                int key = cv::waitKey(30);
+                // waitKey(1): frames that arrive while we process are dropped, not queued
+                int key = cv::waitKey(1);
                 if (key == 27) { // ESC
                     std::cout << "Çıkış yapılıyor..." << std::endl;
                     return 0;
-                } else if (key == 32) { // SPACE
+                } else if (key == 32 && !frame.empty()) { // SPACE
                     examSheet = frame.clone();
                     std::cout << "Fotoğraf çekildi!" << std::endl;
                     break;
                 }
             }
             
+            camera->stopGrabber();
             cv::destroyAllWindows();
             
         } else {
@@ -281,31 +626,40 @@ int main(int argc, char** argv) {
         
         // Step 1: Perspective correction
         std::cout << "\n1. Perspektif düzeltiliyor..." << std::endl;
-        cv::Mat correctedSheet = perspectiveCorrector->correctPerspective(examSheet);
+        cv::Mat correctedSheet;
+        {
+            OMR_TRACE_SCOPE("1. perspektif");
+            correctedSheet = sheetGrader->correctPerspective(examSheet);
+        }
         
         // Step 2: Analyze sheet structure
         std::cout << "\n2. Sınav yapısı analiz ediliyor..." << std::endl;
-        std::vector<QuestionRegion> regions = sheetAnalyzer->analyzeSheet(correctedSheet);
+        std::vector<QuestionRegion> regions;
+        {
+            OMR_TRACE_SCOPE("2. yapı analizi");
+            regions = sheetGrader->analyzeStructure(correctedSheet);
+        }
         
         // Visualize regions (optional)
-        cv::Mat regionVis = sheetAnalyzer->visualizeRegions(correctedSheet, regions);
+        cv::Mat regionVis = sheetGrader->visualizeRegions(correctedSheet, regions);
         cv::imshow("Tespit Edilen Bölgeler", regionVis);
         cv::waitKey(1000);
         
         // Step 3: Process answers
         std::cout << "\n3. Cevaplar işleniyor..." << std::endl;
-        std::vector<Answer> studentAnswers = processExamSheet(
-            correctedSheet,
-            regions,
-            *bubbleDetector,
-            *handwritingDetector,
-            *ocrProcessor,
-            *imageEnhancer
-        );
+        std::vector<Answer> studentAnswers;
+        {
+            OMR_TRACE_SCOPE("3. cevaplar");
+            studentAnswers = sheetGrader->readAnswers(correctedSheet, regions);
+        }
         
         // Step 4: Calculate score
         std::cout << "\n4. Puan hesaplanıyor..." << std::endl;
-        ExamScore score = scoreCalculator.calculateScore(studentAnswers);
+        ExamScore score;
+        {
+            OMR_TRACE_SCOPE("4. puanlama");
+            score = scoreCalculator.calculateScore(studentAnswers);
+        }
         
         // Calculate processing time
         auto endTime = std::chrono::high_resolution_clock::now();
@@ -317,18 +671,22 @@ int main(int argc, char** argv) {
         
         // Step 5: Display results
         std::cout << "\n5. Sonuçlar gösteriliyor..." << std::endl;
-        resultDisplayer->displayScoreSummary(score);
-        resultDisplayer->displayDetailedResults(score);
-        
-        auto stats = scoreCalculator.getStatistics(score);
-        resultDisplayer->displayStatistics(stats);
-        
-        // Create visual results
-        cv::Mat resultImage = resultDisplayer->createVisualResults(
-            correctedSheet,
-            score,
-            regions
-        );
+        cv::Mat resultImage;
+        {
+            OMR_TRACE_SCOPE("5. sonuç gösterimi");
+            resultDisplayer->displayScoreSummary(score);
+            resultDisplayer->displayDetailedResults(score);
+            
+            auto stats = scoreCalculator.getStatistics(score);
+            resultDisplayer->displayStatistics(stats);
+            
+            // Create visual results
+            resultImage = resultDisplayer->createVisualResults(
+                correctedSheet,
+                score,
+                regions
+            );
+        }
         
         resultDisplayer->displayInWindow("Sonuçlar", resultImage, 0);
         
@@ -338,9 +696,12 @@ int main(int argc, char** argv) {
         std::string timestamp = fileWriter->createTimestampedFilename("exam", "");
         timestamp = timestamp.substr(0, timestamp.length() - 0); // Remove extension
         
-        fileWriter->saveResultsToText(timestamp + "_results.txt", score);
-        fileWriter->saveResultsToCSV(timestamp + "_results.csv", score);
-        fileWriter->saveResultImage(timestamp + "_results.jpg", resultImage);
+        {
+            OMR_TRACE_SCOPE("6. dosya çıktısı");
+            fileWriter->saveResultsToText(timestamp + "_results.txt", score);
+            fileWriter->saveResultsToCSV(timestamp + "_results.csv", score);
+            fileWriter->saveResultImage(timestamp + "_results.jpg", resultImage);
+        }
         
         std::cout << "\n✓ İşlem tamamlandı!" << std::endl;
         std::cout << "Sonuçlar '" << timestamp << "' öneki ile kaydedildi." << std::endl;
@@ -0,0 +1,239 @@
+#include "OCREnginePool.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+// Lease
+// ---------------------------------------------------------------------------
+
+OCREnginePool::Lease::Lease() : pool(nullptr), engine(nullptr) {
+}
+
+OCREnginePool::Lease::Lease(OCREnginePool* pool, OCRProcessor* engine)
+    : pool(pool), engine(engine) {
+}
+
+OCREnginePool::Lease::Lease(Lease&& other) noexcept
+    : pool(other.pool), engine(other.engine) {
+    other.pool = nullptr;
+    other.engine = nullptr;
+}
+
+OCREnginePool::Lease& OCREnginePool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool = other.pool;
+        engine = other.engine;
+        other.pool = nullptr;
+        other.engine = nullptr;
+    }
+    return *this;
+}
+
+OCREnginePool::Lease::~Lease() {
+    release();
+}
+
+void OCREnginePool::Lease::release() {
+    if (pool && engine) {
+        pool->checkin(engine);
+    }
+    pool = nullptr;
+    engine = nullptr;
+}
+
+OCRProcessor* OCREnginePool::Lease::operator->() const {
+    return engine;
+}
+
+OCRProcessor& OCREnginePool::Lease::operator*() const {
+    return *engine;
+}
+
+OCREnginePool::Lease::operator bool() const {
+    return engine != nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Pool
+// ---------------------------------------------------------------------------
+
+OCREnginePool::OCREnginePool(size_t poolSize, const OCREngineConfig& config)
+    : config(config), warmupMs(0.0), checkoutCount(0), contendedCount(0),
+      totalWaitMs(0.0), maxWaitMs(0.0) {
+
+    poolSize = std::max<size_t>(poolSize, 1);
+    auto warmupStart = std::chrono::steady_clock::now();
+
+    // Init is hundreds of milliseconds per engine; warm them in parallel
+    std::vector<std::unique_ptr<OCRProcessor>> candidates(poolSize);
+    std::vector<std::thread> warmers;
+    warmers.reserve(poolSize);
+
+    for (size_t i = 0; i < poolSize; i++) {
+        warmers.emplace_back([this, &candidates, i]() {
+            const char* dataPath = this->config.dataPath.empty() ? nullptr : this->config.dataPath.c_str();
+            auto engine = std::make_unique<OCRProcessor>(this->config.language.c_str(), dataPath);
+
+            if (engine->isInitialized()) {
+                engine->setPageSegmentationMode(this->config.pageSegMode);
+                engine->setCharWhitelist(this->config.charWhitelist);
+                candidates[i] = std::move(engine);
+            }
+        });
+    }
+
+    for (auto& warmer : warmers) {
+        warmer.join();
+    }
+
+    for (auto& engine : candidates) {
+        if (engine) {
+            idleEngines.push_back(engine.get());
+            engines.push_back(std::move(engine));
+        }
+    }
+
+    readyTime = std::chrono::steady_clock::now();
+    warmupMs = std::chrono::duration<double, std::milli>(readyTime - warmupStart).count();
+
+    if (engines.size() < poolSize) {
+        std::cerr << "Uyarı: " << (poolSize - engines.size()) << "/" << poolSize
+                  << " OCR motoru başlatılamadı" << std::endl;
+    }
+
+    // Format locally so the caller's cout precision is left alone
+    std::ostringstream ready;
+    ready << "OCR havuzu hazır: " << engines.size() << " motor, "
+          << std::fixed << std::setprecision(0) << warmupMs << " ms";
+    std::cout << ready.str() << std::endl;
+}
+
+OCREnginePool::Lease OCREnginePool::acquireLocked(
+    std::unique_lock<std::mutex>& lock,
+    std::chrono::steady_clock::time_point requestTime) {
+
+    (void)lock; // caller holds poolMutex
+
+    OCRProcessor* engine = idleEngines.back();
+    idleEngines.pop_back();
+
+    auto now = std::chrono::steady_clock::now();
+    double waitMs = std::chrono::duration<double, std::milli>(now - requestTime).count();
+
+    checkoutCount++;
+    totalWaitMs += waitMs;
+    maxWaitMs = std::max(maxWaitMs, waitMs);
+
+    return Lease(this, engine);
+}
+
+OCREnginePool::Lease OCREnginePool::checkout() {
+    if (engines.empty()) {
+        return Lease();
+    }
+
+    auto requestTime = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(poolMutex);
+
+    if (idleEngines.empty()) {
+        contendedCount++;
+        engineAvailable.wait(lock, [this]() { return !idleEngines.empty(); });
+    }
+
+    return acquireLocked(lock, requestTime);
+}
+
+OCREnginePool::Lease OCREnginePool::tryCheckout(std::chrono::milliseconds timeout) {
+    if (engines.empty()) {
+        return Lease();
+    }
+
+    auto requestTime = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(poolMutex);
+
+    if (idleEngines.empty()) {
+        contendedCount++;
+        if (!engineAvailable.wait_for(lock, timeout, [this]() { return !idleEngines.empty(); })) {
+            return Lease();
+        }
+    }
+
+    return acquireLocked(lock, requestTime);
+}
+
+void OCREnginePool::checkin(OCRProcessor* engine) {
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        idleEngines.push_back(engine);
+    }
+    engineAvailable.notify_one();
+}
+
+size_t OCREnginePool::size() const {
+    return engines.size();
+}
+
+size_t OCREnginePool::available() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    return idleEngines.size();
+}
+
+bool OCREnginePool::isInitialized() const {
+    return !engines.empty();
+}
+
+const OCREngineConfig& OCREnginePool::getConfig() const {
+    return config;
+}
+
+OCRPoolStats OCREnginePool::getStats() const {
+    std::lock_guard<std::mutex> lock(poolMutex);
+
+    OCRPoolStats stats;
+    stats.poolSize = engines.size();
+    stats.inUse = engines.size() - idleEngines.size();
+    stats.checkouts = checkoutCount;
+    stats.contendedCheckouts = contendedCount;
+    stats.totalWaitMs = totalWaitMs;
+    stats.maxWaitMs = maxWaitMs;
+    stats.averageWaitMs = checkoutCount > 0 ? totalWaitMs / checkoutCount : 0.0;
+    stats.warmupMs = warmupMs;
+
+    // Busy time is what the engines spent recognizing, not how long a lease was held:
+    // batch and live workers keep theirs for their whole lifetime
+    double busyMs = 0.0;
+    for (const auto& engine : engines) {
+        busyMs += engine->getBusyMs();
+        stats.recognitions += engine->getRecognizeCount();
+    }
+    double uptimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - readyTime).count();
+    if (uptimeMs > 0.0 && !engines.empty()) {
+        stats.utilization = std::min(1.0, busyMs / (uptimeMs * engines.size()));
+    }
+
+    return stats;
+}
+
+void OCREnginePool::printStats() const {
+    OCRPoolStats stats = getStats();
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    out << "\nOCR Havuzu İstatistikleri:\n";
+    out << std::string(50, '-') << "\n";
+    out << "Motor sayısı:        " << stats.poolSize << "\n";
+    out << "Isınma süresi:       " << stats.warmupMs << " ms\n";
+    out << "Ödünç verme:         " << stats.checkouts
+        << " (bekleyen: " << stats.contendedCheckouts << ")\n";
+    out << "Tanıma:              " << stats.recognitions << "\n";
+    out << "Ortalama bekleme:    " << stats.averageWaitMs << " ms\n";
+    out << "Maksimum bekleme:    " << stats.maxWaitMs << " ms\n";
+    out << "Kullanım oranı:      %" << (stats.utilization * 100.0) << "\n";
+    out << std::string(50, '-');
+    std::cout << out.str() << std::endl;
+}
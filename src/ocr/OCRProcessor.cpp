@@ -1,10 +1,38 @@
 #include "OCRProcessor.h"
+#include "DebugArtifactSink.h"
+#include "Tracer.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <atomic>
+#include <chrono>
+
+namespace {
+
+// Adds the enclosing scope's duration to a counter on exit
+class BusyTimer {
+public:
+    explicit BusyTimer(std::atomic<uint64_t>& micros)
+        : micros(micros), start(std::chrono::steady_clock::now()) {}
+    ~BusyTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        micros.fetch_add(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()), std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t>& micros;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace
+
+const char* const OCRProcessor::DEFAULT_CHAR_WHITELIST =
+    "ABCÇDEFGĞHIİJKLMNOÖPRSŞTUÜVYZabcçdefgğhıijklmnoöprsştuüvyz0123456789 .,;:!?-";
 
 OCRProcessor::OCRProcessor(const char* language, const char* dataPath)
-    : tesseractAPI(nullptr), initialized(false), lastConfidence(0.0f) {
+    : tesseractAPI(nullptr), initialized(false), lastConfidence(0.0f),
+      transferMode(IN_MEMORY), busyMicros(0), recognizeCount(0) {
     
     try {
         // Create Tesseract API instance
@@ -22,8 +50,7 @@ OCRProcessor::OCRProcessor(const char* language, const char* dataPath)
         tesseractAPI->SetPageSegMode(tesseract::PSM_SINGLE_LINE);
         
         // Configure for better handwriting recognition
-        tesseractAPI->SetVariable("tessedit_char_whitelist", 
-            "ABCÇDEFGĞHIİJKLMNOÖPRSŞTUÜVYZabcçdefgğhıijklmnoöprsştuüvyz0123456789 .,;:!?-");
+        tesseractAPI->SetVariable("tessedit_char_whitelist", DEFAULT_CHAR_WHITELIST);
         
         initialized = true;
         std::cout << "OCR başarıyla başlatıldı (Dil: " << language << ")" << std::endl;
@@ -45,10 +72,10 @@ OCRProcessor::~OCRProcessor() {
     }
 }
 
-// OpenCV Mat'ı Leptonica Pix'e dönüştür
+// OpenCV Mat'ı Leptonica Pix'e dönüştür (eski yol: geçici JPEG dosyası)
 Pix* OCRProcessor::matToPix(const cv::Mat& mat) {
-    // En güvenilir yöntem: Dosyaya kaydet, Leptonica ile oku
-    static int tempCounter = 0;
+    // Atomic: batch workers convert concurrently and must not share a temp file
+    static std::atomic<int> tempCounter{0};
     std::string tempFile = "temp_pix_" + std::to_string(tempCounter++) + ".jpg";
     
     cv::imwrite(tempFile, mat);
@@ -60,6 +87,68 @@ Pix* OCRProcessor::matToPix(const cv::Mat& mat) {
     return pix;
 }
 
+// Görüntüyü Tesseract'a ver. Bellek içi yolda Mat buffer'ı (stride dahil) doğrudan
+// SetImage'a gider; dosya, JPEG encode/decode ve kayıplı sıkıştırma yoktur.
+bool OCRProcessor::setTesseractImage(const cv::Mat& image, Pix** ownedPix) {
+    *ownedPix = nullptr;
+    
+    if (transferMode == TEMP_FILE) {
+        *ownedPix = matToPix(image);
+        if (!*ownedPix) {
+            return false;
+        }
+        tesseractAPI->SetImage(*ownedPix);
+        return true;
+    }
+    
+    cv::Mat source = image;
+    if (source.depth() != CV_8U) {
+        source.convertTo(source, CV_8U);
+    }
+    
+    // Tesseract expects RGB(A) byte order; grayscale is handed over untouched
+    cv::Mat converted;
+    switch (source.channels()) {
+        case 1:
+            converted = source;
+            break;
+        case 3:
+            cv::cvtColor(source, converted, cv::COLOR_BGR2RGB);
+            break;
+        case 4:
+            cv::cvtColor(source, converted, cv::COLOR_BGRA2RGBA);
+            break;
+        default:
+            std::cerr << "Desteklenmeyen kanal sayısı: " << source.channels() << std::endl;
+            return false;
+    }
+    
+    // SetImage copies the pixels into Tesseract's own buffer, so 'converted'
+    // may be released as soon as this returns. ROI views keep their parent stride.
+    tesseractAPI->SetImage(
+        converted.data,
+        converted.cols,
+        converted.rows,
+        converted.channels(),
+        static_cast<int>(converted.step)
+    );
+    
+    return true;
+}
+
+bool OCRProcessor::transferImage(const cv::Mat& image) {
+    if (!initialized || image.empty()) {
+        return false;
+    }
+    
+    Pix* pix = nullptr;
+    bool transferred = setTesseractImage(image, &pix);
+    if (pix) {
+        pixDestroy(&pix);
+    }
+    return transferred;
+}
+
 cv::Mat OCRProcessor::preprocessForOCR(const cv::Mat& image) {
     cv::Mat processed;
     
@@ -155,6 +244,10 @@ std::string OCRProcessor::postProcessText(const std::string& rawText) {
 }
 
 std::string OCRProcessor::recognizeText(const cv::Mat& handwritingROI) {
+    OMR_TRACE_SCOPE("OCRProcessor::recognizeText");
+    BusyTimer busy(busyMicros);
+    recognizeCount.fetch_add(1, std::memory_order_relaxed);
+    
     if (!initialized || !tesseractAPI) {
         std::cerr << "OCR başlatılmamış!" << std::endl;
         return "";
@@ -171,32 +264,32 @@ std::string OCRProcessor::recognizeText(const cv::Mat& handwritingROI) {
     try {
         // YENİ: Minimal preprocessing - orijinal görüntüyü kullan
         // Ağır preprocessing el yazısını bozuyor!
-        cv::Mat preprocessed = handwritingROI.clone();
+        // No clone: the image is only read, and the in-memory transfer honours ROI strides
+        cv::Mat preprocessed = handwritingROI;
         
         std::cout << "[DEBUG OCR] Ön işleme sonrası: " << preprocessed.cols << "x" 
                   << preprocessed.rows << std::endl;
         
-        // Save preprocessed image for debugging
-        static int debugCounter = 0;
-        std::string debugFilename = "debug_ocr_preprocessed_" + std::to_string(debugCounter++) + ".jpg";
-        cv::imwrite(debugFilename, preprocessed);
-        std::cout << "[DEBUG OCR] Ön işlenmiş görüntü kaydedildi: " << debugFilename << std::endl;
-        
-        // Convert to Pix format
-        Pix* pix = matToPix(preprocessed);
+        // Save preprocessed image for debugging (asynchronous, off unless VERBOSE)
+        if (DebugArtifactSink::isEnabled(DebugArtifactSink::VERBOSE)) {
+            static std::atomic<int> debugCounter{0};
+            std::string debugFilename = "debug_ocr_preprocessed_" + std::to_string(debugCounter++) + ".jpg";
+            DebugArtifactSink::instance().submit(DebugArtifactSink::VERBOSE, debugFilename, preprocessed);
+        }
         
-        if (!pix) {
-            std::cerr << "Pix dönüşümü başarısız!" << std::endl;
+        // Hand the image to Tesseract
+        Pix* pix = nullptr;
+        if (!setTesseractImage(preprocessed, &pix)) {
+            std::cerr << "Görüntü Tesseract'a aktarılamadı!" << std::endl;
             return "";
         }
         
-        std::cout << "[DEBUG OCR] Pix dönüşümü başarılı" << std::endl;
-        
-        // Set image for OCR
-        tesseractAPI->SetImage(pix);
-        
         // Perform OCR
-        char* rawText = tesseractAPI->GetUTF8Text();
+        char* rawText = nullptr;
+        {
+            OMR_TRACE_SCOPE("tesseract::GetUTF8Text");
+            rawText = tesseractAPI->GetUTF8Text();
+        }
         
         // Get confidence
         lastConfidence = tesseractAPI->MeanTextConf();
@@ -209,7 +302,9 @@ std::string OCRProcessor::recognizeText(const cv::Mat& handwritingROI) {
         
         // Clean up
         delete[] rawText;
-        pixDestroy(&pix);
+        if (pix) {
+            pixDestroy(&pix);
+        }
         
         // Post-process text
         text = postProcessText(text);
@@ -229,6 +324,14 @@ std::string OCRProcessor::recognizeText(const cv::Mat& handwritingROI) {
     }
 }
 
+double OCRProcessor::getBusyMs() const {
+    return busyMicros.load(std::memory_order_relaxed) / 1000.0;
+}
+
+uint64_t OCRProcessor::getRecognizeCount() const {
+    return recognizeCount.load(std::memory_order_relaxed);
+}
+
 std::string OCRProcessor::recognizeTextWithConfidence(
     const cv::Mat& handwritingROI,
     float minConfidence) {
@@ -250,10 +353,25 @@ void OCRProcessor::setPageSegmentationMode(tesseract::PageSegMode mode) {
     }
 }
 
+void OCRProcessor::setCharWhitelist(const std::string& whitelist) {
+    if (initialized && tesseractAPI) {
+        // Empty string lifts the restriction
+        tesseractAPI->SetVariable("tessedit_char_whitelist", whitelist.c_str());
+    }
+}
+
 float OCRProcessor::getConfidence() const {
     return lastConfidence;
 }
 
+void OCRProcessor::setImageTransferMode(ImageTransferMode mode) {
+    transferMode = mode;
+}
+
+OCRProcessor::ImageTransferMode OCRProcessor::getImageTransferMode() const {
+    return transferMode;
+}
+
 bool OCRProcessor::isInitialized() const {
     return initialized && tesseractAPI != nullptr;
 }
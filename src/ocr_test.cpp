@@ -3,33 +3,11 @@
  * Kullanım: ./ocr_test <image.jpg>
  */
 
+#include "OCREnginePool.h"
 #include <opencv2/opencv.hpp>
-#include <tesseract/baseapi.h>
-#include <allheaders.h>
 #include <iostream>
 #include <string>
 
-// OpenCV Mat'ı Leptonica Pix'e dönüştür
-Pix* matToPix(const cv::Mat& mat) {
-    cv::Mat tempMat;
-    
-    // RGB formatına çevir (Leptonica RGB kullanır)
-    if (mat.channels() == 1) {
-        // Grayscale
-        return pixRead("preprocessed_output.jpg");  // Dosyadan oku (geçici çözüm)
-    } else if (mat.channels() == 3) {
-        cv::cvtColor(mat, tempMat, cv::COLOR_BGR2RGB);
-    } else {
-        tempMat = mat.clone();
-    }
-    
-    // Dosyaya kaydet ve oku (en güvenli yöntem)
-    cv::imwrite("temp_for_pix.jpg", mat);
-    Pix* pix = pixRead("temp_for_pix.jpg");
-    
-    return pix;
-}
-
 // OCR için ön işleme
 cv::Mat preprocessForOCR(const cv::Mat& image) {
     cv::Mat processed;
@@ -94,10 +72,15 @@ int main(int argc, char* argv[]) {
     
     // Tesseract başlat
     std::cout << "Tesseract başlatılıyor..." << std::endl;
-    tesseract::TessBaseAPI* api = new tesseract::TessBaseAPI();
+    OCREngineConfig ocrConfig;
+    ocrConfig.pageSegMode = tesseract::PSM_AUTO;
+    ocrConfig.charWhitelist.clear();
+    
+    OCREnginePool ocrPool(1, ocrConfig);
+    OCREnginePool::Lease ocr = ocrPool.checkout();
     
     // Türkçe dil desteği ile başlat
-    if (api->Init(NULL, "tur", tesseract::OEM_LSTM_ONLY)) {
+    if (!ocr) {
         std::cerr << "Tesseract başlatılamadı!" << std::endl;
         std::cerr << "Türkçe dil paketi kurulu olduğundan emin olun:" << std::endl;
         std::cerr << "brew install tesseract-lang" << std::endl;
@@ -106,31 +89,17 @@ int main(int argc, char* argv[]) {
     
     std::cout << "Tesseract başlatıldı (Türkçe)" << std::endl;
     
-    // PSM ayarla - tek satır için
-    api->SetPageSegMode(tesseract::PSM_AUTO);
-    
-    // Pix'e dönüştür
-    std::cout << "Görüntü dönüştürülüyor..." << std::endl;
-    Pix* pix = matToPix(preprocessed);
-    
-    if (!pix) {
-        std::cerr << "Pix dönüşümü başarısız!" << std::endl;
-        return 1;
-    }
-    
-    // OCR uygula
+    // OCR uygula - görüntü bellekten aktarılır
     std::cout << "OCR uygulanıyor..." << std::endl;
-    api->SetImage(pix);
-    
-    char* rawText = api->GetUTF8Text();
-    int confidence = api->MeanTextConf();
+    std::string text = ocr->recognizeText(preprocessed);
+    int confidence = static_cast<int>(ocr->getConfidence());
     
     // Sonuçları göster
     std::cout << "\n========================================" << std::endl;
     std::cout << "OCR SONUÇLARI:" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Güven: " << confidence << "%" << std::endl;
-    std::cout << "Metin: \"" << (rawText ? rawText : "") << "\"" << std::endl;
+    std::cout << "Metin: \"" << text << "\"" << std::endl;
     std::cout << "========================================\n" << std::endl;
     
     // Görüntüyü göster
@@ -142,11 +111,5 @@ int main(int argc, char* argv[]) {
     std::cout << "Pencereyi kapatmak için bir tuşa basın..." << std::endl;
     cv::waitKey(0);
     
-    // Temizlik
-    delete[] rawText;
-    pixDestroy(&pix);
-    api->End();
-    delete api;
-    
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "DebugArtifactSink.h"
+#include "Tracer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+std::atomic<int> DebugArtifactSink::activeLevel{DebugArtifactSink::OFF};
+
+DebugArtifactSink::DebugArtifactSink()
+    : outputDir("."), maxQueueSize(64), writing(false), stopping(false),
+      writtenCount(0), droppedCount(0) {
+}
+
+DebugArtifactSink::~DebugArtifactSink() {
+    shutdown();
+}
+
+DebugArtifactSink& DebugArtifactSink::instance() {
+    static DebugArtifactSink sink;
+    return sink;
+}
+
+bool DebugArtifactSink::parseLevel(const std::string& text, Level& level) {
+    std::string value = text;
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+
+    if (value == "off" || value == "0") {
+        level = OFF;
+    } else if (value == "basic" || value == "1") {
+        level = BASIC;
+    } else if (value == "verbose" || value == "2") {
+        level = VERBOSE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void DebugArtifactSink::configureFromEnvironment(Level defaultLevel) {
+    Level level = defaultLevel;
+
+    const char* envLevel = std::getenv("OMR_DEBUG_ARTIFACTS");
+    if (envLevel && !parseLevel(envLevel, level)) {
+        std::cerr << "Uyarı: Geçersiz OMR_DEBUG_ARTIFACTS değeri: " << envLevel << std::endl;
+        level = defaultLevel;
+    }
+
+    const char* envDir = std::getenv("OMR_DEBUG_DIR");
+    configure(level, envDir ? envDir : ".");
+}
+
+void DebugArtifactSink::configure(Level level, const std::string& outputDir, size_t maxQueueSize) {
+    if (level == OFF) {
+        // Pending artifacts are still written; new ones are rejected at the call site
+        activeLevel.store(OFF, std::memory_order_relaxed);
+        flush();
+        return;
+    }
+
+    std::error_code ec;
+    if (!outputDir.empty() && outputDir != ".") {
+        fs::create_directories(outputDir, ec);
+        if (ec) {
+            std::cerr << "Debug klasörü oluşturulamadı: " << outputDir << std::endl;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        this->outputDir = outputDir.empty() ? "." : outputDir;
+        this->maxQueueSize = std::max<size_t>(maxQueueSize, 1);
+        stopping = false;
+    }
+
+    if (!writerThread.joinable()) {
+        writerThread = std::thread(&DebugArtifactSink::writerLoop, this);
+    }
+
+    activeLevel.store(level, std::memory_order_relaxed);
+}
+
+void DebugArtifactSink::submit(Level level, const std::string& filename, const cv::Mat& image) {
+    if (!isEnabled(level) || image.empty()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (stopping || pendingArtifacts.size() >= maxQueueSize) {
+        droppedCount++;
+        return;
+    }
+
+    Artifact artifact;
+    artifact.path = (fs::path(outputDir) / filename).string();
+    // Own the pixels: callers pass views into buffers they keep reusing
+    artifact.image = image.clone();
+    pendingArtifacts.push_back(std::move(artifact));
+    lock.unlock();
+
+    queueCondition.notify_one();
+}
+
+void DebugArtifactSink::flush() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    if (!writerThread.joinable()) {
+        return;
+    }
+    drainedCondition.wait(lock, [this]() {
+        return pendingArtifacts.empty() && !writing;
+    });
+}
+
+void DebugArtifactSink::shutdown() {
+    activeLevel.store(OFF, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+
+    // Only the call that stops the writer reports; the destructor shuts down again
+    if (!writerThread.joinable()) {
+        return;
+    }
+    writerThread.join();
+
+    if (droppedCount > 0) {
+        std::cerr << "Uyarı: Kuyruk dolu olduğu için " << droppedCount
+                  << " debug görüntüsü yazılmadı" << std::endl;
+    }
+}
+
+DebugArtifactSink::Level DebugArtifactSink::getLevel() const {
+    return static_cast<Level>(activeLevel.load(std::memory_order_relaxed));
+}
+
+uint64_t DebugArtifactSink::getWrittenCount() const {
+    return writtenCount;
+}
+
+uint64_t DebugArtifactSink::getDroppedCount() const {
+    return droppedCount;
+}
+
+void DebugArtifactSink::writerLoop() {
+    OMR_TRACE_THREAD_NAME("debug-writer");
+    
+    while (true) {
+        Artifact artifact;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() {
+                return stopping || !pendingArtifacts.empty();
+            });
+
+            if (pendingArtifacts.empty()) {
+                return; // stopping and fully drained
+            }
+
+            artifact = std::move(pendingArtifacts.front());
+            pendingArtifacts.pop_front();
+            writing = true;
+        }
+
+        try {
+            OMR_TRACE_SCOPE("DebugArtifactSink::imwrite");
+            if (cv::imwrite(artifact.path, artifact.image)) {
+                writtenCount++;
+            } else {
+                std::cerr << "Debug görüntüsü yazılamadı: " << artifact.path << std::endl;
+            }
+        } catch (const cv::Exception& e) {
+            std::cerr << "Debug görüntüsü yazma hatası: " << e.what() << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            writing = false;
+        }
+        drainedCondition.notify_all();
+    }
+}
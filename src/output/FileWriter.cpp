@@ -1,4 +1,5 @@
 #include "FileWriter.h"
+#include "Tracer.h"
 #include <fstream>
 #include <iostream>
 #include <iomanip>
@@ -6,6 +7,26 @@
 #include <chrono>
 #include <ctime>
 
+namespace {
+
+// Quoted CSV field: embedded quotes doubled, line breaks dropped so a row stays on one line
+std::string csvQuoted(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '\r' || c == '\n') {
+            continue;
+        }
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+} // namespace
+
 FileWriter::FileWriter() {
 }
 
@@ -31,6 +52,8 @@ bool FileWriter::saveResultsToText(
     const std::string& studentName,
     const std::string& examName) const {
     
+    OMR_TRACE_SCOPE("FileWriter::saveResultsToText");
+    
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Dosya oluşturulamadı: " << filename << std::endl;
@@ -100,6 +123,7 @@ bool FileWriter::saveResultsToCSV(
     const ExamScore& score,
     const std::string& studentName) const {
     
+    OMR_TRACE_SCOPE("FileWriter::saveResultsToCSV");
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "CSV dosyası oluşturulamadı: " << filename << std::endl;
@@ -118,14 +142,14 @@ bool FileWriter::saveResultsToCSV(
         
         // Student answer
         if (result.studentAnswer.type == Answer::FILL_IN_BLANK) {
-            file << "\"" << result.studentAnswer.textAnswer << "\",";
+            file << csvQuoted(result.studentAnswer.textAnswer) << ",";
         } else {
             file << result.studentAnswer.selectedOption << ",";
         }
         
         // Correct answer
         if (result.correctAnswer.type == Answer::FILL_IN_BLANK) {
-            file << "\"" << result.correctAnswer.textAnswer << "\"";
+            file << csvQuoted(result.correctAnswer.textAnswer);
         } else {
             file << result.correctAnswer.selectedOption;
         }
@@ -138,6 +162,45 @@ bool FileWriter::saveResultsToCSV(
     return true;
 }
 
+bool FileWriter::saveBatchResultsToCSV(
+    const std::string& filename,
+    const std::vector<SheetResult>& results) const {
+
+    OMR_TRACE_SCOPE("FileWriter::saveBatchResultsToCSV");
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "CSV dosyası oluşturulamadı: " << filename << std::endl;
+        return false;
+    }
+
+    // Header
+    file << "Dosya,Durum,Doğru,Yanlış,Boş,Ham Puan,Yüzde,Süre (ms),Hata\n";
+
+    // One row per sheet
+    for (const auto& result : results) {
+        file << csvQuoted(result.sheetId) << ",";
+        file << (result.success ? "OK" : "HATA") << ",";
+
+        if (result.success) {
+            file << result.score.correctAnswers << ",";
+            file << result.score.incorrectAnswers << ",";
+            file << result.score.unanswered << ",";
+            file << std::fixed << std::setprecision(2) << result.score.rawScore << ",";
+            file << std::fixed << std::setprecision(2) << result.score.percentageScore << ",";
+        } else {
+            file << ",,,,,";
+        }
+
+        file << std::fixed << std::setprecision(1) << result.processingMs << ",";
+        file << csvQuoted(result.errorMessage);
+        file << "\n";
+    }
+
+    file.close();
+    std::cout << "Toplu CSV kaydedildi: " << filename << std::endl;
+    return true;
+}
+
 bool FileWriter::saveResultImage(
     const std::string& filename,
     const cv::Mat& image) const {
@@ -148,6 +211,7 @@ bool FileWriter::saveResultImage(
     }
     
     try {
+        OMR_TRACE_SCOPE("FileWriter::saveResultImage");
         cv::imwrite(filename, image);
         std::cout << "Sonuç görüntüsü kaydedildi: " << filename << std::endl;
         return true;
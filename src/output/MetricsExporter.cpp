@@ -0,0 +1,177 @@
+#include "MetricsExporter.h"
+#include <chrono>
+#include <iostream>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+MetricsExporter::MetricsExporter(MetricsRegistry& registry)
+    : registry(registry), listenSocket(-1), dumpIntervalSeconds(0.0), stopping(false) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+#ifdef _WIN32
+
+bool MetricsExporter::startHttp(int port) {
+    std::cerr << "Metrik uç noktası bu platformda desteklenmiyor (port " << port
+              << "); --metrics-file kullanın" << std::endl;
+    return false;
+}
+
+void MetricsExporter::httpLoop() {
+}
+
+void MetricsExporter::serveClient(int clientSocket) {
+    (void)clientSocket;
+}
+
+#else
+
+bool MetricsExporter::startHttp(int port) {
+    if (httpThread.joinable()) {
+        return true;
+    }
+
+    listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenSocket < 0) {
+        std::cerr << "Metrik soketi açılamadı" << std::endl;
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+
+    if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(listenSocket, 8) < 0) {
+        std::cerr << "Metrik uç noktası başlatılamadı: 127.0.0.1:" << port << std::endl;
+        close(listenSocket);
+        listenSocket = -1;
+        return false;
+    }
+
+    httpThread = std::thread(&MetricsExporter::httpLoop, this);
+    std::cout << "Metrikler: http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsExporter::httpLoop() {
+    // Poll with a short timeout so stop() is noticed without closing the socket under accept()
+    while (!stopping.load()) {
+        pollfd descriptor{};
+        descriptor.fd = listenSocket;
+        descriptor.events = POLLIN;
+        if (poll(&descriptor, 1, 200) <= 0) {
+            continue;
+        }
+
+        int clientSocket = accept(listenSocket, nullptr, nullptr);
+        if (clientSocket >= 0) {
+            serveClient(clientSocket);
+            close(clientSocket);
+        }
+    }
+}
+
+void MetricsExporter::serveClient(int clientSocket) {
+    timeval timeout{};
+    timeout.tv_sec = 1;
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    char buffer[2048];
+    ssize_t received = recv(clientSocket, buffer, sizeof(buffer) - 1, 0);
+    if (received <= 0) {
+        return;
+    }
+    std::string request(buffer, static_cast<size_t>(received));
+
+    std::string status = "200 OK";
+    std::string body;
+    if (request.compare(0, 13, "GET /metrics ") == 0 || request.compare(0, 6, "GET / ") == 0) {
+        body = registry.renderPrometheus();
+    } else {
+        status = "404 Not Found";
+        body = "not found\n";
+    }
+
+    std::string response = "HTTP/1.1 " + status + "\r\n"
+                           "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                           "Connection: close\r\n\r\n" + body;
+
+    size_t sent = 0;
+    while (sent < response.size()) {
+        ssize_t written = send(clientSocket, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+        if (written <= 0) {
+            break;
+        }
+        sent += static_cast<size_t>(written);
+    }
+}
+
+#endif
+
+bool MetricsExporter::startFileDump(const std::string& filename, double intervalSeconds) {
+    if (fileThread.joinable()) {
+        return true;
+    }
+    if (intervalSeconds <= 0.0) {
+        std::cerr << "Geçersiz metrik döküm aralığı: " << intervalSeconds << std::endl;
+        return false;
+    }
+
+    dumpFilename = filename;
+    dumpIntervalSeconds = intervalSeconds;
+    if (!registry.writeToFile(dumpFilename)) {
+        return false;
+    }
+
+    fileThread = std::thread(&MetricsExporter::fileLoop, this);
+    std::cout << "Metrikler her " << intervalSeconds << " sn'de " << filename << " dosyasına yazılacak" << std::endl;
+    return true;
+}
+
+void MetricsExporter::fileLoop() {
+    auto interval = std::chrono::duration<double>(dumpIntervalSeconds);
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopping.load()) {
+        stopCondition.wait_for(lock, interval, [this] { return stopping.load(); });
+        lock.unlock();
+        registry.writeToFile(dumpFilename);
+        lock.lock();
+    }
+}
+
+void MetricsExporter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+
+    if (httpThread.joinable()) {
+        httpThread.join();
+    }
+#ifndef _WIN32
+    if (listenSocket >= 0) {
+        close(listenSocket);
+        listenSocket = -1;
+    }
+#endif
+    // fileLoop writes a final dump on its way out
+    if (fileThread.joinable()) {
+        fileThread.join();
+    }
+}
@@ -0,0 +1,235 @@
+#include "MetricsRegistry.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string formatNumber(double value) {
+    std::ostringstream out;
+    out.precision(12);
+    out << value;
+    return out.str();
+}
+
+// name{labels} or name{labels,extra}
+std::string seriesName(const std::string& name, const std::string& labels, const std::string& extra = "") {
+    if (labels.empty() && extra.empty()) {
+        return name;
+    }
+    std::string series = name + "{" + labels;
+    if (!labels.empty() && !extra.empty()) {
+        series += ",";
+    }
+    return series + extra + "}";
+}
+
+} // namespace
+
+void Gauge::add(double delta) {
+    double current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+    }
+}
+
+Histogram::Histogram(const std::vector<double>& upperBounds)
+    : upperBounds(upperBounds), buckets(new std::atomic<uint64_t>[upperBounds.size() + 1]) {
+    std::sort(this->upperBounds.begin(), this->upperBounds.end());
+    for (size_t i = 0; i <= this->upperBounds.size(); i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Histogram::observe(double value) {
+    // Prometheus buckets are "le": a value equal to a bound belongs to that bound
+    size_t index = std::lower_bound(upperBounds.begin(), upperBounds.end(), value) - upperBounds.begin();
+    buckets[index].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.add(value);
+}
+
+const std::vector<double>& Histogram::getUpperBounds() const {
+    return upperBounds;
+}
+
+uint64_t Histogram::getBucketCount(size_t index) const {
+    return index <= upperBounds.size() ? buckets[index].load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t Histogram::getCount() const {
+    return count.load(std::memory_order_relaxed);
+}
+
+double Histogram::getSum() const {
+    return sum.get();
+}
+
+std::vector<double> Histogram::latencyBuckets() {
+    return {0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+}
+
+std::vector<double> Histogram::linearBuckets(double start, double width, int count) {
+    std::vector<double> bounds;
+    for (int i = 0; i < count; i++) {
+        bounds.push_back(start + width * i);
+    }
+    return bounds;
+}
+
+MetricsRegistry::MetricsRegistry() {
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Entry* MetricsRegistry::find(const std::string& name, const std::string& labels, Kind kind) {
+    for (auto& entry : entries) {
+        if (entry->name == name && entry->labels == labels) {
+            if (entry->kind != kind) {
+                throw std::runtime_error("Metrik farklı türle tekrar kaydedildi: " + name);
+            }
+            return entry.get();
+        }
+    }
+    return nullptr;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (Entry* entry = find(name, labels, COUNTER)) {
+        return *entry->counter;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->labels = labels;
+    entry->kind = COUNTER;
+    entry->counter = std::make_unique<Counter>();
+    entries.push_back(std::move(entry));
+    return *entries.back()->counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (Entry* entry = find(name, labels, GAUGE)) {
+        return *entry->gauge;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->labels = labels;
+    entry->kind = GAUGE;
+    entry->gauge = std::make_unique<Gauge>();
+    entries.push_back(std::move(entry));
+    return *entries.back()->gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const std::vector<double>& upperBounds, const std::string& labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (Entry* entry = find(name, labels, HISTOGRAM)) {
+        return *entry->histogram;
+    }
+
+    auto entry = std::make_unique<Entry>();
+    entry->name = name;
+    entry->help = help;
+    entry->labels = labels;
+    entry->kind = HISTOGRAM;
+    entry->histogram = std::make_unique<Histogram>(upperBounds);
+    entries.push_back(std::move(entry));
+    return *entries.back()->histogram;
+}
+
+Histogram& MetricsRegistry::stageLatency(const std::string& stage) {
+    return histogram("omr_stage_duration_seconds", "Pipeline stage duration in seconds",
+                     Histogram::latencyBuckets(), "stage=\"" + stage + "\"");
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    std::ostringstream out;
+    std::set<std::string> written;
+
+    // One HELP/TYPE block per family, followed by all of its label sets
+    for (const auto& family : entries) {
+        if (!written.insert(family->name).second) {
+            continue;
+        }
+
+        const char* type = family->kind == COUNTER ? "counter" : (family->kind == GAUGE ? "gauge" : "histogram");
+        out << "# HELP " << family->name << " " << family->help << "\n";
+        out << "# TYPE " << family->name << " " << type << "\n";
+
+        for (const auto& entry : entries) {
+            if (entry->name != family->name) {
+                continue;
+            }
+
+            switch (entry->kind) {
+                case COUNTER:
+                    out << seriesName(entry->name, entry->labels) << " " << entry->counter->get() << "\n";
+                    break;
+                case GAUGE:
+                    out << seriesName(entry->name, entry->labels) << " "
+                        << formatNumber(entry->gauge->get()) << "\n";
+                    break;
+                case HISTOGRAM: {
+                    // Buckets are read one by one; a concurrent observe may skew a scrape by one sample
+                    const Histogram& histogram = *entry->histogram;
+                    const auto& bounds = histogram.getUpperBounds();
+                    uint64_t cumulative = 0;
+                    for (size_t i = 0; i < bounds.size(); i++) {
+                        cumulative += histogram.getBucketCount(i);
+                        out << seriesName(entry->name + "_bucket", entry->labels,
+                                          "le=\"" + formatNumber(bounds[i]) + "\"")
+                            << " " << cumulative << "\n";
+                    }
+                    cumulative += histogram.getBucketCount(bounds.size());
+                    out << seriesName(entry->name + "_bucket", entry->labels, "le=\"+Inf\"")
+                        << " " << cumulative << "\n";
+                    out << seriesName(entry->name + "_sum", entry->labels) << " "
+                        << formatNumber(histogram.getSum()) << "\n";
+                    out << seriesName(entry->name + "_count", entry->labels) << " " << cumulative << "\n";
+                    break;
+                }
+            }
+        }
+    }
+
+    return out.str();
+}
+
+bool MetricsRegistry::writeToFile(const std::string& filename) const {
+    // Write then rename so a reader (node_exporter textfile collector) never sees a partial file
+    std::string tempName = filename + ".tmp";
+    {
+        std::ofstream file(tempName);
+        if (!file.is_open()) {
+            std::cerr << "Metrik dosyası oluşturulamadı: " << tempName << std::endl;
+            return false;
+        }
+        file << renderPrometheus();
+        if (!file.good()) {
+            std::cerr << "Metrik dosyası yazılamadı: " << tempName << std::endl;
+            return false;
+        }
+    }
+
+    if (std::rename(tempName.c_str(), filename.c_str()) != 0) {
+        std::remove(filename.c_str());
+        if (std::rename(tempName.c_str(), filename.c_str()) != 0) {
+            std::cerr << "Metrik dosyası taşınamadı: " << filename << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
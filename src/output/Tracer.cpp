@@ -0,0 +1,161 @@
+#include "Tracer.h"
+
+#if OMR_ENABLE_TRACING
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << ' ';
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+Tracer::Tracer() {
+}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+int64_t Tracer::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    // Registered once per thread; afterwards recording takes no lock
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>(static_cast<int>(buffers.size()) + 1));
+        buffer = buffers.back().get();
+    }
+    return *buffer;
+}
+
+void Tracer::record(const char* name, const char* argName, int64_t arg, int64_t startNs, int64_t endNs) {
+    ThreadBuffer& buffer = localBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+
+    TraceEvent& event = buffer.events[index & (RING_CAPACITY - 1)];
+    event.name = name;
+    event.argName = argName;
+    event.arg = arg;
+    event.startNs = startNs;
+    event.durationNs = endNs - startNs;
+
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer.threadName = name;
+}
+
+bool Tracer::writeChromeTrace(const std::string& filename, size_t* eventCount, size_t* droppedCount) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        std::cerr << "İz dosyası oluşturulamadı: " << filename << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    // Timestamps are relative to the earliest retained span
+    int64_t originNs = INT64_MAX;
+    for (const auto& buffer : buffers) {
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = written > RING_CAPACITY ? written - RING_CAPACITY : 0;
+        for (uint64_t i = first; i < written; i++) {
+            originNs = std::min(originNs, buffer->events[i & (RING_CAPACITY - 1)].startNs);
+        }
+    }
+
+    size_t events = 0;
+    size_t dropped = 0;
+    bool firstEntry = true;
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    for (const auto& buffer : buffers) {
+        if (!buffer->threadName.empty()) {
+            out << (firstEntry ? "" : ",\n");
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer->threadName);
+            out << "}}";
+            firstEntry = false;
+        }
+
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        uint64_t first = written > RING_CAPACITY ? written - RING_CAPACITY : 0;
+        dropped += first;
+
+        for (uint64_t i = first; i < written; i++) {
+            const TraceEvent& event = buffer->events[i & (RING_CAPACITY - 1)];
+            out << (firstEntry ? "" : ",\n");
+            out << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"cat\":\"omr\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << (event.startNs - originNs) / 1000.0
+                << ",\"dur\":" << event.durationNs / 1000.0;
+            if (event.argName != nullptr) {
+                out << ",\"args\":{";
+                writeJsonString(out, event.argName);
+                out << ":" << event.arg << "}";
+            }
+            out << "}";
+            firstEntry = false;
+            events++;
+        }
+    }
+
+    out << "\n]}\n";
+
+    if (eventCount != nullptr) {
+        *eventCount = events;
+    }
+    if (droppedCount != nullptr) {
+        *droppedCount = dropped;
+    }
+    return out.good();
+}
+
+TraceSession::TraceSession() {
+    const char* file = std::getenv("OMR_TRACE_FILE");
+    path = (file != nullptr && file[0] != '\0') ? file : "omr_trace.json";
+}
+
+TraceSession::~TraceSession() {
+    size_t events = 0;
+    size_t dropped = 0;
+    if (Tracer::instance().writeChromeTrace(path, &events, &dropped)) {
+        std::cout << "İz kaydedildi: " << path << " (" << events << " aralık";
+        if (dropped > 0) {
+            std::cout << ", " << dropped << " eski aralık halka tamponda ezildi";
+        }
+        std::cout << ")" << std::endl;
+    }
+}
+
+#endif
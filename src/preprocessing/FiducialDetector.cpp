@@ -0,0 +1,249 @@
+#include "FiducialDetector.h"
+#include <algorithm>
+#include <cmath>
+
+FiducialDetector::FiducialDetector(const FiducialConfig& config)
+    : config(config) {
+}
+
+void FiducialDetector::setConfig(const FiducialConfig& config) {
+    this->config = config;
+}
+
+const FiducialConfig& FiducialDetector::getConfig() const {
+    return config;
+}
+
+bool FiducialDetector::detectMarkers(const cv::Mat& image, std::vector<cv::Point2f>& centers,
+                                     double expectedAspect) {
+    centers.clear();
+    if (image.empty()) {
+        return false;
+    }
+
+    const cv::Mat* gray = &image;
+    if (image.channels() == 3) {
+        cv::cvtColor(image, grayBuffer, cv::COLOR_BGR2GRAY);
+        gray = &grayBuffer;
+    } else if (image.channels() == 4) {
+        cv::cvtColor(image, grayBuffer, cv::COLOR_BGRA2GRAY);
+        gray = &grayBuffer;
+    }
+
+    // Coarse search on a small copy; INTER_AREA keeps thin marker rings intact
+    double scale = std::min(1.0, static_cast<double>(config.searchLongSide) /
+                                 std::max(gray->cols, gray->rows));
+    const cv::Mat* small = gray;
+    if (scale < 1.0) {
+        cv::resize(*gray, smallBuffer, cv::Size(), scale, scale, cv::INTER_AREA);
+        small = &smallBuffer;
+    }
+
+    int windowWidth = std::max(8, static_cast<int>(small->cols * config.cornerWindowFraction));
+    int windowHeight = std::max(8, static_cast<int>(small->rows * config.cornerWindowFraction));
+    int right = small->cols - windowWidth;
+    int bottom = small->rows - windowHeight;
+
+    // TL, TR, BR, BL with the image corner each window belongs to
+    const cv::Rect windows[4] = {
+        cv::Rect(0, 0, windowWidth, windowHeight),
+        cv::Rect(right, 0, windowWidth, windowHeight),
+        cv::Rect(right, bottom, windowWidth, windowHeight),
+        cv::Rect(0, bottom, windowWidth, windowHeight)
+    };
+    const cv::Point2f outerCorners[4] = {
+        cv::Point2f(0.0f, 0.0f),
+        cv::Point2f(static_cast<float>(small->cols), 0.0f),
+        cv::Point2f(static_cast<float>(small->cols), static_cast<float>(small->rows)),
+        cv::Point2f(0.0f, static_cast<float>(small->rows))
+    };
+
+    std::vector<double> markerSides;
+    for (int i = 0; i < 4; i++) {
+        cv::Rect markerBox;
+        if (!findMarkerInWindow(*small, windows[i], outerCorners[i], markerBox)) {
+            centers.clear();
+            return false;
+        }
+        markerSides.push_back(std::sqrt(static_cast<double>(markerBox.area())));
+
+        // Back to full resolution with a margin for the coarse localization error
+        double inverse = 1.0 / scale;
+        int margin = std::max(markerBox.width, markerBox.height) / 2 + 2;
+        cv::Rect searchBox(
+            static_cast<int>((markerBox.x - margin) * inverse),
+            static_cast<int>((markerBox.y - margin) * inverse),
+            static_cast<int>((markerBox.width + 2 * margin) * inverse),
+            static_cast<int>((markerBox.height + 2 * margin) * inverse)
+        );
+        searchBox &= cv::Rect(0, 0, gray->cols, gray->rows);
+
+        cv::Point2f center;
+        if (!refineMarker(*gray, searchBox, center)) {
+            centers.clear();
+            return false;
+        }
+        centers.push_back(center);
+    }
+
+    if (!isPlausibleQuad(centers, markerSides, gray->size(), expectedAspect)) {
+        centers.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool FiducialDetector::findMarkerInWindow(
+    const cv::Mat& small,
+    const cv::Rect& window,
+    const cv::Point2f& outerCorner,
+    cv::Rect& markerBox) {
+
+    // Markers are the darkest blobs near the corner: Otsu inside the window only
+    cv::threshold(small(window), windowBinary, 0, 255, cv::THRESH_BINARY_INV | cv::THRESH_OTSU);
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(windowBinary, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+
+    int windowSide = std::min(window.width, window.height);
+    double minSide = windowSide * config.minMarkerFraction;
+    double maxSide = windowSide * config.maxMarkerFraction;
+
+    bool found = false;
+    double bestDistance = 0.0;
+
+    for (const auto& contour : contours) {
+        cv::Rect box = cv::boundingRect(contour);
+
+        // A marker cut by the window border cannot be measured reliably
+        if (box.x == 0 || box.y == 0 ||
+            box.x + box.width == window.width || box.y + box.height == window.height) {
+            continue;
+        }
+        if (box.width < minSide || box.height < minSide || box.width > maxSide || box.height > maxSide) {
+            continue;
+        }
+
+        double aspect = static_cast<double>(std::min(box.width, box.height)) / std::max(box.width, box.height);
+        if (aspect < config.minAspectRatio) {
+            continue;
+        }
+
+        // Solid square ~1.0, filled disc or concentric target ~0.785; text and lines are far lower
+        double contourArea = cv::contourArea(contour);
+        double extent = contourArea / box.area();
+        if (extent < config.minExtent) {
+            continue;
+        }
+
+        // Empty answer bubbles have the same outline as a target but little ink inside
+        double inkRatio = static_cast<double>(cv::countNonZero(windowBinary(box))) / box.area();
+        if (inkRatio < config.minInkRatio) {
+            continue;
+        }
+
+        // Filled answer bubbles: round (a square stays ~1 against its rotated box at any angle)
+        // and solid (a target's inner ring leaves ~2/3 of its outline inked)
+        cv::Size2f rotated = cv::minAreaRect(contour).size;
+        double rectangularity = contourArea / std::max(1.0f, rotated.width * rotated.height);
+        double fill = inkRatio * box.area() / std::max(1.0, contourArea);
+        if (rectangularity < config.maxDiscRectangularity && fill > config.maxDiscFill) {
+            continue;
+        }
+
+        // Several candidates: the one closest to the sheet corner wins
+        cv::Point2f center(window.x + box.x + box.width * 0.5f, window.y + box.y + box.height * 0.5f);
+        double distance = cv::norm(center - outerCorner);
+        if (!found || distance < bestDistance) {
+            found = true;
+            bestDistance = distance;
+            markerBox = cv::Rect(window.x + box.x, window.y + box.y, box.width, box.height);
+        }
+    }
+
+    return found;
+}
+
+bool FiducialDetector::refineMarker(const cv::Mat& gray, const cv::Rect& searchBox, cv::Point2f& center) {
+    if (searchBox.width < 3 || searchBox.height < 3) {
+        return false;
+    }
+
+    cv::threshold(gray(searchBox), refineBinary, 0, 255, cv::THRESH_BINARY_INV | cv::THRESH_OTSU);
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::findContours(refineBinary, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_NONE);
+
+    // Table or paper edge may leak into the margin; the marker itself lies fully inside
+    double bestArea = 0.0;
+    int best = -1;
+    for (size_t i = 0; i < contours.size(); i++) {
+        cv::Rect box = cv::boundingRect(contours[i]);
+        if (box.x == 0 || box.y == 0 ||
+            box.x + box.width == searchBox.width || box.y + box.height == searchBox.height) {
+            continue;
+        }
+
+        double area = cv::contourArea(contours[i]);
+        if (area > bestArea) {
+            bestArea = area;
+            best = static_cast<int>(i);
+        }
+    }
+
+    if (best < 0) {
+        return false;
+    }
+
+    // Centroid of the outer contour: sub-pixel and the same for squares, discs and rings
+    cv::Moments moments = cv::moments(contours[best]);
+    if (moments.m00 <= 0.0) {
+        return false;
+    }
+
+    center = cv::Point2f(
+        static_cast<float>(searchBox.x + moments.m10 / moments.m00),
+        static_cast<float>(searchBox.y + moments.m01 / moments.m00)
+    );
+    return true;
+}
+
+bool FiducialDetector::isPlausibleQuad(
+    const std::vector<cv::Point2f>& centers,
+    const std::vector<double>& markerSides,
+    const cv::Size& imageSize,
+    double expectedAspect) const {
+
+    if (centers.size() != 4 || markerSides.size() != 4) {
+        return false;
+    }
+
+    // TL, TR, BR, BL must form a convex quad covering a real part of the frame
+    if (!cv::isContourConvex(centers)) {
+        return false;
+    }
+
+    double area = std::abs(cv::contourArea(centers));
+    if (area < config.minQuadAreaFraction * imageSize.area()) {
+        return false;
+    }
+
+    // All four are printed the same size; perspective alone cannot make one twice another
+    auto sides = std::minmax_element(markerSides.begin(), markerSides.end());
+    if (*sides.first <= 0.0 || *sides.second / *sides.first > config.maxMarkerSizeRatio) {
+        return false;
+    }
+
+    if (expectedAspect <= 0.0) {
+        return true;
+    }
+
+    // Mean opposite sides: perspective shortens one edge and lengthens the other
+    double width = (cv::norm(centers[1] - centers[0]) + cv::norm(centers[2] - centers[3])) * 0.5;
+    double height = (cv::norm(centers[3] - centers[0]) + cv::norm(centers[2] - centers[1])) * 0.5;
+    if (height <= 0.0) {
+        return false;
+    }
+    return std::abs(width / height / expectedAspect - 1.0) <= config.maxQuadAspectError;
+}
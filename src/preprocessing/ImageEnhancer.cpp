@@ -9,8 +9,9 @@ ImageEnhancer::ImageEnhancer() {
 }
 
 cv::Mat ImageEnhancer::convertToGray(const cv::Mat& image) {
+    // Callers never write into the result in place, so gray input is shared, not copied
     if (image.channels() == 1) {
-        return image.clone();
+        return image;
     }
     
     cv::Mat gray;
@@ -19,10 +20,8 @@ cv::Mat ImageEnhancer::convertToGray(const cv::Mat& image) {
 }
 
 cv::Mat ImageEnhancer::enhanceImage(const cv::Mat& image) {
-    cv::Mat enhanced = image.clone();
-    
     // Convert to grayscale if needed
-    enhanced = convertToGray(enhanced);
+    cv::Mat enhanced = convertToGray(image);
     
     // Enhance contrast
     enhanced = enhanceContrast(enhanced);
@@ -93,13 +92,20 @@ cv::Mat ImageEnhancer::sharpenImage(const cv::Mat& image) {
 }
 
 cv::Mat ImageEnhancer::preprocessForOCR(const cv::Mat& image) {
-    cv::Mat processed = image.clone();
-    
     // 1. Convert to grayscale
-    processed = convertToGray(processed);
+    return preprocessGrayForOCR(convertToGray(image));
+}
+
+cv::Mat ImageEnhancer::preprocessForOCR(SheetContext& sheet, const cv::Rect& region) {
+    // 1. Grayscale comes from the sheet cache
+    return preprocessGrayForOCR(sheet.gray()(region));
+}
+
+cv::Mat ImageEnhancer::preprocessGrayForOCR(const cv::Mat& gray) {
+    cv::Mat processed;
     
     // 2. Enhance contrast
-    processed = enhanceContrast(processed, 3.0, 8);
+    processed = enhanceContrast(gray, 3.0, 8);
     
     // 3. Remove noise with gentle blur
     cv::GaussianBlur(processed, processed, cv::Size(3, 3), 0);
@@ -126,16 +132,17 @@ cv::Mat ImageEnhancer::preprocessForOCR(const cv::Mat& image) {
 }
 
 cv::Mat ImageEnhancer::preprocessForBubbles(const cv::Mat& image) {
-    cv::Mat processed = image.clone();
-    
-    // 1. Convert to grayscale
-    processed = convertToGray(processed);
-    
-    // 2. Apply Gaussian blur (helps HoughCircles)
-    cv::GaussianBlur(processed, processed, cv::Size(5, 5), 0);
+    // 1-2. Grayscale + Gaussian blur (helps HoughCircles)
+    SheetContext sheet(image);
+    return preprocessForBubbles(sheet);
+}
+
+cv::Mat ImageEnhancer::preprocessForBubbles(SheetContext& sheet) {
+    // 1-2. Grayscale + 5x5 Gaussian blur, shared with BubbleDetector through the cache
+    const cv::Mat& blurred = sheet.blurred(5);
     
     // 3. Enhance contrast
-    processed = enhanceContrast(processed, 2.0, 8);
+    cv::Mat processed = enhanceContrast(blurred, 2.0, 8);
     
     // 4. Apply adaptive threshold to clearly separate bubbles
     processed = adaptiveBinarize(processed, 15, 2);
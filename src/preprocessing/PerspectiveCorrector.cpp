@@ -1,20 +1,33 @@
 #include "PerspectiveCorrector.h"
+#include "Tracer.h"
 #include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <chrono>
 
 PerspectiveCorrector::PerspectiveCorrector(double cannyThreshold1, double cannyThreshold2)
-    : cannyThreshold1(cannyThreshold1), cannyThreshold2(cannyThreshold2) {
+    : cannyThreshold1(cannyThreshold1), cannyThreshold2(cannyThreshold2),
+      registrationMode(AUTO), markerInset(25.0f), lastMethod(NONE), lastRegistrationMs(0.0),
+      pyramidTargetSize(800), subPixelRefinement(true), warpMode(WARP_COLOR),
+      verbose(true) {
 }
 
+namespace {
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
 cv::Mat PerspectiveCorrector::preprocessForEdgeDetection(const cv::Mat& image) {
     cv::Mat gray, blurred;
     
-    // Convert to grayscale
+    // Convert to grayscale (pyramid levels are already gray: blur them directly)
     if (image.channels() == 3) {
         cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
     } else {
-        gray = image.clone();
+        gray = image;
     }
     
     // Apply Gaussian blur to reduce noise
@@ -24,8 +37,38 @@ cv::Mat PerspectiveCorrector::preprocessForEdgeDetection(const cv::Mat& image) {
 }
 
 std::vector<cv::Point2f> PerspectiveCorrector::detectPaperCorners(const cv::Mat& image) {
+    lastCornerTiming = CornerDetectionTiming();
+    auto totalStart = std::chrono::steady_clock::now();
+    
+    // Level 0: full-resolution gray, kept for the sub-pixel refinement
+    auto start = std::chrono::steady_clock::now();
+    cv::Mat gray;
+    if (image.channels() == 3) {
+        cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+    } else if (image.channels() == 4) {
+        cv::cvtColor(image, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = image;
+    }
+    lastCornerTiming.levelSizes.push_back(gray.size());
+    lastCornerTiming.levelMs.push_back(elapsedMs(start));
+    
+    // Halve until the next level would drop below the target (12-48 MP -> ~800-1600 px)
+    cv::Mat level = gray;
+    int levelIndex = 0;
+    while (pyramidTargetSize > 0 && std::max(level.cols, level.rows) / 2 >= pyramidTargetSize) {
+        start = std::chrono::steady_clock::now();
+        cv::Mat next;
+        cv::pyrDown(level, next);
+        level = next;
+        levelIndex++;
+        lastCornerTiming.levelSizes.push_back(level.size());
+        lastCornerTiming.levelMs.push_back(elapsedMs(start));
+    }
+    
     // Preprocess image
-    cv::Mat preprocessed = preprocessForEdgeDetection(image);
+    start = std::chrono::steady_clock::now();
+    cv::Mat preprocessed = preprocessForEdgeDetection(level);
     
     // Apply Canny edge detection
     cv::Mat edges;
@@ -34,8 +77,10 @@ std::vector<cv::Point2f> PerspectiveCorrector::detectPaperCorners(const cv::Mat&
     // Dilate to connect broken edges
     cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3));
     cv::dilate(edges, edges, kernel);
+    lastCornerTiming.edgeMs = elapsedMs(start);
     
     // Find contours
+    start = std::chrono::steady_clock::now();
     std::vector<std::vector<cv::Point>> contours;
     cv::findContours(edges, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
     
@@ -43,19 +88,64 @@ std::vector<cv::Point2f> PerspectiveCorrector::detectPaperCorners(const cv::Mat&
         throw std::runtime_error("Kağıt kenarları tespit edilemedi!");
     }
     
-    // Find largest quadrilateral
-    std::vector<cv::Point2f> corners = findLargestQuadrilateral(contours);
+    // Find largest quadrilateral (the area limit is in full-resolution pixels)
+    double levelScale = static_cast<double>(1 << levelIndex);
+    std::vector<cv::Point2f> corners = findLargestQuadrilateral(contours, 10000.0 / (levelScale * levelScale));
+    lastCornerTiming.contourMs = elapsedMs(start);
     
     if (corners.size() != 4) {
         throw std::runtime_error("Kağıdın 4 köşesi bulunamadı!");
     }
     
+    // Back to full resolution, then pull each corner onto the real edge intersection
+    for (auto& corner : corners) {
+        corner *= static_cast<float>(levelScale);
+    }
+    if (subPixelRefinement) {
+        start = std::chrono::steady_clock::now();
+        refineCorners(gray, corners, levelIndex);
+        lastCornerTiming.refineMs = elapsedMs(start);
+    }
+    
+    lastCornerTiming.totalMs = elapsedMs(totalStart);
+    
     // Order points
     return orderPoints(corners);
 }
 
+void PerspectiveCorrector::printCornerTiming() const {
+    const CornerDetectionTiming& timing = lastCornerTiming;
+    
+    std::cout << "  Piramit:";
+    for (size_t i = 0; i < timing.levelSizes.size(); i++) {
+        std::cout << (i > 0 ? " ->" : "") << " L" << i << " " << timing.levelSizes[i].width << "x"
+                  << timing.levelSizes[i].height << " (" << timing.levelMs[i] << " ms)";
+    }
+    std::cout << std::endl;
+    std::cout << "  Kenar: " << timing.edgeMs << " ms, kontur: " << timing.contourMs
+              << " ms, alt-piksel: " << timing.refineMs << " ms, toplam: " << timing.totalMs
+              << " ms" << std::endl;
+}
+
+void PerspectiveCorrector::refineCorners(const cv::Mat& gray, std::vector<cv::Point2f>& corners, int level) {
+    // Coarse corners are off by about one pixel of the search level (plus the dilation)
+    int halfWindow = std::min(21, std::max(5, 2 << level));
+    std::vector<cv::Point2f> refined = corners;
+    
+    cv::cornerSubPix(gray, refined, cv::Size(halfWindow, halfWindow), cv::Size(-1, -1),
+                     cv::TermCriteria(cv::TermCriteria::EPS + cv::TermCriteria::COUNT, 30, 0.01));
+    
+    // A corner hidden by a finger or shadow has no edge pair to lock onto: keep the coarse one
+    for (size_t i = 0; i < corners.size(); i++) {
+        if (cv::norm(refined[i] - corners[i]) <= halfWindow) {
+            corners[i] = refined[i];
+        }
+    }
+}
+
 std::vector<cv::Point2f> PerspectiveCorrector::findLargestQuadrilateral(
-    const std::vector<std::vector<cv::Point>>& contours) {
+    const std::vector<std::vector<cv::Point>>& contours,
+    double minArea) {
     
     double maxArea = 0;
     std::vector<cv::Point2f> largestQuad;
@@ -64,7 +154,7 @@ std::vector<cv::Point2f> PerspectiveCorrector::findLargestQuadrilateral(
         double area = cv::contourArea(contour);
         
         // Skip small contours
-        if (area < 10000) {
+        if (area < minArea) {
             continue;
         }
         
@@ -121,6 +211,15 @@ std::vector<cv::Point2f> PerspectiveCorrector::orderPoints(const std::vector<cv:
     return ordered;
 }
 
+std::vector<cv::Point2f> PerspectiveCorrector::sheetCorners(int outputWidth, int outputHeight, float inset) {
+    return {
+        cv::Point2f(inset, inset),
+        cv::Point2f(outputWidth - 1 - inset, inset),
+        cv::Point2f(outputWidth - 1 - inset, outputHeight - 1 - inset),
+        cv::Point2f(inset, outputHeight - 1 - inset)
+    };
+}
+
 cv::Mat PerspectiveCorrector::applyPerspectiveTransform(
     const cv::Mat& image,
     const std::vector<cv::Point2f>& corners,
@@ -132,48 +231,195 @@ cv::Mat PerspectiveCorrector::applyPerspectiveTransform(
     }
     
     // Define destination points for the warped image
-    std::vector<cv::Point2f> dst = {
-        cv::Point2f(0, 0),
-        cv::Point2f(outputWidth - 1, 0),
-        cv::Point2f(outputWidth - 1, outputHeight - 1),
-        cv::Point2f(0, outputHeight - 1)
-    };
+    std::vector<cv::Point2f> dst = sheetCorners(outputWidth, outputHeight, 0.0f);
     
-    // Calculate perspective transformation matrix
-    cv::Mat transformMatrix = cv::getPerspectiveTransform(corners, dst);
+    return warpToSheet(image, cv::getPerspectiveTransform(corners, dst), outputWidth, outputHeight);
+}
+
+cv::Mat PerspectiveCorrector::applyFiducialTransform(
+    const cv::Mat& image,
+    const std::vector<cv::Point2f>& centers,
+    int outputWidth,
+    int outputHeight) {
+    
+    if (centers.size() != 4) {
+        throw std::runtime_error("Perspektif dönüşümü için 4 işaretçi merkezi gerekli!");
+    }
+    
+    // Printed markers sit markerInset pixels inside each corner of the corrected sheet
+    std::vector<cv::Point2f> dst = sheetCorners(outputWidth, outputHeight, markerInset);
+    
+    return warpToSheet(image, cv::getPerspectiveTransform(centers, dst), outputWidth, outputHeight);
+}
+
+cv::Mat PerspectiveCorrector::warpToSheet(
+    const cv::Mat& image,
+    const cv::Mat& homography,
+    int outputWidth,
+    int outputHeight) {
     
     // Apply warp perspective
     cv::Mat warped;
-    cv::warpPerspective(image, warped, transformMatrix, cv::Size(outputWidth, outputHeight));
+    cv::warpPerspective(image, warped, homography, cv::Size(outputWidth, outputHeight));
     
     return warped;
 }
 
-cv::Mat PerspectiveCorrector::correctPerspective(
+bool PerspectiveCorrector::detectFiducialMarkers(
+    const cv::Mat& image,
+    std::vector<cv::Point2f>& centers,
+    int outputWidth,
+    int outputHeight) {
+    
+    return fiducialDetector.detectMarkers(image, centers, markerQuadAspect(outputWidth, outputHeight));
+}
+
+double PerspectiveCorrector::markerQuadAspect(int outputWidth, int outputHeight) const {
+    double width = outputWidth - 1 - 2.0 * markerInset;
+    double height = outputHeight - 1 - 2.0 * markerInset;
+    return (width > 0.0 && height > 0.0) ? width / height : 0.0;
+}
+
+bool PerspectiveCorrector::registerSheet(
     const cv::Mat& image,
+    cv::Mat& homography,
     int outputWidth,
     int outputHeight) {
     
+    OMR_TRACE_SCOPE("PerspectiveCorrector::registerSheet");
+    auto startTime = std::chrono::steady_clock::now();
+    lastMethod = NONE;
+    lastRegistrationMs = 0.0;
+    
+    // One gray conversion serves the marker search, the corner search and a gray warp
+    if (image.channels() == 3) {
+        cv::cvtColor(image, registrationGray, cv::COLOR_BGR2GRAY);
+    } else if (image.channels() == 4) {
+        cv::cvtColor(image, registrationGray, cv::COLOR_BGRA2GRAY);
+    } else {
+        registrationGray = image;
+    }
+    
     try {
-        // Detect corners
-        std::vector<cv::Point2f> corners = detectPaperCorners(image);
+        std::vector<cv::Point2f> points;
+        std::vector<cv::Point2f> targets;
         
-        // Apply transformation
-        cv::Mat corrected = applyPerspectiveTransform(image, corners, outputWidth, outputHeight);
+        // Corner markers: four small windows instead of a full-frame edge pass
+        if (registrationMode != CONTOUR_ONLY &&
+            fiducialDetector.detectMarkers(registrationGray, points, markerQuadAspect(outputWidth, outputHeight))) {
+            lastMethod = FIDUCIAL;
+            targets = sheetCorners(outputWidth, outputHeight, markerInset);
+        } else if (registrationMode == FIDUCIAL_ONLY) {
+            throw std::runtime_error("Köşe işaretçileri bulunamadı!");
+        } else {
+            // Sheets without markers: paper outline
+            points = detectPaperCorners(registrationGray);
+            lastMethod = CONTOUR;
+            targets = sheetCorners(outputWidth, outputHeight, 0.0f);
+        }
+        
+        homography = cv::getPerspectiveTransform(points, targets);
+        lastRegistrationMs = elapsedMs(startTime);
         
-        std::cout << "Perspektif düzeltmesi başarılı" << std::endl;
-        return corrected;
+        if (verbose) {
+            std::cout << "Perspektif düzeltmesi başarılı ("
+                      << (lastMethod == FIDUCIAL ? "köşe işaretçileri" : "kağıt konturu") << ", "
+                      << lastRegistrationMs << " ms)" << std::endl;
+            if (lastMethod == CONTOUR) {
+                printCornerTiming();
+            }
+        }
+        return true;
         
     } catch (const std::exception& e) {
-        std::cerr << "Perspektif düzeltme hatası: " << e.what() << std::endl;
-        // Return original image if correction fails
-        cv::Mat resized;
-        cv::resize(image, resized, cv::Size(outputWidth, outputHeight));
-        return resized;
+        lastMethod = NONE;
+        // Live tracking retries every frame while the sheet is out of view
+        if (verbose) {
+            std::cerr << "Perspektif düzeltme hatası: " << e.what() << std::endl;
+        }
+        return false;
+    }
+}
+
+const cv::Mat& PerspectiveCorrector::getRegistrationGray() const {
+    return registrationGray;
+}
+
+cv::Mat PerspectiveCorrector::correctPerspective(
+    const cv::Mat& image,
+    int outputWidth,
+    int outputHeight) {
+    
+    OMR_TRACE_SCOPE("PerspectiveCorrector::correctPerspective");
+    
+    // Gray mode warps the registration gray: one channel instead of three
+    cv::Mat homography;
+    bool registered = registerSheet(image, homography, outputWidth, outputHeight);
+    const cv::Mat& source = warpMode == WARP_GRAY ? registrationGray : image;
+    
+    if (registered) {
+        return warpToSheet(source, homography, outputWidth, outputHeight);
     }
+    
+    // Return original image if correction fails
+    cv::Mat resized;
+    cv::resize(source, resized, cv::Size(outputWidth, outputHeight));
+    return resized;
 }
 
 void PerspectiveCorrector::setCannyThresholds(double threshold1, double threshold2) {
     cannyThreshold1 = threshold1;
     cannyThreshold2 = threshold2;
 }
+
+void PerspectiveCorrector::setRegistrationMode(RegistrationMode mode) {
+    registrationMode = mode;
+}
+
+PerspectiveCorrector::RegistrationMode PerspectiveCorrector::getRegistrationMode() const {
+    return registrationMode;
+}
+
+void PerspectiveCorrector::setMarkerInset(float inset) {
+    markerInset = inset;
+}
+
+float PerspectiveCorrector::getMarkerInset() const {
+    return markerInset;
+}
+
+void PerspectiveCorrector::setFiducialConfig(const FiducialConfig& config) {
+    fiducialDetector.setConfig(config);
+}
+
+PerspectiveCorrector::RegistrationMethod PerspectiveCorrector::getLastMethod() const {
+    return lastMethod;
+}
+
+double PerspectiveCorrector::getLastRegistrationMs() const {
+    return lastRegistrationMs;
+}
+
+void PerspectiveCorrector::setPyramidTargetSize(int targetSize) {
+    pyramidTargetSize = targetSize;
+}
+
+void PerspectiveCorrector::setSubPixelRefinement(bool enabled) {
+    subPixelRefinement = enabled;
+}
+
+const CornerDetectionTiming& PerspectiveCorrector::getLastCornerTiming() const {
+    return lastCornerTiming;
+}
+
+void PerspectiveCorrector::setWarpMode(WarpMode mode) {
+    warpMode = mode;
+}
+
+PerspectiveCorrector::WarpMode PerspectiveCorrector::getWarpMode() const {
+    return warpMode;
+}
+
+void PerspectiveCorrector::setVerbose(bool verbose) {
+    this->verbose = verbose;
+}
@@ -0,0 +1,140 @@
+#include "SheetContext.h"
+
+SheetContext::SheetContext()
+    : hasGray(false),
+      hasAdaptive(false),
+      hasOtsu(false),
+      hasIntegral(false),
+      otsuValue(0),
+      computeCount(0) {
+}
+
+SheetContext::SheetContext(const cv::Mat& sheet)
+    : SheetContext() {
+    reset(sheet);
+}
+
+void SheetContext::reset(const cv::Mat& sheet) {
+    // Header only: the caller keeps the pixels alive while the context is in use
+    this->sheet = sheet;
+
+    grayView.release();
+    hasGray = false;
+    hasAdaptive = false;
+    hasOtsu = false;
+    hasIntegral = false;
+    otsuValue = 0;
+    computeCount = 0;
+
+    for (auto& entry : blurs) {
+        entry.valid = false;
+    }
+}
+
+bool SheetContext::empty() const {
+    return sheet.empty();
+}
+
+const cv::Mat& SheetContext::image() const {
+    return sheet;
+}
+
+cv::Size SheetContext::size() const {
+    return sheet.size();
+}
+
+const cv::Mat& SheetContext::gray() {
+    if (hasGray) {
+        return grayView;
+    }
+
+    if (sheet.channels() == 3) {
+        cv::cvtColor(sheet, grayImage, cv::COLOR_BGR2GRAY);
+        grayView = grayImage;
+        computeCount++;
+    } else if (sheet.channels() == 4) {
+        cv::cvtColor(sheet, grayImage, cv::COLOR_BGRA2GRAY);
+        grayView = grayImage;
+        computeCount++;
+    } else {
+        // Already gray: share the caller's pixels, no copy
+        grayView = sheet;
+    }
+
+    hasGray = true;
+    return grayView;
+}
+
+const cv::Mat& SheetContext::blurred(int kernelSize) {
+    if (kernelSize % 2 == 0) {
+        kernelSize++;
+    }
+
+    BlurEntry* entry = nullptr;
+    for (auto& candidate : blurs) {
+        if (candidate.kernelSize == kernelSize) {
+            entry = &candidate;
+            break;
+        }
+    }
+
+    if (!entry) {
+        blurs.push_back(BlurEntry{kernelSize, false, cv::Mat()});
+        entry = &blurs.back();
+    }
+
+    if (!entry->valid) {
+        cv::GaussianBlur(gray(), entry->image, cv::Size(kernelSize, kernelSize), 0);
+        entry->valid = true;
+        computeCount++;
+    }
+
+    return entry->image;
+}
+
+const cv::Mat& SheetContext::adaptiveBinary() {
+    if (!hasAdaptive) {
+        cv::adaptiveThreshold(
+            blurred(3), adaptiveImage, 255,
+            cv::ADAPTIVE_THRESH_GAUSSIAN_C,
+            cv::THRESH_BINARY_INV,
+            11, 2
+        );
+        hasAdaptive = true;
+        computeCount++;
+    }
+
+    return adaptiveImage;
+}
+
+const cv::Mat& SheetContext::otsuBinary() {
+    if (!hasOtsu) {
+        otsuValue = static_cast<int>(cv::threshold(
+            gray(), otsuImage, 0, 255, cv::THRESH_BINARY_INV | cv::THRESH_OTSU));
+        hasOtsu = true;
+        computeCount++;
+    }
+
+    return otsuImage;
+}
+
+int SheetContext::otsuThreshold() {
+    otsuBinary();
+    return otsuValue;
+}
+
+const cv::Mat& SheetContext::inkIntegral() {
+    if (!hasIntegral) {
+        // 0/1 so the sums count ink pixels and cannot overflow on large scans
+        cv::threshold(gray(), inkMask, otsuThreshold(), 1, cv::THRESH_BINARY_INV);
+        cv::integral(inkMask, integralImage, CV_32S);
+        hasIntegral = true;
+        computeCount++;
+    }
+
+    return integralImage;
+}
+
+int SheetContext::getComputeCount() const {
+    return computeCount;
+}
@@ -0,0 +1,219 @@
+#include "SheetTracker.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+SheetTracker::SheetTracker(int sheetWidth, int sheetHeight, const SheetTrackerConfig& config)
+    : config(config), state(LOST), framesSinceDetection(0), stableFrames(0), lastMotion(0.0),
+      lastUpdateMs(0.0) {
+
+    sheetCorners = {
+        cv::Point2f(0.0f, 0.0f),
+        cv::Point2f(sheetWidth - 1.0f, 0.0f),
+        cv::Point2f(sheetWidth - 1.0f, sheetHeight - 1.0f),
+        cv::Point2f(0.0f, sheetHeight - 1.0f)
+    };
+
+    // Detection is retried every frame while the sheet is out of view
+    corrector.setVerbose(false);
+}
+
+void SheetTracker::reset() {
+    state = LOST;
+    corners.clear();
+    homography.release();
+    framesSinceDetection = 0;
+    stableFrames = 0;
+    lastMotion = 0.0;
+    previousPyramid.clear();
+}
+
+SheetTracker::State SheetTracker::update(const cv::Mat& frame) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (frame.empty()) {
+        reset();
+        return state;
+    }
+
+    if (frame.channels() == 3) {
+        cv::cvtColor(frame, currentGray, cv::COLOR_BGR2GRAY);
+    } else if (frame.channels() == 4) {
+        cv::cvtColor(frame, currentGray, cv::COLOR_BGRA2GRAY);
+    } else {
+        frame.copyTo(currentGray);
+    }
+
+    cv::buildOpticalFlowPyramid(currentGray, currentPyramid, config.windowSize, config.maxLevel);
+
+    bool tracked = false;
+    std::vector<cv::Point2f> trackedCorners;
+    if (state != LOST && !previousPyramid.empty() && track(trackedCorners)) {
+        tracked = true;
+        lastMotion = 0.0;
+        for (size_t i = 0; i < corners.size(); i++) {
+            lastMotion = std::max(lastMotion, static_cast<double>(cv::norm(trackedCorners[i] - corners[i])));
+        }
+        corners = trackedCorners;
+        homography = cv::getPerspectiveTransform(corners, sheetCorners);
+        state = TRACKING;
+        framesSinceDetection++;
+        stableFrames = lastMotion < config.stableMotion ? stableFrames + 1 : 0;
+    }
+
+    // Full detection: initialization, tracking loss, and a periodic check against drift
+    bool periodic = tracked && config.redetectInterval > 0 && framesSinceDetection >= config.redetectInterval;
+    if (!tracked || periodic) {
+        if (detect(currentGray)) {
+            state = DETECTED;
+            framesSinceDetection = 0;
+            if (!periodic) {
+                lastMotion = 0.0;
+                stableFrames = 0;
+            }
+        } else if (!tracked) {
+            state = LOST;
+            corners.clear();
+            homography.release();
+            stableFrames = 0;
+        }
+    }
+
+    // Keep this frame's pyramid for the next one instead of rebuilding it
+    std::swap(previousGray, currentGray);
+    std::swap(previousPyramid, currentPyramid);
+
+    lastUpdateMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return state;
+}
+
+bool SheetTracker::track(std::vector<cv::Point2f>& tracked) {
+    std::vector<uchar> status;
+    std::vector<float> error;
+    cv::TermCriteria criteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 20, 0.03);
+
+    cv::calcOpticalFlowPyrLK(previousPyramid, currentPyramid, corners, tracked, status, error,
+                             config.windowSize, config.maxLevel, criteria);
+
+    // Forward-backward check: a corner that does not track back to itself slid along an edge
+    std::vector<cv::Point2f> backTracked;
+    std::vector<uchar> backStatus;
+    cv::calcOpticalFlowPyrLK(currentPyramid, previousPyramid, tracked, backTracked, backStatus, error,
+                             config.windowSize, config.maxLevel, criteria);
+
+    for (size_t i = 0; i < corners.size(); i++) {
+        if (!status[i] || !backStatus[i] ||
+            cv::norm(backTracked[i] - corners[i]) > config.maxForwardBackwardError) {
+            return false;
+        }
+    }
+
+    if (!isPlausible(tracked, currentGray.size())) {
+        return false;
+    }
+
+    double previousArea = std::abs(cv::contourArea(corners));
+    double currentArea = std::abs(cv::contourArea(tracked));
+    return previousArea > 0.0 && std::abs(currentArea - previousArea) <= config.maxAreaChange * previousArea;
+}
+
+bool SheetTracker::detect(const cv::Mat& gray) {
+    cv::Mat detected;
+    int sheetWidth = static_cast<int>(sheetCorners[2].x) + 1;
+    int sheetHeight = static_cast<int>(sheetCorners[2].y) + 1;
+    if (!corrector.registerSheet(gray, detected, sheetWidth, sheetHeight)) {
+        return false;
+    }
+
+    // Track the sheet outline in the image whichever path (markers / contour) found it
+    std::vector<cv::Point2f> imageCorners;
+    cv::perspectiveTransform(sheetCorners, imageCorners, detected.inv());
+    if (!isPlausible(imageCorners, gray.size())) {
+        return false;
+    }
+
+    corners = imageCorners;
+    homography = detected;
+    return true;
+}
+
+bool SheetTracker::isPlausible(const std::vector<cv::Point2f>& quad, const cv::Size& frameSize) const {
+    if (quad.size() != 4 || !cv::isContourConvex(quad)) {
+        return false;
+    }
+
+    // LK needs its window around each corner inside the frame
+    float margin = config.windowSize.width / 2.0f;
+    for (const auto& point : quad) {
+        if (point.x < -margin || point.y < -margin ||
+            point.x > frameSize.width + margin || point.y > frameSize.height + margin) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SheetTracker::State SheetTracker::getState() const {
+    return state;
+}
+
+bool SheetTracker::hasSheet() const {
+    return state != LOST;
+}
+
+const std::vector<cv::Point2f>& SheetTracker::getCorners() const {
+    return corners;
+}
+
+cv::Mat SheetTracker::getHomography() const {
+    return homography;
+}
+
+int SheetTracker::getStableFrames() const {
+    return stableFrames;
+}
+
+double SheetTracker::getLastMotion() const {
+    return lastMotion;
+}
+
+double SheetTracker::getLastUpdateMs() const {
+    return lastUpdateMs;
+}
+
+PerspectiveCorrector& SheetTracker::getCorrector() {
+    return corrector;
+}
+
+void SheetTracker::drawOverlay(cv::Mat& frame, int autoCaptureFrames) const {
+    // Hershey fonts have no Turkish glyphs: ASCII labels
+    std::string label = "KAGIT ARANIYOR";
+    cv::Scalar color(0, 0, 255);
+
+    if (state != LOST) {
+        std::vector<cv::Point> polygon;
+        for (const auto& corner : corners) {
+            polygon.push_back(cv::Point(cvRound(corner.x), cvRound(corner.y)));
+        }
+
+        color = state == TRACKING ? cv::Scalar(0, 255, 0) : cv::Scalar(0, 255, 255);
+        cv::polylines(frame, std::vector<std::vector<cv::Point>>{polygon}, true, color, 2);
+        for (const auto& point : polygon) {
+            cv::circle(frame, point, 6, color, cv::FILLED);
+        }
+
+        label = state == TRACKING ? "TAKIP" : "TESPIT";
+        if (autoCaptureFrames > 0) {
+            label += " " + std::to_string(std::min(stableFrames, autoCaptureFrames)) + "/" +
+                     std::to_string(autoCaptureFrames);
+        }
+    }
+
+    char timing[32];
+    std::snprintf(timing, sizeof(timing), "%.1f ms", lastUpdateMs);
+    cv::putText(frame, label, cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 0.8, color, 2);
+    cv::putText(frame, timing, cv::Point(10, 60), cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(255, 255, 255), 1);
+}
@@ -0,0 +1,152 @@
+#include "SheetWarp.h"
+
+SheetWarp::SheetWarp()
+    : imageToSheet(cv::Matx33d::eye()), sheetToImage(cv::Matx33d::eye()), hasHomography(false),
+      warpedPixelCount(0), mapBuildCount(0) {
+}
+
+void SheetWarp::setHomography(const cv::Mat& imageToSheet, const cv::Size& sheetSize) {
+    cv::Matx33d homography = imageToSheet;
+
+    // A steady camera keeps the homography: the maps stay valid across frames
+    if (hasHomography && sheetSize == this->sheetSize && cv::norm(homography - this->imageToSheet) < 1e-9) {
+        return;
+    }
+
+    this->imageToSheet = homography;
+    this->sheetToImage = homography.inv();
+    this->sheetSize = sheetSize;
+    hasHomography = true;
+
+    maps.clear();
+    warped.clear();
+    mapBuildCount = 0;
+}
+
+void SheetWarp::setSource(const cv::Mat& image) {
+    source = image;
+    warped.clear();
+    warpedPixelCount = 0;
+}
+
+void SheetWarp::reset() {
+    hasHomography = false;
+    source.release();
+    maps.clear();
+    warped.clear();
+    warpedPixelCount = 0;
+    mapBuildCount = 0;
+}
+
+bool SheetWarp::isReady() const {
+    return hasHomography && !source.empty();
+}
+
+const cv::Size& SheetWarp::getSheetSize() const {
+    return sheetSize;
+}
+
+size_t SheetWarp::getWarpedPixelCount() const {
+    return warpedPixelCount;
+}
+
+size_t SheetWarp::getMapBuildCount() const {
+    return mapBuildCount;
+}
+
+void SheetWarp::precomputeMaps(const std::vector<cv::Rect>& sheetRects) {
+    for (const auto& rect : sheetRects) {
+        cv::Rect clipped = rect & cv::Rect(cv::Point(0, 0), sheetSize);
+        if (clipped.area() > 0) {
+            mapsFor(clipped);
+        }
+    }
+}
+
+const SheetWarp::RegionMaps& SheetWarp::mapsFor(const cv::Rect& rect) {
+    for (const auto& entry : maps) {
+        if (entry.rect == rect) {
+            return entry;
+        }
+    }
+
+    // Sheet pixel grid of the rectangle, projected back into the photo
+    cv::Mat grid(rect.size(), CV_32FC2);
+    for (int y = 0; y < rect.height; y++) {
+        cv::Vec2f* row = grid.ptr<cv::Vec2f>(y);
+        for (int x = 0; x < rect.width; x++) {
+            row[x] = cv::Vec2f(static_cast<float>(rect.x + x), static_cast<float>(rect.y + y));
+        }
+    }
+
+    cv::Mat sourceCoordinates;
+    cv::perspectiveTransform(grid, sourceCoordinates, cv::Mat(sheetToImage));
+
+    RegionMaps entry;
+    entry.rect = rect;
+    cv::convertMaps(sourceCoordinates, cv::noArray(), entry.fixedMap, entry.fractionMap, CV_16SC2);
+
+    maps.push_back(std::move(entry));
+    mapBuildCount++;
+    return maps.back();
+}
+
+cv::Mat SheetWarp::region(const cv::Rect& sheetRect) {
+    if (!isReady()) {
+        return cv::Mat();
+    }
+
+    cv::Rect rect = sheetRect & cv::Rect(cv::Point(0, 0), sheetSize);
+    if (rect.area() <= 0) {
+        return cv::Mat();
+    }
+
+    for (const auto& entry : warped) {
+        if (entry.rect == rect) {
+            return entry.pixels;
+        }
+    }
+
+    // Same sampling as warpPerspective: bilinear, black outside the photo
+    const RegionMaps& regionMaps = mapsFor(rect);
+    WarpedRegion entry;
+    entry.rect = rect;
+    cv::remap(source, entry.pixels, regionMaps.fixedMap, regionMaps.fractionMap,
+              cv::INTER_LINEAR, cv::BORDER_CONSTANT);
+
+    warpedPixelCount += static_cast<size_t>(rect.area());
+    warped.push_back(entry);
+    return entry.pixels;
+}
+
+cv::Mat SheetWarp::renderRegions(const std::vector<cv::Rect>& sheetRects) {
+    if (!isReady()) {
+        return cv::Mat();
+    }
+
+    std::vector<cv::Rect> clippedRects;
+    cv::Scalar sum = cv::Scalar::all(0);
+    double pixelCount = 0.0;
+
+    for (const auto& rect : sheetRects) {
+        cv::Rect clipped = rect & cv::Rect(cv::Point(0, 0), sheetSize);
+        if (clipped.area() <= 0) {
+            continue;
+        }
+        clippedRects.push_back(clipped);
+        sum += cv::sum(region(clipped));
+        pixelCount += clipped.area();
+    }
+
+    // Fill with the regions' mean: near this photo's paper tone, so a sheet-wide Otsu counts the
+    // fill as paper (pure white would add a third, brighter mode that can pull the threshold
+    // above the paper). The histogram itself is not preserved; the fill adds one large peak.
+    cv::Scalar background = pixelCount > 0.0 ? sum * (1.0 / pixelCount) : cv::Scalar::all(255);
+    cv::Mat sheet(sheetSize, source.type(), background);
+    for (const auto& rect : clippedRects) {
+        cv::Mat target = sheet(rect);
+        region(rect).copyTo(target);
+    }
+
+    return sheet;
+}
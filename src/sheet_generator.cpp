@@ -0,0 +1,695 @@
+/**
+ * SENTETİK SINAV KAĞIDI ÜRETİCİ
+ * SheetTemplate yerleşimine uyan kağıtlar çizer: balonlar seçilen yoğunlukta doldurulur,
+ * boşluklara yazı tipi (font) veya kalem darbesi (stroke) taklidiyle cevap yazılır.
+ * Kağıt sonra masada çekilmiş bir fotoğrafa dönüştürülür (perspektif, bulanıklık, gürültü,
+ * ışık gradyanı) ve gerçek cevaplar ground_truth.csv dosyasına yazılır. Üretim thread
+ * havuzunda paralel yapılır; her kağıt kendi seed'inden üretildiği için çıktı thread
+ * sayısından bağımsızdır.
+ *
+ * Kullanım: ./sheet_generator --count 1000 --output sentetik/ [--threads N] [--seed S]
+ *           [--template sablon.yml] [--answer-key answer_key.txt] [--answer-rate 0.9]
+ *           [--correct-rate 0.7] [--fill 0.7 1.0] [--text font|stroke|mixed] [--perspective 0.04]
+ *           [--blur 1.2] [--noise 4] [--lighting 0.3] [--photo-width 1200] [--format jpg|png]
+ *           ./OMR_System --batch sentetik/ --ground-truth sentetik/ground_truth.csv
+ */
+
+#include "AnswerComparator.h"
+#include "AnswerKey.h"
+#include "GroundTruth.h"
+#include "SheetTemplate.h"
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Printed registration markers, placed at the template's marker inset
+const int MARKER_HALF = 15;
+
+const char* const WORDS[] = {
+    "Istanbul", "Ankara", "Izmir", "Cumhuriyet", "Ataturk", "Anadolu", "Trabzon", "Bursa",
+    "Karadeniz", "Ege", "1923", "1071", "Malazgirt", "Osmanli", "Sakarya", "Kurtulus",
+    "Meclis", "Lozan", "Konya", "Edirne"
+};
+const int WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+// Sheets whose answers are kept to check the ground truth file after writing
+const size_t ROUND_TRIP_SHEETS = 50;
+
+enum TextStyle { FONT_TEXT, STROKE_TEXT, MIXED_TEXT };
+
+struct GeneratorOptions {
+    int count;
+    std::string outputDir;
+    int threads;                // 0 = donanım thread sayısı
+    uint64_t seed;
+    std::string templatePath;   // boş = varsayılan yerleşim
+    std::string answerKeyPath;  // boş = cevaplar rastgele
+    double answerRate;          // soru cevaplanmış olma olasılığı
+    double correctRate;         // cevap anahtarı varken doğru cevap olasılığı
+    double minFill;             // balon içi mürekkep oranı aralığı
+    double maxFill;
+    TextStyle textStyle;
+    double perspective;         // köşe sapması, kağıt boyutunun oranı
+    double maxBlur;             // Gauss sigma üst sınırı
+    double noise;               // Gauss gürültü sigması
+    double lighting;            // ışık gradyanının en karanlık uçtaki kaybı (0-1)
+    int photoWidth;             // fotoğraf 3:4 dikey
+    std::string format;
+    int jpegQuality;
+
+    GeneratorOptions()
+        : count(100), outputDir("synthetic_sheets"), threads(0), seed(42), answerRate(0.9),
+          correctRate(0.7), minFill(0.7), maxFill(1.0), textStyle(MIXED_TEXT), perspective(0.04),
+          maxBlur(1.2), noise(4.0), lighting(0.3), photoWidth(1200), format("jpg"), jpegQuality(90) {}
+};
+
+struct WorkerTiming {
+    double renderMs;
+    double distortMs;
+    double writeMs;
+
+    WorkerTiming() : renderMs(0.0), distortMs(0.0), writeMs(0.0) {}
+};
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool isAscii(const std::string& text) {
+    return std::all_of(text.begin(), text.end(), [](unsigned char c) { return c >= 0x20 && c < 0x7f; });
+}
+
+// Rows arrive out of order from the workers; the file is written in sheet order
+class GroundTruthWriter {
+public:
+    explicit GroundTruthWriter(const std::string& path) : out(path), nextIndex(0) {
+        if (out.is_open()) {
+            GroundTruth::writeHeader(out);
+        }
+    }
+
+    bool isOpen() const { return out.is_open(); }
+
+    // All workers must have finished; rows still pending are lost
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        out.close();
+    }
+
+    void add(size_t index, std::string rows) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending[index] = std::move(rows);
+        while (!pending.empty() && pending.begin()->first == nextIndex) {
+            out << pending.begin()->second;
+            pending.erase(pending.begin());
+            nextIndex++;
+        }
+    }
+
+private:
+    std::ofstream out;
+    std::mutex mutex;
+    std::map<size_t, std::string> pending;
+    size_t nextIndex;
+};
+
+class SheetGenerator {
+public:
+    SheetGenerator(const GeneratorOptions& options, const SheetTemplate& sheetTemplate, const AnswerKey& answerKey)
+        : options(options), sheetTemplate(sheetTemplate), answerKey(answerKey),
+          sheetSize(sheetTemplate.getSheetWidth(), sheetTemplate.getSheetHeight()) {
+        blankSheet = cv::Mat(sheetSize, CV_8UC3, cv::Scalar(248, 248, 248));
+        drawMarkers(blankSheet);
+        drawBubbleOutlines(blankSheet);
+    }
+
+    cv::Mat renderSheet(std::vector<Answer>& answers, cv::RNG& rng) const {
+        cv::Mat sheet = blankSheet.clone();
+        const CompiledSheetLayout& layout = sheetTemplate.getLayout();
+        answers.clear();
+
+        for (size_t i = 0; i < layout.regionCount(); i++) {
+            Answer answer;
+            answer.questionNumber = layout.questionNumber[i];
+            bool answered = rng.uniform(0.0, 1.0) < options.answerRate;
+
+            if (layout.type[i] == QuestionRegion::FILL_IN_BLANK) {
+                answer.type = Answer::FILL_IN_BLANK;
+                if (answered) {
+                    answer.textAnswer = chooseText(answer.questionNumber, rng);
+                    bool stroke = options.textStyle == STROKE_TEXT ||
+                                  (options.textStyle == MIXED_TEXT && rng.uniform(0, 2) == 1);
+                    if (stroke) {
+                        drawStrokeText(sheet, layout.regionRect(i), answer.textAnswer, rng);
+                    } else {
+                        drawFontText(sheet, layout.regionRect(i), answer.textAnswer, rng);
+                    }
+                }
+            } else {
+                answer.type = (layout.type[i] == QuestionRegion::TRUE_FALSE) ? Answer::TRUE_FALSE
+                                                                               : Answer::MULTIPLE_CHOICE;
+                if (answered && layout.optionCount[i] > 0) {
+                    answer.selectedOption = chooseOption(answer, layout.optionCount[i], rng);
+                    int bubble = layout.firstBubble[i] + answer.selectedOption;
+                    fillBubble(sheet, cv::Point(layout.bubbleX[bubble], layout.bubbleY[bubble]),
+                               layout.bubbleRadius[bubble], rng.uniform(options.minFill, options.maxFill), rng);
+                }
+            }
+
+            answers.push_back(answer);
+        }
+
+        return sheet;
+    }
+
+    // The sheet photographed on a desk: perspective, lighting gradient, focus blur, sensor noise
+    cv::Mat photograph(const cv::Mat& sheet, cv::RNG& rng) const {
+        cv::Size photoSize(options.photoWidth, options.photoWidth * 4 / 3);
+
+        // The whole sheet stays in frame; corner jitter and placement share the free margin
+        float fit = std::min(static_cast<float>(photoSize.width) / sheetSize.width,
+                             static_cast<float>(photoSize.height) / sheetSize.height);
+        float scale = fit * rng.uniform(0.8f, 0.9f);
+        float halfW = sheetSize.width * scale / 2.0f;
+        float halfH = sheetSize.height * scale / 2.0f;
+        float marginX = photoSize.width / 2.0f - halfW;
+        float marginY = photoSize.height / 2.0f - halfH;
+        float jitter = std::min(static_cast<float>(options.perspective) * sheetSize.width * scale,
+                                0.8f * std::min(marginX, marginY));
+        float slackX = std::max(0.0f, marginX - jitter) * 0.5f;
+        float slackY = std::max(0.0f, marginY - jitter) * 0.5f;
+        cv::Point2f center(photoSize.width / 2.0f + rng.uniform(-slackX, slackX + 1e-3f),
+                           photoSize.height / 2.0f + rng.uniform(-slackY, slackY + 1e-3f));
+
+        std::vector<cv::Point2f> src = {
+            cv::Point2f(0, 0), cv::Point2f(sheetSize.width - 1.0f, 0),
+            cv::Point2f(sheetSize.width - 1.0f, sheetSize.height - 1.0f), cv::Point2f(0, sheetSize.height - 1.0f)
+        };
+        std::vector<cv::Point2f> dst = {
+            center + cv::Point2f(-halfW, -halfH), center + cv::Point2f(halfW, -halfH),
+            center + cv::Point2f(halfW, halfH), center + cv::Point2f(-halfW, halfH)
+        };
+        if (jitter > 0.0f) {
+            for (auto& point : dst) {
+                point += cv::Point2f(rng.uniform(-jitter, jitter), rng.uniform(-jitter, jitter));
+            }
+        }
+
+        int desk = rng.uniform(50, 120);
+        cv::Mat photo;
+        cv::warpPerspective(sheet, photo, cv::getPerspectiveTransform(src, dst), photoSize, cv::INTER_LINEAR,
+                            cv::BORDER_CONSTANT, cv::Scalar(desk, desk + 5, desk + 10));
+
+        applyLighting(photo, rng);
+
+        double sigma = rng.uniform(0.0, std::max(options.maxBlur, 1e-6));
+        if (sigma > 0.3) {
+            cv::GaussianBlur(photo, photo, cv::Size(0, 0), sigma);
+        }
+
+        if (options.noise > 0.0) {
+            cv::Mat noise(photo.size(), CV_16SC3);
+            rng.fill(noise, cv::RNG::NORMAL, cv::Scalar::all(0), cv::Scalar::all(options.noise));
+            cv::Mat noisy;
+            cv::add(photo, noise, noisy, cv::noArray(), CV_8UC3);
+            photo = noisy;
+        }
+
+        return photo;
+    }
+
+private:
+    const GeneratorOptions& options;
+    const SheetTemplate& sheetTemplate;
+    const AnswerKey& answerKey;
+    cv::Size sheetSize;
+    cv::Mat blankSheet;     // markers and empty bubbles, drawn once
+
+    void drawMarkers(cv::Mat& sheet) const {
+        // Top: solid squares, bottom: concentric targets
+        if (!sheetTemplate.hasMarkers()) {
+            return;
+        }
+        int inset = sheetTemplate.getMarkerInset();
+        int right = sheetSize.width - 1 - inset;
+        int bottom = sheetSize.height - 1 - inset;
+        cv::Point centers[4] = {
+            cv::Point(inset, inset), cv::Point(right, inset),
+            cv::Point(right, bottom), cv::Point(inset, bottom)
+        };
+        for (int i = 0; i < 4; i++) {
+            if (i < 2) {
+                cv::rectangle(sheet, centers[i] - cv::Point(MARKER_HALF, MARKER_HALF),
+                              centers[i] + cv::Point(MARKER_HALF, MARKER_HALF), cv::Scalar(0, 0, 0), cv::FILLED);
+            } else {
+                cv::circle(sheet, centers[i], MARKER_HALF, cv::Scalar(0, 0, 0), cv::FILLED);
+                cv::circle(sheet, centers[i], 10, cv::Scalar(248, 248, 248), cv::FILLED);
+                cv::circle(sheet, centers[i], 5, cv::Scalar(0, 0, 0), cv::FILLED);
+            }
+        }
+    }
+
+    void drawBubbleOutlines(cv::Mat& sheet) const {
+        const CompiledSheetLayout& layout = sheetTemplate.getLayout();
+        for (size_t b = 0; b < layout.bubbleCount(); b++) {
+            cv::circle(sheet, cv::Point(layout.bubbleX[b], layout.bubbleY[b]), layout.bubbleRadius[b],
+                       cv::Scalar(40, 40, 40), 2, cv::LINE_AA);
+        }
+    }
+
+    int chooseOption(const Answer& answer, int optionCount, cv::RNG& rng) const {
+        if (answerKey.hasAnswer(answer.questionNumber)) {
+            Answer correct = answerKey.getAnswer(answer.questionNumber);
+            if (correct.type == answer.type && correct.selectedOption >= 0 && correct.selectedOption < optionCount) {
+                if (optionCount < 2 || rng.uniform(0.0, 1.0) < options.correctRate) {
+                    return correct.selectedOption;
+                }
+                // Any other option, uniformly
+                int wrong = rng.uniform(0, optionCount - 1);
+                return wrong >= correct.selectedOption ? wrong + 1 : wrong;
+            }
+        }
+        return rng.uniform(0, optionCount);
+    }
+
+    std::string chooseText(int questionNumber, cv::RNG& rng) const {
+        // Hershey fonts only draw ASCII; keys with Turkish letters fall back to the word list
+        if (answerKey.hasAnswer(questionNumber)) {
+            Answer correct = answerKey.getAnswer(questionNumber);
+            if (correct.type == Answer::FILL_IN_BLANK && !correct.textAnswer.empty() &&
+                isAscii(correct.textAnswer) && rng.uniform(0.0, 1.0) < options.correctRate) {
+                return correct.textAnswer;
+            }
+        }
+        return WORDS[rng.uniform(0, WORD_COUNT)];
+    }
+
+    // Pencil marks: a disk inked to the requested coverage, slightly off center
+    void fillBubble(cv::Mat& sheet, cv::Point center, int radius, double density, cv::RNG& rng) const {
+        int r = std::max(1, radius - 2);
+        int shift = std::max(1, radius / 6);
+        center += cv::Point(rng.uniform(-shift, shift + 1), rng.uniform(-shift, shift + 1));
+
+        cv::Rect box = cv::Rect(center.x - r, center.y - r, 2 * r + 1, 2 * r + 1) & cv::Rect(cv::Point(), sheetSize);
+        if (box.empty()) {
+            return;
+        }
+
+        cv::Mat disk = cv::Mat::zeros(box.size(), CV_8U);
+        cv::circle(disk, center - box.tl(), r, cv::Scalar(255), cv::FILLED);
+
+        cv::Mat speckle(box.size(), CV_8U);
+        rng.fill(speckle, cv::RNG::UNIFORM, 0, 256);
+        cv::Mat mask = (speckle < cvRound(density * 256.0)) & disk;
+
+        int ink = rng.uniform(30, 70);
+        sheet(box).setTo(cv::Scalar(ink, ink, ink), mask);
+    }
+
+    cv::Scalar penColor(cv::RNG& rng) const {
+        // Blue or black ballpoint
+        if (rng.uniform(0, 2) == 0) {
+            return cv::Scalar(rng.uniform(100, 150), rng.uniform(30, 60), rng.uniform(20, 40));
+        }
+        int ink = rng.uniform(20, 50);
+        return cv::Scalar(ink, ink, ink);
+    }
+
+    void drawFontText(cv::Mat& sheet, const cv::Rect& region, const std::string& text, cv::RNG& rng) const {
+        const int fonts[] = {
+            cv::FONT_HERSHEY_SIMPLEX, cv::FONT_HERSHEY_DUPLEX, cv::FONT_HERSHEY_COMPLEX, cv::FONT_HERSHEY_TRIPLEX
+        };
+        int font = fonts[rng.uniform(0, 4)];
+        int thickness = rng.uniform(1, 3);
+
+        int baseline = 0;
+        cv::Size unit = cv::getTextSize(text, font, 1.0, thickness, &baseline);
+        double scale = region.height * rng.uniform(0.35, 0.55) / std::max(1, unit.height);
+        scale = std::min(scale, (region.width - 40.0) / std::max(1, unit.width));
+        cv::Size size(cvRound(unit.width * scale), cvRound(unit.height * scale));
+
+        int slack = std::max(1, region.width - 40 - size.width);
+        cv::Point origin(region.x + 20 + rng.uniform(0, std::max(1, slack / 2)),
+                         region.y + (region.height + size.height) / 2 + rng.uniform(-3, 4));
+        cv::putText(sheet, text, origin, font, scale, penColor(rng), thickness, cv::LINE_AA);
+    }
+
+    // Handwriting imitation: each letter with its own size, baseline and pen pressure, then slanted
+    void drawStrokeText(cv::Mat& sheet, const cv::Rect& region, const std::string& text, cv::RNG& rng) const {
+        cv::Mat ink = cv::Mat::zeros(region.size(), CV_8U);
+        int font = rng.uniform(0, 2) == 0 ? cv::FONT_HERSHEY_SCRIPT_SIMPLEX : cv::FONT_HERSHEY_PLAIN;
+
+        int baseline = 0;
+        cv::Size unit = cv::getTextSize(text, font, 1.0, 2, &baseline);
+        double scale = region.height * rng.uniform(0.35, 0.5) / std::max(1, unit.height);
+        scale = std::min(scale, (region.width - 60.0) / std::max(1, unit.width));
+
+        int x = 20 + rng.uniform(0, std::max(1, region.width / 4));
+        int y = region.height / 2 + cvRound(unit.height * scale / 2.0);
+        for (char c : text) {
+            std::string letter(1, c);
+            double letterScale = scale * rng.uniform(0.88, 1.12);
+            int thickness = rng.uniform(1, 4);
+            cv::putText(ink, letter, cv::Point(x, y + rng.uniform(-2, 3)), font, letterScale,
+                        cv::Scalar(255), thickness, cv::LINE_AA);
+            x += cv::getTextSize(letter, font, letterScale, thickness, &baseline).width + rng.uniform(-1, 3);
+        }
+
+        // Forward slant around the baseline
+        double slant = rng.uniform(-0.1, 0.35);
+        cv::Mat shear = (cv::Mat_<double>(2, 3) << 1.0, -slant, slant * y, 0.0, 1.0, 0.0);
+        cv::Mat slanted;
+        cv::warpAffine(ink, slanted, shear, ink.size());
+
+        sheet(region).setTo(penColor(rng), slanted > 96);
+    }
+
+    // Light falls off linearly across the sheet in a random direction
+    void applyLighting(cv::Mat& photo, cv::RNG& rng) const {
+        double loss = rng.uniform(0.0, std::max(options.lighting, 1e-6));
+        if (loss < 0.01) {
+            return;
+        }
+
+        double angle = rng.uniform(0.0, 2.0 * CV_PI);
+        double dx = std::cos(angle);
+        double dy = std::sin(angle);
+        double low = std::min(0.0, dx * (photo.cols - 1)) + std::min(0.0, dy * (photo.rows - 1));
+        double span = std::abs(dx) * (photo.cols - 1) + std::abs(dy) * (photo.rows - 1);
+
+        for (int y = 0; y < photo.rows; y++) {
+            uchar* row = photo.ptr<uchar>(y);
+            double rowOffset = dy * y - low;
+            for (int x = 0; x < photo.cols; x++) {
+                double gain = 1.0 - loss * (dx * x + rowOffset) / span;
+                for (int c = 0; c < 3; c++) {
+                    row[x * 3 + c] = cv::saturate_cast<uchar>(row[x * 3 + c] * gain);
+                }
+            }
+        }
+    }
+};
+
+bool parseArgs(int argc, char** argv, GeneratorOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--count" && i + 1 < argc) {
+            options.count = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            options.outputDir = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = std::max(0, std::stoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = std::stoull(argv[++i]);
+        } else if (arg == "--template" && i + 1 < argc) {
+            options.templatePath = argv[++i];
+        } else if (arg == "--answer-key" && i + 1 < argc) {
+            options.answerKeyPath = argv[++i];
+        } else if (arg == "--answer-rate" && i + 1 < argc) {
+            options.answerRate = std::min(1.0, std::max(0.0, std::stod(argv[++i])));
+        } else if (arg == "--correct-rate" && i + 1 < argc) {
+            options.correctRate = std::min(1.0, std::max(0.0, std::stod(argv[++i])));
+        } else if (arg == "--fill" && i + 2 < argc) {
+            options.minFill = std::min(1.0, std::max(0.0, std::stod(argv[++i])));
+            options.maxFill = std::min(1.0, std::max(options.minFill, std::stod(argv[++i])));
+        } else if (arg == "--text" && i + 1 < argc) {
+            std::string style = argv[++i];
+            if (style == "font") {
+                options.textStyle = FONT_TEXT;
+            } else if (style == "stroke") {
+                options.textStyle = STROKE_TEXT;
+            } else if (style == "mixed") {
+                options.textStyle = MIXED_TEXT;
+            } else {
+                std::cerr << "HATA: Geçersiz yazı stili: " << style << std::endl;
+                return false;
+            }
+        } else if (arg == "--perspective" && i + 1 < argc) {
+            options.perspective = std::min(0.2, std::max(0.0, std::stod(argv[++i])));
+        } else if (arg == "--blur" && i + 1 < argc) {
+            options.maxBlur = std::max(0.0, std::stod(argv[++i]));
+        } else if (arg == "--noise" && i + 1 < argc) {
+            options.noise = std::max(0.0, std::stod(argv[++i]));
+        } else if (arg == "--lighting" && i + 1 < argc) {
+            options.lighting = std::min(0.9, std::max(0.0, std::stod(argv[++i])));
+        } else if (arg == "--photo-width" && i + 1 < argc) {
+            options.photoWidth = std::max(400, std::stoi(argv[++i]));
+        } else if (arg == "--format" && i + 1 < argc) {
+            options.format = argv[++i];
+            if (options.format != "jpg" && options.format != "png") {
+                std::cerr << "HATA: Geçersiz format: " << options.format << std::endl;
+                return false;
+            }
+        } else if (arg == "--quality" && i + 1 < argc) {
+            options.jpegQuality = std::min(100, std::max(10, std::stoi(argv[++i])));
+        } else {
+            std::cerr << "Kullanım: " << argv[0]
+                      << " [--count N] [--output klasör] [--threads N] [--seed S]"
+                      << " [--template sablon.yml] [--answer-key answer_key.txt]"
+                      << " [--answer-rate 0.9] [--correct-rate 0.7] [--fill 0.7 1.0]"
+                      << " [--text font|stroke|mixed] [--perspective 0.04] [--blur 1.2]"
+                      << " [--noise 4] [--lighting 0.3] [--photo-width 1200]"
+                      << " [--format jpg|png] [--quality 90]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads ground_truth.csv back and grades the kept sheets as perfect reads; anything short of
+// 100% means the truth file or the template numbering lost answers
+bool checkGroundTruth(const std::string& truthPath, const std::vector<std::string>& names,
+                      const std::vector<std::vector<Answer>>& answers) {
+    GroundTruth truth;
+    if (!truth.loadFromFile(truthPath)) {
+        return false;
+    }
+
+    AnswerComparator comparator;
+    AccuracyStats stats;
+    size_t checked = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i].empty()) {
+            continue;   // not written
+        }
+        truth.evaluateSheet(names[i], answers[i], comparator, stats);
+        checked++;
+    }
+
+    bool perfect = stats.sheetsWithoutTruth == 0 && stats.perfectSheets == checked &&
+                   stats.bubbleCorrect == stats.bubbleQuestions && stats.textExact == stats.textQuestions;
+    std::cout << "Gerçek cevap kontrolü: " << stats.perfectSheets << "/" << checked << " kağıt tam, balon "
+              << stats.bubbleCorrect << "/" << stats.bubbleQuestions << ", yazı "
+              << stats.textExact << "/" << stats.textQuestions
+              << (perfect ? "" : "  <-- HATA: gerçek cevaplar geri okunamadı") << std::endl;
+    return perfect;
+}
+
+// A sheet answering every region from the key must score 100%: each keyed question has exactly
+// one region of the same type
+bool checkAnswerKey(const SheetTemplate& sheetTemplate, const AnswerKey& answerKey) {
+    const CompiledSheetLayout& layout = sheetTemplate.getLayout();
+    AnswerComparator comparator;
+    std::map<int, int> correct;
+
+    for (size_t i = 0; i < layout.regionCount(); i++) {
+        int questionNumber = layout.questionNumber[i];
+        if (!answerKey.hasAnswer(questionNumber)) {
+            continue;
+        }
+        // What a perfect read of this region reports
+        Answer keyAnswer = answerKey.getAnswer(questionNumber);
+        Answer answer;
+        answer.questionNumber = questionNumber;
+        answer.type = static_cast<Answer::Type>(layout.type[i]);
+        answer.selectedOption = keyAnswer.selectedOption;
+        answer.textAnswer = keyAnswer.textAnswer;
+        if (comparator.compareAnswer(answer, keyAnswer)) {
+            correct[questionNumber]++;
+        }
+    }
+
+    int matched = 0;
+    for (const auto& pair : correct) {
+        if (pair.second == 1) {
+            matched++;
+        }
+    }
+
+    int total = answerKey.getTotalQuestions();
+    bool perfect = matched == total;
+    std::cout << "Cevap anahtarı kontrolü: tam doğru kağıt " << matched << "/" << total << " soru"
+              << (perfect ? "" : "  <-- HATA: şablon soru numaraları/türleri anahtarla uyuşmuyor") << std::endl;
+    return perfect;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    GeneratorOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        return 1;
+    }
+
+    SheetTemplate sheetTemplate = SheetTemplate::createDefault();
+    if (!options.templatePath.empty() && !sheetTemplate.loadFromFile(options.templatePath)) {
+        std::cerr << "HATA: Şablon okunamadı: " << options.templatePath << std::endl;
+        return 1;
+    }
+
+    AnswerKey answerKey;
+    if (!options.answerKeyPath.empty() && !answerKey.loadFromFile(options.answerKeyPath)) {
+        return 1;
+    }
+
+    std::error_code ec;
+    fs::create_directories(options.outputDir, ec);
+    if (ec) {
+        std::cerr << "HATA: Klasör oluşturulamadı: " << options.outputDir << " (" << ec.message() << ")" << std::endl;
+        return 1;
+    }
+
+    std::string truthPath = (fs::path(options.outputDir) / "ground_truth.csv").string();
+    GroundTruthWriter truthWriter(truthPath);
+    if (!truthWriter.isOpen()) {
+        std::cerr << "HATA: Gerçek cevap dosyası oluşturulamadı: " << truthPath << std::endl;
+        return 1;
+    }
+
+    int threadCount = options.threads > 0 ? options.threads
+                                          : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threadCount = std::min(threadCount, options.count);
+
+    // Parallelism comes from the sheet workers
+    cv::setNumThreads(1);
+
+    std::vector<int> encodeParams;
+    if (options.format == "jpg") {
+        encodeParams = {cv::IMWRITE_JPEG_QUALITY, options.jpegQuality};
+    } else {
+        encodeParams = {cv::IMWRITE_PNG_COMPRESSION, 1};
+    }
+    int digits = std::max(6, static_cast<int>(std::to_string(options.count).size()));
+
+    SheetGenerator generator(options, sheetTemplate, answerKey);
+
+    size_t keptSheets = std::min(ROUND_TRIP_SHEETS, static_cast<size_t>(options.count));
+    std::vector<std::string> keptNames(keptSheets);
+    std::vector<std::vector<Answer>> keptAnswers(keptSheets);
+
+    std::cout << "Sentetik kağıt üretimi: " << options.count << " kağıt, " << threadCount << " thread, seed "
+              << options.seed << " -> " << options.outputDir << std::endl;
+
+    std::atomic<size_t> nextSheet(0);
+    std::atomic<size_t> written(0);
+    std::atomic<size_t> failed(0);
+    std::vector<WorkerTiming> timings(threadCount);
+    std::vector<std::thread> workers;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            WorkerTiming& timing = timings[t];
+            std::vector<Answer> answers;
+            char name[64];
+
+            size_t index;
+            while ((index = nextSheet.fetch_add(1)) < static_cast<size_t>(options.count)) {
+                // Every sheet has its own seed, so the output does not depend on the thread count
+                cv::RNG rng(options.seed * 0x9E3779B97F4A7C15ULL + index + 1);
+
+                auto stepStart = std::chrono::steady_clock::now();
+                cv::Mat sheet = generator.renderSheet(answers, rng);
+                timing.renderMs += elapsedMs(stepStart);
+
+                stepStart = std::chrono::steady_clock::now();
+                cv::Mat photo = generator.photograph(sheet, rng);
+                timing.distortMs += elapsedMs(stepStart);
+
+                std::snprintf(name, sizeof(name), "sheet_%0*zu.%s", digits, index + 1, options.format.c_str());
+                stepStart = std::chrono::steady_clock::now();
+                bool ok = cv::imwrite((fs::path(options.outputDir) / name).string(), photo, encodeParams);
+                timing.writeMs += elapsedMs(stepStart);
+
+                std::ostringstream rows;
+                if (ok) {
+                    GroundTruth::writeSheet(rows, name, answers);
+                    if (index < keptSheets) {
+                        keptNames[index] = name;
+                        keptAnswers[index] = answers;
+                    }
+                    written++;
+                } else {
+                    std::cerr << "Uyarı: Yazılamadı: " << name << std::endl;
+                    failed++;
+                }
+                truthWriter.add(index, rows.str());
+            }
+        });
+    }
+
+    // Progress roughly once a second
+    auto lastReport = startTime;
+    while (written + failed < static_cast<size_t>(options.count)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (elapsedMs(lastReport) >= 1000.0) {
+            lastReport = std::chrono::steady_clock::now();
+            size_t done = written + failed;
+            std::cout << "  " << done << "/" << options.count << " ("
+                      << std::fixed << std::setprecision(1) << (done * 1000.0 / elapsedMs(startTime))
+                      << " kağıt/s)" << std::endl;
+        }
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double totalMs = elapsedMs(startTime);
+    truthWriter.close();
+
+    WorkerTiming total;
+    for (const auto& timing : timings) {
+        total.renderMs += timing.renderMs;
+        total.distortMs += timing.distortMs;
+        total.writeMs += timing.writeMs;
+    }
+    double sheets = static_cast<double>(options.count);
+
+    std::cout << "\n" << std::string(50, '=') << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Üretilen kağıt:  " << written << " (başarısız " << failed << ")" << std::endl;
+    std::cout << "Toplam süre:     " << (totalMs / 1000.0) << " s" << std::endl;
+    std::cout << "Hız:             " << (sheets * 1000.0 / totalMs) << " kağıt/s" << std::endl;
+    std::cout << "Kağıt başına:    çizim " << (total.renderMs / sheets) << " ms, bozulma "
+              << (total.distortMs / sheets) << " ms, yazma " << (total.writeMs / sheets) << " ms" << std::endl;
+    std::cout << "Gerçek cevaplar: " << truthPath << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+
+    bool consistent = checkGroundTruth(truthPath, keptNames, keptAnswers);
+    if (!options.answerKeyPath.empty()) {
+        consistent = checkAnswerKey(sheetTemplate, answerKey) && consistent;
+    }
+
+    std::cout << "Değerlendirme:   ./OMR_System --batch " << options.outputDir
+              << " --ground-truth " << truthPath << std::endl;
+
+    return (failed == 0 && consistent) ? 0 : 1;
+}
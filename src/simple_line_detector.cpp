@@ -2,6 +2,7 @@
  * El Yazısı Satır Bulucu - MSER Tabanlı
  */
 
+#include "OCREnginePool.h"
 #include <opencv2/opencv.hpp>
 #include <opencv2/features2d.hpp>
 #include <iostream>
@@ -70,6 +71,18 @@ int main(int argc, char* argv[]) {
     
     std::cout << "Bulunan satır sayısı: " << textLines.size() << "\n" << std::endl;
     
+    // OCR motoru bir kez yüklenir; satırlar bellekten okunur (tesseract CLI yok)
+    OCREngineConfig ocrConfig;
+    ocrConfig.pageSegMode = tesseract::PSM_AUTO;
+    ocrConfig.charWhitelist.clear();
+    
+    OCREnginePool ocrPool(1, ocrConfig);
+    OCREnginePool::Lease ocr = ocrPool.checkout();
+    
+    if (!ocr) {
+        std::cerr << "OCR başlatılamadı, satırlar okunmayacak" << std::endl;
+    }
+    
     // Görselleştir
     cv::Mat visualized = image.clone();
     
@@ -103,29 +116,14 @@ int main(int argc, char* argv[]) {
         std::cout << "  Kaydedildi: " << filename << std::endl;
         
         // OCR uygula
-        std::string tempFile = "temp_ocr_" + std::to_string(i) + ".jpg";
-        cv::imwrite(tempFile, lineROI);
-        
-        std::string cmd = "tesseract " + tempFile + " stdout -l tur --psm 3 2>/dev/null";
-        FILE* pipe = popen(cmd.c_str(), "r");
-        if (pipe) {
-            char buffer[256];
-            std::string result = "";
-            while (fgets(buffer, sizeof(buffer), pipe) != NULL) {
-                result += buffer;
-            }
-            pclose(pipe);
-            
-            // Trim
-            result.erase(0, result.find_first_not_of(" \n\r\t"));
-            result.erase(result.find_last_not_of(" \n\r\t") + 1);
+        if (ocr) {
+            std::string result = ocr->recognizeText(lineROI);
             
             if (!result.empty()) {
                 std::cout << "  OCR: \"" << result << "\"" << std::endl;
             }
         }
         
-        std::remove(tempFile.c_str());
         std::cout << std::endl;
     }
     